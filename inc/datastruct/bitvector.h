@@ -0,0 +1,106 @@
+/*
+Date: 17 Oct 2026 16:48:05.277390128
+File: bitvector.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BITVECTOR_H_6A1F3C08E7D249B5C0A83E6F71D42B95__
+Purpose: Implements a packed bit vector. Bits are stored 64 to a word in a
+         vector of words, so it grows like a vector does. Popcount and bulk
+         operations work a word (or a SIMD register) at a time, picking AVX2,
+         POPCNT or plain code at runtime.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __BITVECTOR_H_6A1F3C08E7D249B5C0A83E6F71D42B95__
+#define __BITVECTOR_H_6A1F3C08E7D249B5C0A83E6F71D42B95__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "bitvector.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Index returned by searches when no bit is found.
+#define BV_NPOS                              ((uint64_t)-1)
+
+//
+// TYPES
+//
+
+// Bit vector types
+typedef void* bitvector;                           // bit vector
+typedef const void* cbitvector;                    // const bit vector
+
+//
+// BIT VECTOR API
+//
+
+// Creation/destruction.
+bitvector bvcreate();                              // construct empty vector
+void bvdestroy(bitvector* pbv);                    // destroy existing vector
+
+// Size management. New bits are clear.
+uint64_t bvGetCount(cbitvector cbv);               // return bit count
+retcode bvSetGrowthPolicy(bitvector bv, cvgrowth policy, uint32_t param);
+retcode bvReserve(bitvector bv, uint64_t bitCount); // total bitCount bits
+retcode bvResize(bitvector bv, uint64_t bitCount); // grow or truncate
+retcode bvPushBack(bitvector bv, bool value);      // add a bit to the end
+void bvShrink(bitvector bv);                       // free unused memory
+
+// Single bits. Out of range indexes are ignored (bvTest gives false).
+void bvSet(bitvector bv, uint64_t index);
+void bvClear(bitvector bv, uint64_t index);
+void bvAssign(bitvector bv, uint64_t index, bool value);
+bool bvTest(cbitvector cbv, uint64_t index);
+void bvFill(bitvector bv, bool value);             // set or clear all bits
+
+// Bulk operations: dst = dst op src over the bits of dst. Bits of dst past
+// the end of src are treated as if src had them clear.
+retcode bvAnd(bitvector dst, cbitvector src);
+retcode bvOr(bitvector dst, cbitvector src);
+retcode bvXor(bitvector dst, cbitvector src);
+retcode bvAndNot(bitvector dst, cbitvector src);   // dst & ~src
+
+// Counting and searching.
+// bvRank gives the set bits before index; bvSelect gives the index of set bit
+// number k (from 0) or BV_NPOS. Both use a block count index built on first
+// use after a change.
+uint64_t bvPopCount(cbitvector cbv);               // number of set bits
+uint64_t bvRank(bitvector bv, uint64_t index);
+uint64_t bvSelect(bitvector bv, uint64_t k);
+uint64_t bvFindFirst(cbitvector cbv);              // first set bit or BV_NPOS
+uint64_t bvFindNext(cbitvector cbv, uint64_t from); // first set bit >= from
+
+// Word access - bit i is bit (i % 64) of word i / 64. Bits past the count in
+// the last word are always clear. Writes through the pointer must keep them
+// so and must be followed by bvTouch() if rank/select are used.
+uint64_t* bvWords(bitvector bv, uint64_t* pWordCount);
+void bvTouch(bitvector bv);
+
+#endif   // __BITVECTOR_H_6A1F3C08E7D249B5C0A83E6F71D42B95__
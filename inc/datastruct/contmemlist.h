@@ -30,6 +30,11 @@ Purpose: There are times where multiple items of data of varying size need to be
 
 Version control
 27 Nov 2023 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           Item index (O(1) cmlGet), cmlcreatex
+17 Oct 2026 Duncan Camilleri           Cursors and cmlForEach
+17 Oct 2026 Duncan Camilleri           Geometric growth, cmlReserve
+17 Oct 2026 Duncan Camilleri           Gathered and batched adds (cmlAddv/Batch)
+17 Oct 2026 Duncan Camilleri           Aligned payloads (cmlfalign8/16/64)
 */
 
 
@@ -47,12 +52,42 @@ typedef struct _CMLBuffer {
    void* mpData;                                   // note persistence
 } CMLBuffer;
 
+// Fragments given to cmlAddv (see <sys/uio.h>).
+struct iovec;
+
 // List types.
 typedef void* memlist;                             // contiguous memory list
 typedef void* memlistitem;                         // a single item in the list
 
+// Called by cmlForEach for each item; return false to stop.
+typedef bool (*cmlvisitor)(void* pData, uint32_t size, void* pCtx);
+
+// List creation flags (see cmlcreatex).
+// cmlGet finds items through an index of item offsets. By default it is
+// built as far as needed by cmlGet itself; cmlfeagerindex has cmlAdd keep it
+// up instead. cmlfsparseindex keeps one entry per 16 items (half a byte per
+// item rather than eight) and walks the few items in between.
+// By default the list grows by whole blocks, so a large list reallocates
+// (and maybe moves) often. cmlfgeometric doubles its size instead (growing by
+// at most 64MB at once) and cmlfpagegrowth does the same in whole pages.
+// Items are packed back to back so their data may have any alignment. One of
+// cmlfalign8/16/64 pads in front of each item so that its data is aligned
+// (cmlGetPadding tells the bytes this costs).
+typedef enum {
+   cmlfnone = 0x00,                                // index built by cmlGet
+   cmlfeagerindex = 0x01,                          // index kept by cmlAdd
+   cmlfsparseindex = 0x02,                         // an entry every 16 items
+   cmlfgeometric = 0x04,                           // grow by doubling
+   cmlfpagegrowth = 0x08,                          // geometric, page rounded
+   cmlfalign8 = 0x10,                              // data 8 byte aligned
+   cmlfalign16 = 0x20,                             // data 16 byte aligned
+   cmlfalign64 = 0x40                              // data 64 byte aligned
+} cmlflags;
+
 // Creation - (that which is created, needs to be destroyed).
 memlist cmlcreate(void* pData, uint32_t size, uint32_t blocksize);
+memlist cmlcreatex(void* pData, uint32_t size, uint32_t blocksize,
+   uint32_t flags);
 void cmldestroy(memlist* pp);
 
 // Memory management.
@@ -60,7 +95,30 @@ void cmldestroy(memlist* pp);
 // Note: Upon calling add, any non persistent CMLBuffers may become invalid.
 // Note also that persistent CMLBuffers use up more memory. 
 memlistitem cmlAdd(memlist* ppList, void* pData, uint32_t size);
+// cmlAddv gathers count fragments into one item (no staging buffer).
+// cmlAddBatch adds count items stored back to back in pData, item n being
+// pSizes[n] bytes long, growing the list at most once (all or nothing).
+memlistitem cmlAddv(memlist* ppList, const struct iovec* pIov, uint32_t count);
+retcode cmlAddBatch(memlist* ppList, const void* pData,
+   const uint32_t* pSizes, uint64_t count);
 memlistitem cmlGet(memlist pList, uint32_t index);
+uint64_t cmlGetCount(memlist pList);
+uint32_t cmlGetAllocCount(memlist pList);          // buffer (re)allocations
+uint64_t cmlGetPadding(memlist pList);             // bytes spent aligning
+// Room for count more items of bytes between them (no reallocs adding them).
+retcode cmlReserve(memlist* ppList, uint64_t bytes, uint64_t count);
+
+// Cursors.
+// Walk the items in order, prefetching the memory a few items ahead:
+// for (memlistitem i = cmlFirst(l); i; i = cmlNext(l, i)) ...
+// Items stay valid until the next cmlAdd. cmlForEach calls visit with the
+// data of every item (until visit returns false) and returns the number of
+// items visited.
+memlistitem cmlFirst(memlist pList);
+memlistitem cmlNext(memlist pList, memlistitem item);
+void* cmlItemData(memlistitem item);
+uint32_t cmlItemSize(memlistitem item);
+uint64_t cmlForEach(memlist pList, cmlvisitor visit, void* pCtx);
 
 // CML Buffers
 // CML Buffers fetch the actual data from an memlistitem. They can either be
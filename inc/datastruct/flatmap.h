@@ -0,0 +1,105 @@
+/*
+Date: 17 Oct 2026 18:44:27.390516824
+File: flatmap.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __FLATMAP_H_5C0E7A3F9B2D41864E1A7C0B3F9D5E26__
+Purpose: Implements a sorted flat map: keys and values are kept in two
+         vectors in key order and found by binary (or Eytzinger layout)
+         search. New keys are buffered in a small unsorted tail which is
+         merged in once it passes a threshold.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __FLATMAP_H_5C0E7A3F9B2D41864E1A7C0B3F9D5E26__
+#define __FLATMAP_H_5C0E7A3F9B2D41864E1A7C0B3F9D5E26__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "flatmap.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Index given when a key has no position.
+#define FM_NPOS                              ((uint64_t)-1)
+
+//
+// TYPES
+//
+
+// Flat map types
+typedef void* flatmap;                             // flat map
+typedef const void* cflatmap;                      // const flat map
+
+// Flat map creation flags (see fmcreatex).
+typedef enum {
+   fmfnone = 0x00,                                 // binary search
+   fmfeytzinger = 0x01                             // Eytzinger layout search
+} fmflags;
+
+//
+// FLAT MAP API
+//
+
+// Creation/destruction.
+// cmp orders keys. With fmfeytzinger the keys are also kept in breadth
+// first (Eytzinger) order, where the next few probes of a search share cache
+// lines and can be prefetched; it costs a copy of the keys. tailMax is the
+// number of keys buffered before a merge (0 for the default).
+flatmap fmcreate(uint32_t keySize, uint32_t valueSize, comparator cmp);
+flatmap fmcreatex(uint32_t keySize, uint32_t valueSize, comparator cmp,
+   uint32_t flags, uint32_t tailMax);
+void fmdestroy(flatmap* pfm);                      // destroy existing map
+
+// Size management.
+uint64_t fmGetCount(cflatmap cfm);                 // return item count
+retcode fmReserve(flatmap fm, uint64_t itemCount); // total itemCount items
+void fmClear(flatmap fm);                          // empty the map
+void fmShrink(flatmap fm);                         // free unused memory
+
+// Items. Value pointers stay valid until the next call that adds or erases.
+// fmPut adds or overwrites; fmPutN adds count keys and values (stored
+// contiguously) with a single sort and merge - where keys repeat, the last
+// one wins. A failed fmPutN changes nothing.
+void* fmPut(flatmap fm, const void* pKey, const void* pValue);
+retcode fmPutN(flatmap fm, const void* pKeys, const void* pValues,
+   uint64_t count);
+void* fmGet(flatmap fm, const void* pKey);         // value or null
+bool fmContains(flatmap fm, const void* pKey);
+retcode fmErase(flatmap fm, const void* pKey);     // fail if not there
+
+// Ordered access. These merge the tail first. Keys and values are spans over
+// the items in key order; fmLowerBound gives the index of the first key not
+// less than pKey (fmGetCount() if none).
+void fmFlush(flatmap fm);                          // merge the tail now
+uint64_t fmLowerBound(flatmap fm, const void* pKey);
+cvspan fmKeys(flatmap fm);
+cvspan fmValues(flatmap fm);
+
+#endif   // __FLATMAP_H_5C0E7A3F9B2D41864E1A7C0B3F9D5E26__
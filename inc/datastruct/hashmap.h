@@ -0,0 +1,103 @@
+/*
+Date: 17 Oct 2026 17:58:12.640237915
+File: hashmap.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __HASHMAP_H_8E3B1D6F0A2C47952B7E0D4A9C1F5E38__
+Purpose: Implements an open addressing hash map with fixed size keys and
+         values. Slots are probed a group of 16 at a time: a control byte per
+         slot holds 7 bits of the hash, and SSE2 compares a whole group of
+         control bytes in one go (SwissTable style).
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __HASHMAP_H_8E3B1D6F0A2C47952B7E0D4A9C1F5E38__
+#define __HASHMAP_H_8E3B1D6F0A2C47952B7E0D4A9C1F5E38__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __COMMONS_H_2224725FD5DAE2AC90D80099D5A003C5__
+#error "hashmap.h: missing include - commons.h"
+#endif
+
+//
+// MACROS
+//
+
+// Position returned by iteration when there are no more items.
+#define HM_END                               ((uint64_t)-1)
+
+//
+// TYPES
+//
+
+// Hash map types
+typedef void* hashmap;                             // hash map
+typedef const void* chashmap;                      // const hash map
+
+//
+// HASH MAP API
+//
+
+// Creation/destruction.
+// Keys and values are copied in (valueSize may be 0 for a set). hash and cmp
+// default (null) to hmHashBytes() and comparing key bytes.
+hashmap hmcreate(uint32_t keySize, uint32_t valueSize);
+hashmap hmcreatex(uint32_t keySize, uint32_t valueSize, hasher hash,
+   comparator cmp);
+void hmdestroy(hashmap* phm);                      // destroy existing map
+
+// Size management.
+// The map grows once it is filled to its maximum load factor (0.875 unless
+// set, 0.25 to 0.95). Reserve makes room for itemCount items without growing.
+uint64_t hmGetCount(chashmap chm);                 // return item count
+uint64_t hmGetCapacity(chashmap chm);              // return slot count
+retcode hmSetMaxLoad(hashmap hm, double maxLoad);
+retcode hmReserve(hashmap hm, uint64_t itemCount);
+void hmClear(hashmap hm);                          // empty the map
+void hmShrink(hashmap hm);                         // free unused memory
+
+// Items. Value pointers stay valid until the map grows, shrinks or is
+// rehashed (any insert may do so).
+// hmPut adds or overwrites; hmEmplace adds a blank value if the key is not
+// there (pInserted tells which) and returns the value either way.
+void* hmPut(hashmap hm, const void* pKey, const void* pValue);
+void* hmEmplace(hashmap hm, const void* pKey, bool* pInserted);
+void* hmGet(hashmap hm, const void* pKey);         // value or null
+bool hmContains(chashmap chm, const void* pKey);
+retcode hmErase(hashmap hm, const void* pKey);     // fail if not there
+
+// Iteration in slot order (unordered). Erasing during iteration is allowed;
+// inserting is not.
+// for (uint64_t pos = hmFirst(hm); pos != HM_END; pos = hmNext(hm, pos))
+uint64_t hmFirst(chashmap chm);
+uint64_t hmNext(chashmap chm, uint64_t pos);
+void* hmKeyAt(hashmap hm, uint64_t pos);
+void* hmValueAt(hashmap hm, uint64_t pos);
+
+// Default hash function.
+uint64_t hmHashBytes(const void* a, uint32_t size);
+
+#endif   // __HASHMAP_H_8E3B1D6F0A2C47952B7E0D4A9C1F5E38__
@@ -0,0 +1,104 @@
+/*
+Date: 17 Oct 2026 17:21:40.118306725
+File: heap.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __HEAP_H_C3E81F5A0B7D4926E5A1C08F3B6D2E74__
+Purpose: Implements a binary (or 4-ary) heap priority queue stored in a
+         vector. The smallest item according to the comparator given is
+         always at the top. Items can optionally be tracked by handles so
+         they can be updated or removed while in the heap.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __HEAP_H_C3E81F5A0B7D4926E5A1C08F3B6D2E74__
+#define __HEAP_H_C3E81F5A0B7D4926E5A1C08F3B6D2E74__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "heap.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Handle given when handles are not tracked (or are not valid).
+#define HP_NOHANDLE                          ((uint64_t)-1)
+
+//
+// TYPES
+//
+
+// Heap types
+typedef void* heap;                                // priority queue
+typedef const void* cheap;                         // const priority queue
+typedef uint64_t hphandle;                         // item handle
+
+// Heap creation flags (see hpcreatex).
+typedef enum {
+   hpfnone = 0x00,                                 // binary heap, no handles
+   hpfquaternary = 0x01,                           // 4 children per node
+   hpfhandles = 0x02                               // track items by handle
+} hpflags;
+
+//
+// HEAP API
+//
+
+// Creation/destruction.
+// cmp orders items; the smallest is at the top (reverse it for a max heap).
+// A 4-ary heap is shallower and keeps the children of a node together, which
+// costs fewer cache misses on large heaps.
+heap hpcreate(uint32_t itemSize, comparator cmp);  // binary heap
+heap hpcreatex(uint32_t itemSize, comparator cmp, uint32_t flags);
+void hpdestroy(heap* php);                         // destroy existing heap
+
+// Item management.
+// Items are copied in. pHandle/pHandles (optional) receive the handles of
+// the items pushed (HP_NOHANDLE without hpfhandles). hpPushN on an empty (or
+// smaller) heap rebuilds it bottom up in O(n). hpPop copies the top item to
+// pItem if given.
+uint64_t hpGetCount(cheap ch);                     // return item count
+retcode hpSetGrowthPolicy(heap h, cvgrowth policy, uint32_t param);
+retcode hpReserve(heap h, uint64_t itemCount);     // total itemCount items
+retcode hpPush(heap h, ccvitem item, hphandle* pHandle);
+retcode hpPushN(heap h, ccvitem items, uint64_t count, hphandle* pHandles);
+void* hpPeek(cheap ch);                            // top item or null
+retcode hpPop(heap h, cvitem pItem);               // remove top item
+void hpClear(heap h);                              // empty the heap
+void hpShrink(heap h);                             // free unused memory
+
+// Handles (hpfhandles only). A handle stays valid until its item leaves the
+// heap; handles are then reused. hpGetItem returns the item (read only - use
+// hpUpdate to change it). hpDecreaseKey fails if item is larger than the
+// item it replaces; hpUpdate moves the item either way.
+void* hpGetItem(heap h, hphandle handle);
+retcode hpDecreaseKey(heap h, hphandle handle, ccvitem item);
+retcode hpUpdate(heap h, hphandle handle, ccvitem item);
+retcode hpRemove(heap h, hphandle handle, cvitem pItem);
+
+#endif   // __HEAP_H_C3E81F5A0B7D4926E5A1C08F3B6D2E74__
@@ -0,0 +1,99 @@
+/*
+Date: 17 Oct 2026 19:21:06.482915377
+File: ringbuf.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __RINGBUF_H_2F7D0B9E4A1C46385D9E2B7F0A4C1E83__
+Purpose: Implements a ring buffer (bounded FIFO queue) over vector storage.
+         The capacity is a power of two so positions wrap with a mask, and
+         batches are read or written in place through at most two spans.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __RINGBUF_H_2F7D0B9E4A1C46385D9E2B7F0A4C1E83__
+#define __RINGBUF_H_2F7D0B9E4A1C46385D9E2B7F0A4C1E83__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "ringbuf.h: missing include - vector.h"
+#endif
+
+//
+// TYPES
+//
+
+// Ring buffer types
+typedef void* ringbuf;                             // ring buffer
+typedef const void* cringbuf;                      // const ring buffer
+
+// Ring buffer creation flags (see rbcreatex).
+typedef enum {
+   rbfnone = 0x00,                                 // bounded, full fails
+   rbfgrowable = 0x01                              // double when full
+} rbflags;
+
+//
+// RING BUFFER API
+//
+
+// Creation/destruction.
+// capacity is rounded up to a power of two (0 for the default). A bounded
+// buffer refuses items once full; with rbfgrowable it doubles its capacity
+// instead, growing the underlying vector (see rbSetGrowthPolicy).
+ringbuf rbcreate(uint32_t itemSize, uint64_t capacity); // bounded buffer
+ringbuf rbcreatex(uint32_t itemSize, uint64_t capacity, uint32_t flags);
+void rbdestroy(ringbuf* prb);                      // destroy existing buffer
+
+// Size management.
+uint64_t rbGetCount(cringbuf crb);                 // return item count
+uint64_t rbGetCapacity(cringbuf crb);              // return item capacity
+retcode rbSetGrowthPolicy(ringbuf rb, cvgrowth policy, uint32_t param);
+retcode rbReserve(ringbuf rb, uint64_t itemCount); // any flags
+void rbClear(ringbuf rb);                          // empty the buffer
+
+// Items (copied in and out, oldest first). rbPushN and rbPopN move as many
+// items as they can and return how many. rbPeek and rbGetAt (0 is the oldest)
+// return null when there is no such item.
+retcode rbPush(ringbuf rb, ccvitem item);          // add to the back
+uint64_t rbPushN(ringbuf rb, ccvitem items, uint64_t count);
+retcode rbPop(ringbuf rb, cvitem pItem);           // remove from the front
+uint64_t rbPopN(ringbuf rb, cvitem pItems, uint64_t count);
+void* rbPeek(ringbuf rb);                          // oldest item
+void* rbGetAt(ringbuf rb, uint64_t index);
+
+// Zero copy batches. rbReadSpans sets up to two spans over the oldest (at
+// most count) items and returns how many they hold; rbConsume then drops
+// them. rbWriteSpans sets spans over free room for at most count items
+// (growing first if allowed) and rbCommit adds the items written there.
+// Spans are valid until the next call that adds items.
+uint64_t rbReadSpans(ringbuf rb, uint64_t count, cvspan* pFirst,
+   cvspan* pSecond);
+retcode rbConsume(ringbuf rb, uint64_t count);
+uint64_t rbWriteSpans(ringbuf rb, uint64_t count, cvspan* pFirst,
+   cvspan* pSecond);
+retcode rbCommit(ringbuf rb, uint64_t count);
+
+#endif   // __RINGBUF_H_2F7D0B9E4A1C46385D9E2B7F0A4C1E83__
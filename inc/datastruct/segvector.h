@@ -0,0 +1,107 @@
+/*
+Date: 17 Oct 2026 12:40:11.902716345
+File: segvector.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SEGVECTOR_H_A43F0C7E1B9D26E85C7024F1B3E9D5A8__
+Purpose: Implements a segmented vector api. Items are stored in fixed size
+         chunks listed in a small directory. Appending never moves existing
+         items, so item pointers stay valid until the item is removed, and
+         growth costs one chunk allocation rather than a copy of all items.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           Concurrent append mode (svfconcurrent)
+17 Oct 2026 Duncan Camilleri           svAppendCommit() reports lost items
+*/
+
+#ifndef __SEGVECTOR_H_A43F0C7E1B9D26E85C7024F1B3E9D5A8__
+#define __SEGVECTOR_H_A43F0C7E1B9D26E85C7024F1B3E9D5A8__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __COMMONS_H_2224725FD5DAE2AC90D80099D5A003C5__
+#error "segvector.h: missing include - commons.h"
+#endif
+
+//
+// TYPES
+//
+
+// Segmented vector types
+typedef void* segvector;                           // segmented vector
+typedef const void* csegvector;                    // const segmented vector
+
+// Segmented vector creation flags (see svcreatex).
+typedef enum {
+   svfnone = 0x00,                                 // default behaviour
+   svfconcurrent = 0x01                            // multi-producer append
+} svflags;
+
+//
+// SEGMENTED VECTOR API
+//
+
+// Creation/destruction.
+// chunkItems is rounded up to a power of two (0 selects the default).
+segvector svcreate(uint32_t itemSize, uint32_t chunkItems);
+void svdestroy(segvector* psv);                    // destroy existing vector
+
+// svfconcurrent vectors hold at most maxItems items. Their chunk directory is
+// allocated up front so it never moves; chunks are added as items arrive.
+segvector svcreatex(uint32_t itemSize, uint32_t chunkItems, uint32_t flags,
+   uint64_t maxItems);
+
+// Item management.
+uint64_t svGetCount(csegvector csv);               // return item count
+uint64_t svGetSize(csegvector csv);                // return total items
+uint32_t svGetChunkItems(csegvector csv);          // items per chunk
+retcode svReserve(segvector sv, uint64_t itemCount); // total itemCount items
+void* svEmplaceBack(segvector sv);                 // creates item at end
+void* svPushBack(segvector sv, const void* item);  // add to the end
+void svPopBack(segvector sv);                      // remove last item
+void svClear(segvector sv);                        // empty the vector
+void svShrink(segvector sv);                       // free unused chunks
+void* svGetAt(segvector sv, uint64_t index);       // get/set item at index
+void* svSetAt(segvector sv, uint64_t index, const void* item);
+
+// Chunk access - items in a chunk are contiguous. Returns the chunk holding
+// items [chunk * chunkItems, ...) and sets pCount to the valid items in it.
+void* svGetChunk(segvector sv, uint64_t chunk, uint32_t* pCount);
+
+// Concurrent append (svfconcurrent vectors). Any number of threads may append
+// while others read. svAppendReserve() claims the next index with an atomic
+// add and returns the item to write; svAppendCommit() marks it written
+// without waiting. Items are published in index order as soon as all items
+// before them are written, so svGetCount() and svGetAt() only ever show fully
+// written items. svAppend() does both. Reserve returns null when the vector
+// is full. A chunk that fails to allocate loses its item and every item after
+// it: reserves past it return null and commits past it return fail, though an
+// item committed before the failure is lost all the same. svPushBack() appends
+// and svEmplaceBack() publishes a blank item; svPopBack(), svClear() and
+// svShrink() must not run alongside producers.
+void* svAppendReserve(segvector sv, uint64_t* pIndex);
+retcode svAppendCommit(segvector sv, uint64_t index);
+void* svAppend(segvector sv, const void* item);
+
+#endif   // __SEGVECTOR_H_A43F0C7E1B9D26E85C7024F1B3E9D5A8__
@@ -0,0 +1,89 @@
+/*
+Date: 17 Oct 2026 19:52:33.104728615
+File: slotmap.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SLOTMAP_H_6D1A9F4C2E8B47305B6C0E9A1D4F7B28__
+Purpose: Implements a slot map: items are kept densely in a vector and are
+         reached through stable 64 bit handles (a slot and a generation).
+         Erasing fills the gap with the last item, and handles to erased
+         items are detected as stale.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __SLOTMAP_H_6D1A9F4C2E8B47305B6C0E9A1D4F7B28__
+#define __SLOTMAP_H_6D1A9F4C2E8B47305B6C0E9A1D4F7B28__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "slotmap.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Handle that never refers to an item.
+#define SM_NOHANDLE                          ((uint64_t)-1)
+
+//
+// TYPES
+//
+
+// Slot map types
+typedef void* slotmap;                             // slot map
+typedef const void* cslotmap;                      // const slot map
+typedef uint64_t smhandle;                         // generation << 32 | slot
+
+//
+// SLOT MAP API
+//
+
+// Creation/destruction.
+slotmap smcreate(uint32_t itemSize);               // construct empty map
+void smdestroy(slotmap* psm);                      // destroy existing map
+
+// Size management.
+// smClear makes every handle given so far stale; slots are then reused.
+uint64_t smGetCount(cslotmap csm);                 // return item count
+retcode smReserve(slotmap sm, uint64_t itemCount); // total itemCount items
+void smClear(slotmap sm);                          // empty the map
+void smShrink(slotmap sm);                         // free unused memory
+
+// Items. Items are copied in (null adds a blank item). Item pointers stay
+// valid until the next insert or erase; handles stay valid until their item
+// is erased. Stale or invalid handles give null or fail.
+smhandle smInsert(slotmap sm, ccvitem item);       // SM_NOHANDLE on failure
+void* smGet(slotmap sm, smhandle handle);
+bool smContains(cslotmap csm, smhandle handle);
+retcode smErase(slotmap sm, smhandle handle, cvitem pItem);
+
+// Dense access. The items are a span in no particular order (erasing moves
+// the last item into the gap); smHandleAt gives the handle of item index.
+cvspan smItems(slotmap sm);
+smhandle smHandleAt(cslotmap csm, uint64_t index);
+
+#endif   // __SLOTMAP_H_6D1A9F4C2E8B47305B6C0E9A1D4F7B28__
@@ -0,0 +1,100 @@
+/*
+Date: 17 Oct 2026 16:02:18.530917442
+File: soavector.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SOAVECTOR_H_0D7A2E94B61C3F58A9E4017C2B5D8F36__
+Purpose: Implements a struct of arrays (columnar) vector. Rows are described
+         by a schema of fields given at creation and each field is stored in
+         a column of its own (a vector), so scans over one field only touch
+         that field's memory.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __SOAVECTOR_H_0D7A2E94B61C3F58A9E4017C2B5D8F36__
+#define __SOAVECTOR_H_0D7A2E94B61C3F58A9E4017C2B5D8F36__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "soavector.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Describes member of struct T as a field, so rows can be pushed and read
+// back as T. Requires stddef.h.
+#define soafieldof(T, member)                                                  \
+   { sizeof(((T*)0)->member), offsetof(T, member) }
+
+//
+// TYPES
+//
+
+// Struct of arrays vector types
+typedef void* soavector;                           // struct of arrays vector
+typedef const void* csoavector;                    // const soa vector
+
+// A field in the schema: its size and its offset within a row.
+typedef struct _soafield {
+   uint32_t mSize;
+   uint32_t mOffset;
+} soafield;
+
+//
+// SOA VECTOR API
+//
+
+// Creation/destruction.
+// rowSize is the size of a row as pushed and read (the struct holding all
+// fields at their offsets). Fields are copied.
+soavector soacreate(const soafield* pFields, uint32_t fieldCount,
+   uint32_t rowSize);
+void soadestroy(soavector* psv);                   // destroy existing vector
+
+// Item management.
+uint64_t soaGetCount(csoavector csv);              // return row count
+uint32_t soaGetFieldCount(csoavector csv);         // fields in the schema
+uint32_t soaGetRowSize(csoavector csv);            // row size as given
+retcode soaSetGrowthPolicy(soavector sv, cvgrowth policy, uint32_t param);
+retcode soaReserve(soavector sv, uint64_t rowCount); // total rowCount rows
+retcode soaPushRow(soavector sv, const void* pRow); // add a row to the end
+retcode soaPushRows(soavector sv, const void* pRows, uint64_t count);
+retcode soaGetRow(csoavector csv, uint64_t index, void* pRow); // read a row
+retcode soaSetRow(soavector sv, uint64_t index, const void* pRow);
+void soaPopBack(soavector sv);                     // remove last row
+void soaClear(soavector sv);                       // empty the vector
+void soaShrink(soavector sv);                      // free unused memory
+
+// Field access. soaGetField returns field of row index (null if out of
+// range). soaColumn returns a span over all the values of field, contiguous
+// with a stride of the field size; it is empty for bad fields and is
+// invalidated by any call that adds rows.
+void* soaGetField(soavector sv, uint64_t index, uint32_t field);
+cvspan soaColumn(csoavector csv, uint32_t field);
+
+#endif   // __SOAVECTOR_H_0D7A2E94B61C3F58A9E4017C2B5D8F36__
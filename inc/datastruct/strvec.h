@@ -0,0 +1,101 @@
+/*
+Date: 17 Oct 2026 20:24:18.736015492
+File: strvec.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __STRVEC_H_0E9C4A7B3D1F42685F2A8E0C6B4D9A13__
+Purpose: Implements a vector of variable length strings stored back to back
+         in one byte blob with a vector of offsets into it (the Arrow large
+         string layout). Strings are read in place as views; duplicates can
+         optionally be stored once in a dictionary.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __STRVEC_H_0E9C4A7B3D1F42685F2A8E0C6B4D9A13__
+#define __STRVEC_H_0E9C4A7B3D1F42685F2A8E0C6B4D9A13__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "strvec.h: missing include - vector.h"
+#endif
+
+//
+// TYPES
+//
+
+// String vector types
+typedef void* strvec;                              // string vector
+typedef const void* cstrvec;                       // const string vector
+
+// A string in place: mLength bytes at mpData, not nul terminated.
+typedef struct _stview {
+   const char* mpData;                             // first byte
+   uint64_t mLength;                               // byte count
+} stview;
+
+// String vector creation flags (see stcreatex).
+typedef enum {
+   stfnone = 0x00,                                 // every string stored
+   stfdedup = 0x01                                 // equal strings stored once
+} stflags;
+
+//
+// STRING VECTOR API
+//
+
+// Creation/destruction.
+// With stfdedup the blob and offsets hold each distinct string once (the
+// dictionary) and every string pushed is a code into it, as in an Arrow
+// dictionary array.
+strvec stcreate();                                 // construct empty vector
+strvec stcreatex(uint32_t flags);                  // ...with stflags
+void stdestroy(strvec* psv);                       // destroy existing vector
+
+// Size management.
+uint64_t stGetCount(cstrvec csv);                  // return string count
+uint64_t stGetUniqueCount(cstrvec csv);            // strings in the blob
+uint64_t stGetBytes(cstrvec csv);                  // return blob size
+retcode stReserve(strvec sv, uint64_t count, uint64_t bytes);
+void stClear(strvec sv);                           // empty the vector
+void stShrink(strvec sv);                          // free unused memory
+
+// Strings. Strings are copied in; a string may hold any bytes (up to 4GB).
+// stPushN adds count strings stored back to back in pData, string n being
+// pLengths[n] bytes long. Views stay valid until the next push.
+retcode stPush(strvec sv, const char* pData, uint64_t length);
+retcode stPushStr(strvec sv, const char* str);     // nul terminated string
+retcode stPushN(strvec sv, const char* pData, const uint64_t* pLengths,
+   uint64_t count);
+stview stGet(cstrvec csv, uint64_t index);         // empty view if no index
+
+// Arrow layout. Offsets are stGetUniqueCount() + 1 uint64_t values starting
+// at 0: string n is blob bytes [offsets[n], offsets[n + 1]). Codes are the
+// uint32_t dictionary index of each string (stfdedup only, else empty).
+cvspan stOffsets(cstrvec csv);
+cvspan stBlob(cstrvec csv);
+cvspan stCodes(cstrvec csv);
+
+#endif   // __STRVEC_H_0E9C4A7B3D1F42685F2A8E0C6B4D9A13__
@@ -29,6 +29,14 @@ Version control
 06 Feb 2023 Duncan Camilleri           Initial development
 29 Mar 2023 Duncan Camilleri           Moved cvreturn to commons.h
 31 Mar 2023 Duncan Camilleri           Introduced cvEmplaceBack
+17 Oct 2026 Duncan Camilleri           Growth policies (cvSetGrowthPolicy)
+17 Oct 2026 Duncan Camilleri           Bulk append and range insert
+17 Oct 2026 Duncan Camilleri           cvhead, inline accessors and spans
+17 Oct 2026 Duncan Camilleri           mTotalCount part of cvhead (vectort.h)
+17 Oct 2026 Duncan Camilleri           cvcreatex(), no-scrub, cvEmplaceBackN
+17 Oct 2026 Duncan Camilleri           64 bit counts, mmap backed large vectors
+17 Oct 2026 Duncan Camilleri           Small buffer vectors (cvcreatesbo)
+17 Oct 2026 Duncan Camilleri           Middle insert/erase, swap/pred. remove
 
 */
 
@@ -49,6 +57,17 @@ Version control
 // Vector
 #define makecvitem(_x)                       ((cvitem)&_x)
 
+// Span iteration (unchecked - see cvSpan).
+// cvforeach walks typed items where sizeof(_type) is the vector item size;
+// this is the form compilers can vectorize. cvforeachraw walks items of any
+// size through a void pointer using the span stride.
+#define cvforeach(_type, _p, _span)                                            \
+   for (_type* _p = (_type*)(_span).mpBegin;                                   \
+      _p < (_type*)(_span).mpEnd; ++_p)
+#define cvforeachraw(_p, _span)                                                \
+   for (void* _p = (_span).mpBegin;                                            \
+      _p < (_span).mpEnd; _p = (uint8_t*)_p + (_span).mStride)
+
 //
 // TYPES
 //
@@ -59,24 +78,122 @@ typedef void* cvitem;                              // vector item
 typedef const void* ccvector;                      // const vector
 typedef const void* ccvitem;                       // const vector item
 
+// Public head of every vector. The vector structure starts with these members
+// so the inline accessors below can read them without a call. Read only!
+// (vectort.h is the one exception as it appends into spare capacity.)
+typedef struct _cvhead {
+   void* mpData;                                   // items
+   uint64_t mItemCount;                            // number of items
+   uint64_t mTotalCount;                           // all items (incl. blanks)
+   uint32_t mItemSize;                             // stride between items
+} cvhead;
+
+// A contiguous range of items [mpBegin, mpEnd) mStride bytes apart.
+typedef struct _cvspan {
+   void* mpBegin;                                  // first item
+   void* mpEnd;                                    // one past the last item
+   uint32_t mStride;                               // item size
+} cvspan;
+
+// Vector creation flags (see cvcreatex).
+typedef enum {
+   cvfnone = 0x00,                                 // default behaviour
+   cvfnoscrub = 0x01,                              // never blank item memory
+   cvflarge = 0x02,                                // mmap/mremap backed data
+   cvfhugepage = 0x04                              // implies cvflarge
+} cvflags;
+
+// Vector growth policies (see cvSetGrowthPolicy).
+typedef enum {
+   cvgrowgeometric = 0x00,                         // grow by a factor (default)
+   cvgrowfixed = 0x01,                             // fixed chunk of items
+   cvgrowpage = 0x02                               // geometric, page rounded
+} cvgrowth;
+
 //
 // VECTOR API
 //
 
 // Creation/destruction.
 cvector cvcreate(uint32_t itemSize);               // construct empty vector
+cvector cvcreatex(uint32_t itemSize, uint32_t flags); // ...with cvflags
+cvector cvcreatesbo(uint32_t itemSize, uint32_t inlineCount, uint32_t flags);
 void cvdestroy(cvector* pv);                       // destroy existing vector
 
 // Item management - public api.
-uint32_t cvGetCount(ccvector cv);                  // return item count
-uint32_t cvGetSize(ccvector cv);                   // return total items
-retcode cvReserve(cvector v, uint32_t itemCount);  // total itemCount items
+uint64_t cvGetCount(ccvector cv);                  // return item count
+uint64_t cvGetSize(ccvector cv);                   // return total items
+uint32_t cvGetAllocCount(ccvector cv);             // data buffer (re)allocs
+retcode cvSetGrowthPolicy(cvector v, cvgrowth policy, uint32_t param);
+uint64_t cvGetAllocsAvoided();                     // by small buffer vectors
+void cvResetAllocsAvoided();
+retcode cvReserve(cvector v, uint64_t itemCount);  // total itemCount items
 void* cvEmplaceBack(cvector v, uint32_t* pSize);   // creates item at end
+void* cvEmplaceBackN(cvector v, uint64_t count);   // creates items at end
 void* cvPushBack(cvector v, cvitem item);          // add to the end
+void* cvPushBackN(cvector v, ccvitem items, uint64_t count);
+retcode cvAppendVector(cvector dst, ccvector src); // add src items to dst
+void* cvInsertRange(cvector v, uint64_t index, ccvitem items, uint64_t count);
+void* cvInsertAt(cvector v, uint64_t index, cvitem item); // insert one item
 void cvPopBack(cvector v);                         // remove & return last item
+retcode cvEraseAt(cvector v, uint64_t index);      // remove keeping order
+retcode cvEraseRange(cvector v, uint64_t index, uint64_t count);
+retcode cvSwapRemove(cvector v, uint64_t index);   // last item fills the gap
+uint64_t cvRemoveIf(cvector v, predicate pred, void* pCtx); // returns removed
 void cvClear(cvector v);                           // empty the vector
-void cvShrink(cvector v);                          // remove null tail elements
-void* cvGetAt(cvector v, uint32_t index);          // get/set item at index
-void* cvSetAt(cvector v, uint32_t index, cvitem item);
+void cvShrink(cvector v);                          // free unused memory
+void* cvGetAt(cvector v, uint64_t index);          // get/set item at index
+void* cvSetAt(cvector v, uint64_t index, cvitem item);
+
+//
+// INLINE UNCHECKED API
+// No null, data or bounds checks are made; never pass a null vector. Pointers
+// obtained are invalidated by any call that may grow or shrink the vector.
+//
+
+// Returns the item data (null when nothing was ever allocated).
+static inline void* cvData(ccvector cv)
+{
+   return ((const cvhead*)cv)->mpData;
+}
+
+// Returns the distance in bytes between consecutive items.
+static inline uint32_t cvStride(ccvector cv)
+{
+   return ((const cvhead*)cv)->mItemSize;
+}
+
+// Returns the number of items.
+static inline uint64_t cvCount(ccvector cv)
+{
+   return ((const cvhead*)cv)->mItemCount;
+}
+
+// Returns the item at index.
+static inline void* cvAt(ccvector cv, uint64_t index)
+{
+   const cvhead* ph = (const cvhead*)cv;
+   return (uint8_t*)ph->mpData + (index * ph->mItemSize);
+}
+
+// Returns a span over all items in the vector.
+static inline cvspan cvSpan(ccvector cv)
+{
+   const cvhead* ph = (const cvhead*)cv;
+   cvspan span;
+   span.mpBegin = ph->mpData;
+   span.mpEnd = (uint8_t*)ph->mpData + (ph->mItemCount * ph->mItemSize);
+   span.mStride = ph->mItemSize;
+   return span;
+}
+
+// Returns the number of items in a span.
+static inline uint64_t cvSpanCount(cvspan span)
+{
+   if (span.mStride == 0) return 0;
+   return (uint64_t)(((uint8_t*)span.mpEnd - (uint8_t*)span.mpBegin) /
+      span.mStride
+   );
+}
 
 #endif   // __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
@@ -0,0 +1,77 @@
+/*
+Date: 17 Oct 2026 14:05:52.640913277
+File: vectoralgo.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __VECTORALGO_H_1E7B40D9C25A83F6E0B917D4A6C3F258__
+Purpose: Sorting and searching over vectors.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __VECTORALGO_H_1E7B40D9C25A83F6E0B917D4A6C3F258__
+#define __VECTORALGO_H_1E7B40D9C25A83F6E0B917D4A6C3F258__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "vectoralgo.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Index returned by searches when no item is found.
+#define CV_NPOS                              ((uint64_t)-1)
+
+//
+// SORTING
+//
+
+// Sorts all items with the comparator given. cvSort is an introsort (not
+// stable, no allocation other than one item); cvStableSort is a merge sort
+// keeping equal items in order (allocates a copy of the items).
+retcode cvSort(cvector v, comparator cmp);
+retcode cvStableSort(cvector v, comparator cmp);
+
+// Sorts integer items of 4 or 8 bytes (native byte order) by value with a
+// radix sort. Fails for other item sizes.
+retcode cvRadixSort(cvector v, bool isSigned);
+
+//
+// SEARCHING
+//
+
+// Searches a vector sorted by cmp. cvLowerBound returns the index of the first
+// item not less than key (the item count if there is none). cvBinarySearch
+// returns the index of an item equal to key or CV_NPOS.
+uint64_t cvLowerBound(cvector v, const void* key, comparator cmp);
+uint64_t cvBinarySearch(cvector v, const void* key, comparator cmp);
+
+// Returns the index of the first item equal (byte for byte) to item or CV_NPOS.
+// Items of 4 and 8 bytes are compared with AVX2 or SSE2 when available.
+uint64_t cvFind(cvector v, const void* item);
+
+#endif   // __VECTORALGO_H_1E7B40D9C25A83F6E0B917D4A6C3F258__
@@ -0,0 +1,97 @@
+/*
+Date: 17 Oct 2026 15:20:37.184502916
+File: vectorpar.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __VECTORPAR_H_3B8E5D1F70C2A4968F1D0E7B5C39A246__
+Purpose: Parallel algorithms over vectors. Work is split into chunks of about
+         cvParSetChunkSize() bytes which are handed out to an internal pool of
+         worker threads; the calling thread works on chunks as well. The pool
+         is started on first use and runs one algorithm at a time.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#ifndef __VECTORPAR_H_3B8E5D1F70C2A4968F1D0E7B5C39A246__
+#define __VECTORPAR_H_3B8E5D1F70C2A4968F1D0E7B5C39A246__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "vectorpar.h: missing include - vector.h"
+#endif
+
+//
+// TYPES
+//
+
+// Called for each item with its index.
+typedef void (*cvparitem)(void* pItem, uint64_t index, void* pCtx);
+// Writes the transformed pSrc item to pDst.
+typedef void (*cvparmap)(void* pDst, const void* pSrc, void* pCtx);
+// Folds pItem into the accumulator pAcc.
+typedef void (*cvparfold)(void* pAcc, const void* pItem, void* pCtx);
+
+//
+// POOL CONFIGURATION
+//
+
+// Sets the number of threads (including the caller) used by the parallel
+// algorithms; 0 selects one per online cpu. A running pool is stopped and
+// restarted on next use. Do not call while an algorithm is running.
+retcode cvParSetThreads(uint32_t threads);
+uint32_t cvParGetThreads();
+
+// Sets the size in bytes of the chunks of items handed to each thread; 0
+// selects the default. Chunks of a few cache lines to an L2 worth of items
+// keep each thread on its own memory.
+void cvParSetChunkSize(uint32_t bytes);
+
+// Stops the worker threads. The pool restarts on next use.
+void cvParShutdown();
+
+//
+// PARALLEL ALGORITHMS
+//
+
+// Calls fn on every item. fn must not touch other items and must not call the
+// parallel algorithms (nested calls run on the calling thread only).
+retcode cvParallelForEach(cvector v, cvparitem fn, void* pCtx);
+
+// Sets dst to one item per item of src, written by fn. dst may have a
+// different item size and may be src itself.
+retcode cvParallelTransform(ccvector src, cvector dst, cvparmap fn, void* pCtx);
+
+// Folds all items into pResult (resultSize bytes) which holds the identity
+// value on entry. Each chunk is folded from the identity with fold and chunk
+// results are then combined in item order with combine (pItem is a chunk
+// result). The result does not depend on the thread count.
+retcode cvParallelReduce(ccvector v, void* pResult, uint32_t resultSize,
+   cvparfold fold, cvparfold combine, void* pCtx);
+
+// Stable merge sort. Parts are sorted by each thread then merged in rounds,
+// with each merge split across threads. Allocates a copy of the items.
+retcode cvParallelSort(cvector v, comparator cmp);
+
+#endif   // __VECTORPAR_H_3B8E5D1F70C2A4968F1D0E7B5C39A246__
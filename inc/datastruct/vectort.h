@@ -0,0 +1,130 @@
+/*
+Date: 17 Oct 2026 11:02:47.305118264
+File: vectort.h
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __VECTORT_H_5C1E93B07A2D48F6B9E0D4A371C86F25__
+Purpose: Type specialized vectors. CV_DECLARE(name, T) generates inline
+         functions over a cvector holding items of type T. The item size is a
+         compile time constant so copies are plain assignments and loops over
+         name_data() can be vectorized. Growth is left to vector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           64 bit counts and indexes
+*/
+
+#ifndef __VECTORT_H_5C1E93B07A2D48F6B9E0D4A371C86F25__
+#define __VECTORT_H_5C1E93B07A2D48F6B9E0D4A371C86F25__
+
+//
+// MISSING INCLUDES.
+//
+#if !defined __VECTOR_H_75B4DE9E8D0BE655A21DFEEB367A2322__
+#error "vectort.h: missing include - vector.h"
+#endif
+
+//
+// MACROS
+//
+
+// Declares the typed vector api for items of type T. Functions generated:
+//    name_create()                          construct empty vector of T
+//    name_destroy(pv)                       destroy existing vector
+//    name_reserve(v, count)                 reserve count items
+//    name_count(v)                          return item count
+//    name_data(v)                           return items as T*
+//    name_push(v, item)                     add item to the end (T* or null)
+//    name_pop(v)                            remove & return last item
+//    name_get(v, index)                     return item at index
+//    name_at(v, index)                      return pointer to item at index
+//    name_set(v, index, item)               set item at index
+// Like the inline api in vector.h, none of these check the vector or indexes.
+// Vectors created through name_create() work with the untyped api as well.
+#define CV_DECLARE(name, T)                                                    \
+                                                                               \
+static inline cvector name##_create()                                          \
+{                                                                              \
+   return cvcreate(sizeof(T));                                                 \
+}                                                                              \
+                                                                               \
+static inline void name##_destroy(cvector* pv)                                 \
+{                                                                              \
+   cvdestroy(pv);                                                              \
+}                                                                              \
+                                                                               \
+static inline retcode name##_reserve(cvector v, uint64_t count)                \
+{                                                                              \
+   return cvReserve(v, count);                                                 \
+}                                                                              \
+                                                                               \
+static inline uint64_t name##_count(ccvector v)                                \
+{                                                                              \
+   return ((const cvhead*)v)->mItemCount;                                      \
+}                                                                              \
+                                                                               \
+static inline T* name##_data(ccvector v)                                       \
+{                                                                              \
+   return (T*)((const cvhead*)v)->mpData;                                      \
+}                                                                              \
+                                                                               \
+static inline T* name##_push(cvector v, T item)                                \
+{                                                                              \
+   cvhead* ph = (cvhead*)v;                                                    \
+   T* pItem = 0;                                                               \
+   if (ph->mItemCount < ph->mTotalCount) {                                     \
+      /* Spare capacity - store in place. */                                   \
+      pItem = ((T*)ph->mpData) + ph->mItemCount;                               \
+      ph->mItemCount++;                                                        \
+   } else {                                                                    \
+      /* Let vector.c grow the buffer. */                                      \
+      pItem = (T*)cvEmplaceBack(v, 0);                                         \
+      if (!pItem) return 0;                                                    \
+   }                                                                           \
+   *pItem = item;                                                              \
+   return pItem;                                                               \
+}                                                                              \
+                                                                               \
+static inline T name##_pop(cvector v)                                          \
+{                                                                              \
+   cvhead* ph = (cvhead*)v;                                                    \
+   T item = ((T*)ph->mpData)[ph->mItemCount - 1];                              \
+   cvPopBack(v);                                                               \
+   return item;                                                                \
+}                                                                              \
+                                                                               \
+static inline T name##_get(ccvector v, uint64_t index)                         \
+{                                                                              \
+   return ((T*)((const cvhead*)v)->mpData)[index];                             \
+}                                                                              \
+                                                                               \
+static inline T* name##_at(ccvector v, uint64_t index)                         \
+{                                                                              \
+   return ((T*)((const cvhead*)v)->mpData) + index;                            \
+}                                                                              \
+                                                                               \
+static inline void name##_set(cvector v, uint64_t index, T item)               \
+{                                                                              \
+   ((T*)((cvhead*)v)->mpData)[index] = item;                                   \
+}
+
+#endif   // __VECTORT_H_5C1E93B07A2D48F6B9E0D4A371C86F25__
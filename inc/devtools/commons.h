@@ -31,6 +31,8 @@ Version control
 30 Mar 2023 Duncan Camilleri           Introduced boolean types
 30 Mar 2023 Duncan Camilleri           Introduced assigner function pointer type
 31 Mar 2023 Duncan Camilleri           Renamed retcode values without cv prefix
+17 Oct 2026 Duncan Camilleri           Introduced predicate function pointer
+17 Oct 2026 Duncan Camilleri           Introduced hasher function pointer type
 */
 
 #ifndef __COMMONS_H_2224725FD5DAE2AC90D80099D5A003C5__
@@ -67,6 +69,8 @@ typedef enum {
 //
 // comparator(a, b)                          compares a with b and gives result
 // assigner(a, b)                            assign b to a and gives a
+// predicate(a, pCtx)                        tests a and gives true or false
+// hasher(a, size)                           hashes size bytes at a
 
 // Comparator function to compare a with b.
 // Expected return values:
@@ -80,5 +84,13 @@ typedef int8_t (*comparator)(void* a, void* b);
 // Returns back a (pointer).
 typedef void* (*assigner)(void* a, void* b);
 
+// Predicate function to test a. pCtx is passed through from the caller.
+typedef bool (*predicate)(void* a, void* pCtx);
+
+// Hash function giving a 64 bit hash of the size bytes at a. All bits of the
+// result should depend on the input (hash tables use both the low and high
+// bits).
+typedef uint64_t (*hasher)(const void* a, uint32_t size);
+
 #endif   // __COMMONS_H_2224725FD5DAE2AC90D80099D5A003C5__
 
@@ -0,0 +1,168 @@
+/*
+Date: 17 Oct 2026 16:48:05.304881276
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_91E6B3F04A2D57C8E1B0D6A39F7C4258__
+Purpose: Benchmarks for bitvector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (popcount, and)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <bitvector.h>
+
+//
+// MACROS
+//
+
+// Largest power of ten benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 8
+// Each operation is repeated to total about this many bits.
+#define BENCH_TOTAL_BITS                     1000000000ull
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+//
+// BENCHMARKS
+//
+
+// Holds count flags as bytes in a vector and as bits in a bit vector and
+// times counting the set flags and and-ing two sets of flags.
+void benchFlags(uint64_t count)
+{
+   cvector bytesA = cvcreate(sizeof(uint8_t));
+   cvector bytesB = cvcreate(sizeof(uint8_t));
+   bitvector bitsA = bvcreate();
+   bitvector bitsB = bvcreate();
+   if (!bytesA || !bytesB || !bitsA || !bitsB ||
+      !cvEmplaceBackN(bytesA, count) || !cvEmplaceBackN(bytesB, count) ||
+      success != bvResize(bitsA, count) || success != bvResize(bitsB, count)) {
+      cvdestroy(&bytesA);
+      cvdestroy(&bytesB);
+      bvdestroy(&bitsA);
+      bvdestroy(&bitsB);
+      return;
+   }
+
+   // Same random flags in both.
+   uint8_t* pA = (uint8_t*)cvData(bytesA);
+   uint8_t* pB = (uint8_t*)cvData(bytesB);
+   uint64_t seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count; ++n) {
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      pA[n] = seed & 1;
+      pB[n] = (seed >> 1) & 1;
+      bvAssign(bitsA, n, pA[n]);
+      bvAssign(bitsB, n, pB[n]);
+   }
+
+   uint64_t rounds = BENCH_TOTAL_BITS / count;
+   if (rounds == 0) rounds = 1;
+   uint64_t counts[2] = { 0 };
+
+   // Count set flags.
+   double start = benchNow();
+   for (uint64_t r = 0; r < rounds; ++r) {
+      uint64_t total = 0;
+      for (uint64_t n = 0; n < count; ++n) total += pA[n];
+      counts[0] += total;
+   }
+   double bytesCount = benchNow() - start;
+
+   start = benchNow();
+   for (uint64_t r = 0; r < rounds; ++r) {
+      counts[1] += bvPopCount(bitsA);
+   }
+   double bitsCount = benchNow() - start;
+
+   // And flags (b &= a; b is the same after the first round).
+   start = benchNow();
+   for (uint64_t r = 0; r < rounds; ++r) {
+      for (uint64_t n = 0; n < count; ++n) pB[n] &= pA[n];
+   }
+   double bytesAnd = benchNow() - start;
+
+   start = benchNow();
+   for (uint64_t r = 0; r < rounds; ++r) {
+      bvAnd(bitsB, bitsA);
+   }
+   double bitsAnd = benchNow() - start;
+
+   // Results must agree.
+   bool match = (counts[0] == counts[1]);
+   for (uint64_t n = 0; n < count && match; ++n) {
+      if (pB[n] != bvTest(bitsB, n)) match = false;
+   }
+
+   double bits = (double)count * rounds;
+   printf("%12" PRIu64 " %9.1f %9.1f %10.1f %10.1f %10.1f %10.1f %s\n", count,
+      count / 1024.0, ((count + 63) / 64) * 8 / 1024.0,
+      bits / bytesCount / 1e9, bits / bitsCount / 1e9,
+      bits / bytesAnd / 1e9, bits / bitsAnd / 1e9,
+      (match ? "" : "(mismatch!)")
+   );
+
+   cvdestroy(&bytesA);
+   cvdestroy(&bytesB);
+   bvdestroy(&bitsA);
+   bvdestroy(&bitsB);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 9) maxExp = 9;
+
+   // Memory in KiB, counting and and-ing in billion flags per second.
+   printf("%12s %9s %9s %10s %10s %10s %10s\n", "flags",
+      "KiB bytes", "KiB bits", "cnt bytes", "cnt bits", "and bytes",
+      "and bits");
+   uint64_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchFlags(count);
+   }
+
+   return 0;
+}
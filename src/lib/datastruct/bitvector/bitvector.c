@@ -0,0 +1,650 @@
+/*
+Date: 17 Oct 2026 16:48:05.261085317
+File: bitvector.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BITVECTOR_C_E39B07D15A6C48F2B1D0E8A37F5C6924__
+Purpose: Implements a packed bit vector. Bits are stored 64 to a word in a
+         vector of words, so it grows like a vector does. Popcount and bulk
+         operations work a word (or a SIMD register) at a time, picking AVX2,
+         POPCNT or plain code at runtime.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+#include <immintrin.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <bitvector.h>
+
+//
+// MACROS
+//
+#define BITVECTOR_WORDBITS                   64
+// Words per rank index block (512 bits).
+#define BITVECTOR_RANKWORDS                  8
+
+// Words needed for a number of bits.
+#define bitwords(_bits)                      (((_bits) + 63) / 64)
+
+// Applies op to each word of dst with the matching word of src. Used to build
+// the bulk operation kernels (each is compiled for its own instruction set).
+#define BITVECTOR_WORDOP(_pDst, _pSrc, _n, _op, _from)                         \
+   switch (_op) {                                                              \
+      case bitopand:                                                           \
+         for (uint64_t w = _from; w < _n; ++w) _pDst[w] &= _pSrc[w];           \
+         break;                                                                \
+      case bitopor:                                                            \
+         for (uint64_t w = _from; w < _n; ++w) _pDst[w] |= _pSrc[w];           \
+         break;                                                                \
+      case bitopxor:                                                           \
+         for (uint64_t w = _from; w < _n; ++w) _pDst[w] ^= _pSrc[w];           \
+         break;                                                                \
+      case bitopandnot:                                                        \
+         for (uint64_t w = _from; w < _n; ++w) _pDst[w] &= ~_pSrc[w];          \
+         break;                                                                \
+   }
+
+//
+// TYPES
+//
+
+// Bulk operations.
+typedef enum {
+   bitopand,
+   bitopor,
+   bitopxor,
+   bitopandnot
+} bitopcode;
+
+// Kernels picked at runtime.
+typedef uint64_t (*popcounter)(const uint64_t* pWords, uint64_t count);
+typedef void (*bitop)(uint64_t* pDst, const uint64_t* pSrc, uint64_t count,
+   bitopcode op);
+
+//
+// STRUCTS
+//
+
+// Bits live in mWords; bits past mBitCount in the last word are kept clear so
+// that whole words can be counted and combined. mRank holds the set bits
+// before each block of BITVECTOR_RANKWORDS words (and the total at the end).
+typedef struct _bitvec {
+   uint64_t mBitCount;                             // number of bits
+   cvector mWords;                                 // uint64_t words
+   cvector mRank;                                  // rank index
+   bool mRankValid;                                // rank index is current
+} bitvec;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new bit vector. Initially the vector will be empty. No memory will
+// be allocated for words unless necessary.
+bitvector bvcreate()
+{
+   bitvec* pbv = (bitvec*)malloc(sizeof(bitvec));
+   if (!pbv) return nul;
+   memset(pbv, 0, sizeof(bitvec));
+
+   pbv->mWords = cvcreate(sizeof(uint64_t));
+   pbv->mRank = cvcreate(sizeof(uint64_t));
+   if (!pbv->mWords || !pbv->mRank) {
+      cvdestroy(&pbv->mWords);
+      cvdestroy(&pbv->mRank);
+      free(pbv);
+      return nul;
+   }
+
+   // Done.
+   return (bitvector)pbv;
+}
+
+// Destroy existing bit vector.
+void bvdestroy(bitvector* pbv)
+{
+   if (nul == pbv) return;
+   if (nul == (*pbv)) return;
+
+   bitvec* bv = (bitvec*)*pbv;
+   cvdestroy(&bv->mWords);
+   cvdestroy(&bv->mRank);
+
+   free(*pbv);
+   *pbv = 0;
+}
+
+//
+// Private API - Kernels.
+//
+
+// Counts set bits in count words.
+uint64_t bitsPopcntGeneric(const uint64_t* pWords, uint64_t count)
+{
+   uint64_t total = 0;
+   for (uint64_t i = 0; i < count; ++i) {
+      total += __builtin_popcountll(pWords[i]);
+   }
+   return total;
+}
+
+// Counts set bits in count words with the POPCNT instruction.
+__attribute__((target("popcnt")))
+uint64_t bitsPopcntHw(const uint64_t* pWords, uint64_t count)
+{
+   uint64_t total = 0;
+   for (uint64_t i = 0; i < count; ++i) {
+      total += __builtin_popcountll(pWords[i]);
+   }
+   return total;
+}
+
+// Counts set bits in count words with AVX2. Each nibble is counted through a
+// shuffle lookup and byte counts are summed into 64 bit lanes (Mula).
+__attribute__((target("avx2,popcnt")))
+uint64_t bitsPopcntAvx2(const uint64_t* pWords, uint64_t count)
+{
+   const __m256i lookup = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+   );
+   const __m256i nibble = _mm256_set1_epi8(0x0F);
+   __m256i acc = _mm256_setzero_si256();
+
+   uint64_t i = 0;
+   for (; i + 4 <= count; i += 4) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(pWords + i));
+      __m256i lo = _mm256_and_si256(v, nibble);
+      __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+      __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+         _mm256_shuffle_epi8(lookup, hi));
+      acc = _mm256_add_epi64(acc,
+         _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+   }
+
+   uint64_t total = (uint64_t)_mm256_extract_epi64(acc, 0) +
+      (uint64_t)_mm256_extract_epi64(acc, 1) +
+      (uint64_t)_mm256_extract_epi64(acc, 2) +
+      (uint64_t)_mm256_extract_epi64(acc, 3);
+   for (; i < count; ++i) {
+      total += __builtin_popcountll(pWords[i]);
+   }
+   return total;
+}
+
+// Bulk operation over count words, SSE2 (x86-64 baseline).
+void bitsOpSse2(uint64_t* pDst, const uint64_t* pSrc, uint64_t count,
+   bitopcode op)
+{
+   uint64_t i = 0;
+   for (; i + 2 <= count; i += 2) {
+      __m128i d = _mm_loadu_si128((const __m128i*)(pDst + i));
+      __m128i s = _mm_loadu_si128((const __m128i*)(pSrc + i));
+      switch (op) {
+         case bitopand:    d = _mm_and_si128(d, s); break;
+         case bitopor:     d = _mm_or_si128(d, s); break;
+         case bitopxor:    d = _mm_xor_si128(d, s); break;
+         case bitopandnot: d = _mm_andnot_si128(s, d); break;
+      }
+      _mm_storeu_si128((__m128i*)(pDst + i), d);
+   }
+   BITVECTOR_WORDOP(pDst, pSrc, count, op, i)
+}
+
+// Bulk operation over count words, AVX2.
+__attribute__((target("avx2")))
+void bitsOpAvx2(uint64_t* pDst, const uint64_t* pSrc, uint64_t count,
+   bitopcode op)
+{
+   uint64_t i = 0;
+   for (; i + 4 <= count; i += 4) {
+      __m256i d = _mm256_loadu_si256((const __m256i*)(pDst + i));
+      __m256i s = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+      switch (op) {
+         case bitopand:    d = _mm256_and_si256(d, s); break;
+         case bitopor:     d = _mm256_or_si256(d, s); break;
+         case bitopxor:    d = _mm256_xor_si256(d, s); break;
+         case bitopandnot: d = _mm256_andnot_si256(s, d); break;
+      }
+      _mm256_storeu_si256((__m256i*)(pDst + i), d);
+   }
+   BITVECTOR_WORDOP(pDst, pSrc, count, op, i)
+}
+
+// Returns the kernels best suited to this cpu. The choice is made once.
+void bitsKernels(popcounter* pPopcnt, bitop* pOp)
+{
+   static popcounter popcnt = nul;
+   static bitop op = nul;
+
+   if (!__atomic_load_n(&popcnt, __ATOMIC_ACQUIRE)) {
+      __builtin_cpu_init();
+      popcounter p = bitsPopcntGeneric;
+      bitop o = bitsOpSse2;
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+         p = bitsPopcntAvx2;
+         o = bitsOpAvx2;
+      } else if (__builtin_cpu_supports("popcnt")) {
+         p = bitsPopcntHw;
+      }
+      __atomic_store_n(&op, o, __ATOMIC_RELAXED);
+      __atomic_store_n(&popcnt, p, __ATOMIC_RELEASE);
+   }
+
+   // op was stored before popcnt was published.
+   popcounter p = __atomic_load_n(&popcnt, __ATOMIC_ACQUIRE);
+   if (pPopcnt) *pPopcnt = p;
+   if (pOp) *pOp = __atomic_load_n(&op, __ATOMIC_RELAXED);
+}
+
+// Counts set bits in count words with the best kernel.
+uint64_t bitsPopcount(const uint64_t* pWords, uint64_t count)
+{
+   popcounter popcnt = nul;
+   bitsKernels(&popcnt, nul);
+   return popcnt(pWords, count);
+}
+
+//
+// Private API - Words.
+//
+
+// Returns the words and their number.
+uint64_t* bitsData(const bitvec* pbv, uint64_t* pCount)
+{
+   *pCount = cvCount(pbv->mWords);
+   return (uint64_t*)cvData(pbv->mWords);
+}
+
+// Clears bits past the bit count in the last word.
+void bitsMaskTail(bitvec* pbv)
+{
+   uint32_t used = pbv->mBitCount % BITVECTOR_WORDBITS;
+   if (used == 0) return;
+
+   uint64_t count = 0;
+   uint64_t* pWords = bitsData(pbv, &count);
+   pWords[count - 1] &= (((uint64_t)1 << used) - 1);
+}
+
+// Applies op from src to dst.
+retcode bitsApply(bitvector dst, cbitvector src, bitopcode op)
+{
+   bitvec* pDst = (bitvec*)dst;
+   const bitvec* pSrc = (const bitvec*)src;
+   if (!pDst || !pSrc) return fail;
+
+   uint64_t dstCount = 0, srcCount = 0;
+   uint64_t* pDstWords = bitsData(pDst, &dstCount);
+   const uint64_t* pSrcWords = bitsData(pSrc, &srcCount);
+   uint64_t count = (dstCount < srcCount ? dstCount : srcCount);
+
+   // dst and src may be the same vector.
+   bitop kernel = nul;
+   bitsKernels(nul, &kernel);
+   if (count > 0) kernel(pDstWords, pSrcWords, count, op);
+
+   // Past the end of src, only AND changes dst.
+   if (op == bitopand && dstCount > count) {
+      memset(pDstWords + count, 0,
+         (size_t)(dstCount - count) * sizeof(uint64_t));
+   }
+
+   bitsMaskTail(pDst);
+   pDst->mRankValid = false;
+   return success;
+}
+
+// Builds the rank index.
+retcode bitsBuildRank(bitvec* pbv)
+{
+   if (pbv->mRankValid) return success;
+
+   uint64_t count = 0;
+   const uint64_t* pWords = bitsData(pbv, &count);
+   uint64_t blocks = (count + BITVECTOR_RANKWORDS - 1) / BITVECTOR_RANKWORDS;
+
+   cvClear(pbv->mRank);
+   uint64_t* pRank = (uint64_t*)cvEmplaceBackN(pbv->mRank, blocks + 1);
+   if (!pRank) return fail;
+
+   popcounter popcnt = nul;
+   bitsKernels(&popcnt, nul);
+   uint64_t total = 0;
+   for (uint64_t b = 0; b < blocks; ++b) {
+      pRank[b] = total;
+      uint64_t first = b * BITVECTOR_RANKWORDS;
+      uint64_t n = count - first;
+      if (n > BITVECTOR_RANKWORDS) n = BITVECTOR_RANKWORDS;
+      total += popcnt(pWords + first, n);
+   }
+   pRank[blocks] = total;
+
+   pbv->mRankValid = true;
+   return success;
+}
+
+//
+// Size management.
+//
+
+// Returns the number of bits in the vector.
+uint64_t bvGetCount(cbitvector cbv)
+{
+   const bitvec* pbv = (const bitvec*)cbv;
+   return (pbv ? pbv->mBitCount : 0);
+}
+
+// Sets the growth policy of the word vector (see cvSetGrowthPolicy).
+retcode bvSetGrowthPolicy(bitvector bv, cvgrowth policy, uint32_t param)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return fail;
+   return cvSetGrowthPolicy(pbv->mWords, policy, param);
+}
+
+// Reserve bitCount bits in the vector.
+retcode bvReserve(bitvector bv, uint64_t bitCount)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return fail;
+   return cvReserve(pbv->mWords, bitwords(bitCount));
+}
+
+// Sets the number of bits. Bits added are clear.
+retcode bvResize(bitvector bv, uint64_t bitCount)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return fail;
+
+   uint64_t words = bitwords(bitCount);
+   uint64_t count = cvCount(pbv->mWords);
+   if (words > count) {
+      void* pNew = cvEmplaceBackN(pbv->mWords, words - count);
+      if (!pNew) return fail;
+      memset(pNew, 0, (size_t)(words - count) * sizeof(uint64_t));
+   } else if (words < count) {
+      cvEraseRange(pbv->mWords, words, count - words);
+   }
+
+   pbv->mBitCount = bitCount;
+   bitsMaskTail(pbv);
+   pbv->mRankValid = false;
+   return success;
+}
+
+// Adds a bit after the last bit.
+retcode bvPushBack(bitvector bv, bool value)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return fail;
+
+   if (pbv->mBitCount % BITVECTOR_WORDBITS == 0) {
+      uint64_t word = 0;
+      if (!cvPushBack(pbv->mWords, makecvitem(word))) return fail;
+   }
+
+   uint64_t index = pbv->mBitCount++;
+   if (value) {
+      ((uint64_t*)cvData(pbv->mWords))[index / BITVECTOR_WORDBITS] |=
+         ((uint64_t)1 << (index % BITVECTOR_WORDBITS));
+   }
+   pbv->mRankValid = false;
+   return success;
+}
+
+// Frees word memory not needed for the bits held.
+void bvShrink(bitvector bv)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return;
+   cvShrink(pbv->mWords);
+}
+
+//
+// Single bits.
+//
+
+// Sets the bit at index.
+void bvSet(bitvector bv, uint64_t index)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv || index >= pbv->mBitCount) return;
+
+   ((uint64_t*)cvData(pbv->mWords))[index / BITVECTOR_WORDBITS] |=
+      ((uint64_t)1 << (index % BITVECTOR_WORDBITS));
+   pbv->mRankValid = false;
+}
+
+// Clears the bit at index.
+void bvClear(bitvector bv, uint64_t index)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv || index >= pbv->mBitCount) return;
+
+   ((uint64_t*)cvData(pbv->mWords))[index / BITVECTOR_WORDBITS] &=
+      ~((uint64_t)1 << (index % BITVECTOR_WORDBITS));
+   pbv->mRankValid = false;
+}
+
+// Sets or clears the bit at index.
+void bvAssign(bitvector bv, uint64_t index, bool value)
+{
+   if (value) {
+      bvSet(bv, index);
+   } else {
+      bvClear(bv, index);
+   }
+}
+
+// Returns the bit at index.
+bool bvTest(cbitvector cbv, uint64_t index)
+{
+   const bitvec* pbv = (const bitvec*)cbv;
+   if (!pbv || index >= pbv->mBitCount) return false;
+
+   const uint64_t* pWords = (const uint64_t*)cvData(pbv->mWords);
+   uint64_t word = pWords[index / BITVECTOR_WORDBITS];
+   return (word >> (index % BITVECTOR_WORDBITS)) & 1;
+}
+
+// Sets or clears all bits.
+void bvFill(bitvector bv, bool value)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return;
+
+   uint64_t count = 0;
+   uint64_t* pWords = bitsData(pbv, &count);
+   if (count == 0) return;
+
+   memset(pWords, value ? 0xFF : 0x00, (size_t)count * sizeof(uint64_t));
+   bitsMaskTail(pbv);
+   pbv->mRankValid = false;
+}
+
+//
+// Bulk operations.
+//
+
+// dst &= src.
+retcode bvAnd(bitvector dst, cbitvector src)
+{
+   return bitsApply(dst, src, bitopand);
+}
+
+// dst |= src.
+retcode bvOr(bitvector dst, cbitvector src)
+{
+   return bitsApply(dst, src, bitopor);
+}
+
+// dst ^= src.
+retcode bvXor(bitvector dst, cbitvector src)
+{
+   return bitsApply(dst, src, bitopxor);
+}
+
+// dst &= ~src.
+retcode bvAndNot(bitvector dst, cbitvector src)
+{
+   return bitsApply(dst, src, bitopandnot);
+}
+
+//
+// Counting and searching.
+//
+
+// Returns the number of set bits.
+uint64_t bvPopCount(cbitvector cbv)
+{
+   const bitvec* pbv = (const bitvec*)cbv;
+   if (!pbv) return 0;
+
+   uint64_t count = 0;
+   const uint64_t* pWords = bitsData(pbv, &count);
+   return bitsPopcount(pWords, count);
+}
+
+// Returns the number of set bits before index (all of them for indexes past
+// the end).
+uint64_t bvRank(bitvector bv, uint64_t index)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return 0;
+   if (index > pbv->mBitCount) index = pbv->mBitCount;
+
+   // Without an index, count all words before.
+   uint64_t count = 0;
+   const uint64_t* pWords = bitsData(pbv, &count);
+   uint64_t word = index / BITVECTOR_WORDBITS;
+   uint64_t rank = 0;
+   uint64_t first = 0;
+   if (success == bitsBuildRank(pbv)) {
+      uint64_t block = word / BITVECTOR_RANKWORDS;
+      rank = ((const uint64_t*)cvData(pbv->mRank))[block];
+      first = block * BITVECTOR_RANKWORDS;
+   }
+
+   rank += bitsPopcount(pWords + first, word - first);
+   uint32_t bit = index % BITVECTOR_WORDBITS;
+   if (bit) {
+      rank += __builtin_popcountll(pWords[word] & (((uint64_t)1 << bit) - 1));
+   }
+   return rank;
+}
+
+// Returns the index of set bit number k or BV_NPOS.
+uint64_t bvSelect(bitvector bv, uint64_t k)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (!pbv) return BV_NPOS;
+   if (fail == bitsBuildRank(pbv)) return BV_NPOS;
+
+   uint64_t count = 0;
+   const uint64_t* pWords = bitsData(pbv, &count);
+   const uint64_t* pRank = (const uint64_t*)cvData(pbv->mRank);
+   uint64_t blocks = cvCount(pbv->mRank) - 1;
+   if (k >= pRank[blocks]) return BV_NPOS;
+
+   // Last block with fewer than k set bits before it.
+   uint64_t lo = 0, hi = blocks - 1;
+   while (lo < hi) {
+      uint64_t mid = lo + ((hi - lo + 1) / 2);
+      if (pRank[mid] <= k) {
+         lo = mid;
+      } else {
+         hi = mid - 1;
+      }
+   }
+   k -= pRank[lo];
+
+   // Word within the block, then the bit within the word.
+   for (uint64_t w = lo * BITVECTOR_RANKWORDS; w < count; ++w) {
+      uint64_t word = pWords[w];
+      uint64_t bits = __builtin_popcountll(word);
+      if (k >= bits) {
+         k -= bits;
+         continue;
+      }
+      while (k-- > 0) word &= (word - 1);
+      return (w * BITVECTOR_WORDBITS) + __builtin_ctzll(word);
+   }
+
+   return BV_NPOS;
+}
+
+// Returns the index of the first set bit or BV_NPOS.
+uint64_t bvFindFirst(cbitvector cbv)
+{
+   return bvFindNext(cbv, 0);
+}
+
+// Returns the index of the first set bit at or after from, or BV_NPOS.
+uint64_t bvFindNext(cbitvector cbv, uint64_t from)
+{
+   const bitvec* pbv = (const bitvec*)cbv;
+   if (!pbv || from >= pbv->mBitCount) return BV_NPOS;
+
+   uint64_t count = 0;
+   const uint64_t* pWords = bitsData(pbv, &count);
+   uint64_t w = from / BITVECTOR_WORDBITS;
+   uint64_t word = pWords[w] & (~(uint64_t)0 << (from % BITVECTOR_WORDBITS));
+   for (;;) {
+      if (word) return (w * BITVECTOR_WORDBITS) + __builtin_ctzll(word);
+      if (++w >= count) return BV_NPOS;
+      word = pWords[w];
+   }
+}
+
+//
+// Word access.
+//
+
+// Returns the words and sets pWordCount to their number.
+uint64_t* bvWords(bitvector bv, uint64_t* pWordCount)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (pWordCount) *pWordCount = 0;
+   if (!pbv) return nul;
+
+   uint64_t count = 0;
+   uint64_t* pWords = bitsData(pbv, &count);
+   if (pWordCount) *pWordCount = count;
+   return pWords;
+}
+
+// Marks the rank index stale after writes through bvWords().
+void bvTouch(bitvector bv)
+{
+   bitvec* pbv = (bitvec*)bv;
+   if (pbv) pbv->mRankValid = false;
+}
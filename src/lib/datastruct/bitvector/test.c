@@ -0,0 +1,246 @@
+/*
+Date: 17 Oct 2026 16:48:05.290417653
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_2D8F5A1B7E3C46D09A6B1F4E8C2D7053__
+Purpose: Tests for bitvector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <bitvector.h>
+
+//
+// TEST CASES
+//
+
+// Tests creation, sizing and single bits.
+bool testBits(TFSuite pTest)
+{
+   bitvector bv = bvcreate();
+   if (false == tfzassert(pTest, bv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, bvGetCount(bv) == 0, true, false);
+   tfzassert(pTest, bvFindFirst(bv) == BV_NPOS, true, false);
+
+   // Pushed bits.
+   for (uint32_t n = 0; n < 200; ++n) {
+      tfzassert(pTest, bvPushBack(bv, n % 3 == 0), success, false);
+   }
+   tfzassert(pTest, bvGetCount(bv) == 200, true, false);
+   tfzassert(pTest, bvTest(bv, 99), true, false);
+   tfzassert(pTest, bvTest(bv, 100), false, false);
+   tfzassert(pTest, bvTest(bv, 200), false, false);
+
+   // Set, clear and assign; out of range is ignored.
+   bvSet(bv, 100);
+   bvClear(bv, 99);
+   bvAssign(bv, 101, true);
+   bvSet(bv, 200);
+   tfzassert(pTest, bvTest(bv, 100), true, false);
+   tfzassert(pTest, bvTest(bv, 99), false, false);
+   tfzassert(pTest, bvTest(bv, 101), true, false);
+   tfzassert(pTest, bvGetCount(bv) == 200, true, false);
+
+   // Filling keeps bits past the end clear.
+   bvFill(bv, true);
+   tfzassert(pTest, bvPopCount(bv) == 200, true, false);
+   uint64_t words = 0;
+   uint64_t* pWords = bvWords(bv, &words);
+   tfzassert(pTest, words == 4, true, false);
+   tfzassert(pTest, pWords[3] == 0xFF, true, false);
+
+   // Growing adds clear bits, truncating drops them.
+   tfzassert(pTest, bvResize(bv, 300), success, false);
+   tfzassert(pTest, bvPopCount(bv) == 200, true, false);
+   tfzassert(pTest, bvTest(bv, 250), false, false);
+   tfzassert(pTest, bvResize(bv, 70), success, false);
+   tfzassert(pTest, bvPopCount(bv) == 70, true, false);
+   tfzassert(pTest, bvResize(bv, 130), success, false);
+   tfzassert(pTest, bvPopCount(bv) == 70, true, false);
+   tfzassert(pTest, bvTest(bv, 70), false, false);
+
+   // Reserve and shrink keep the bits.
+   tfzassert(pTest, bvReserve(bv, 100000), success, false);
+   bvShrink(bv);
+   tfzassert(pTest, bvPopCount(bv) == 70, true, false);
+
+   // Success.
+   bvdestroy(&bv);
+   return tfzassert_ptr(pTest, bv, null, false);
+}
+
+// Tests bulk operations against a bit at a time.
+bool testOps(TFSuite pTest)
+{
+   bitvector a = bvcreate();
+   bitvector b = bvcreate();
+   bitvector c = bvcreate();
+   if (false == tfzassert(pTest, a && b && c, true, false)) {
+      bvdestroy(&a);
+      bvdestroy(&b);
+      bvdestroy(&c);
+      return false;
+   }
+
+   // a is 1000 bits, b is shorter (700).
+   uint64_t seed = 12345;
+   bvResize(a, 1000);
+   bvResize(b, 700);
+   for (uint32_t n = 0; n < 1000; ++n) {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      bvAssign(a, n, (seed >> 33) & 1);
+      bvAssign(b, n, (seed >> 34) & 1);
+   }
+
+   // Each op against the expected bit.
+   retcode (*ops[])(bitvector, cbitvector) = { bvAnd, bvOr, bvXor, bvAndNot };
+   for (uint32_t op = 0; op < 4; ++op) {
+      bvResize(c, 0);
+      bvResize(c, 1000);
+      bvOr(c, a);
+      tfzassert(pTest, ops[op](c, b), success, false);
+
+      bool ok = true;
+      for (uint32_t n = 0; n < 1000; ++n) {
+         bool x = bvTest(a, n), y = bvTest(b, n), z = false;
+         switch (op) {
+            case 0: z = x & y; break;
+            case 1: z = x | y; break;
+            case 2: z = x ^ y; break;
+            case 3: z = x & !y; break;
+         }
+         if (bvTest(c, n) != z) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+   }
+
+   // Longer src does not grow dst; same vector on both sides.
+   bvResize(c, 10);
+   bvFill(c, true);
+   bvOr(c, a);
+   tfzassert(pTest, bvGetCount(c) == 10, true, false);
+   tfzassert(pTest, bvPopCount(c) == 10, true, false);
+   bvXor(c, c);
+   tfzassert(pTest, bvPopCount(c) == 0, true, false);
+   tfzassert(pTest, bvAnd(null, a), fail, false);
+
+   // Success.
+   bvdestroy(&a);
+   bvdestroy(&b);
+   bvdestroy(&c);
+   return tfzassert_ptr(pTest, c, null, false);
+}
+
+// Tests popcount, rank, select and find against a bit at a time.
+bool testSearch(TFSuite pTest)
+{
+   bitvector bv = bvcreate();
+   if (false == tfzassert(pTest, bv != null, true, false)) {
+      return false;
+   }
+
+   // Sparse then dense runs over several rank blocks.
+   bvResize(bv, 5000);
+   for (uint32_t n = 0; n < 5000; ++n) {
+      if ((n < 2000 && n % 97 == 5) || (n >= 3000 && n % 3 != 0)) {
+         bvSet(bv, n);
+      }
+   }
+
+   uint64_t ones = 0;
+   bool rankOk = true, selectOk = true;
+   for (uint32_t n = 0; n < 5000; ++n) {
+      if (bvRank(bv, n) != ones) rankOk = false;
+      if (bvTest(bv, n)) {
+         if (bvSelect(bv, ones) != n) selectOk = false;
+         ones++;
+      }
+   }
+   tfzassert(pTest, rankOk, true, false);
+   tfzassert(pTest, selectOk, true, false);
+   tfzassert(pTest, bvPopCount(bv) == ones, true, false);
+   tfzassert(pTest, bvRank(bv, 5000) == ones, true, false);
+   tfzassert(pTest, bvRank(bv, 1000000) == ones, true, false);
+   tfzassert(pTest, bvSelect(bv, ones) == BV_NPOS, true, false);
+
+   // Find walks the same bits as select.
+   uint64_t found = 0;
+   bool findOk = true;
+   for (uint64_t i = bvFindFirst(bv); i != BV_NPOS; i = bvFindNext(bv, i + 1)) {
+      if (bvSelect(bv, found++) != i) findOk = false;
+   }
+   tfzassert(pTest, findOk, true, false);
+   tfzassert(pTest, found == ones, true, false);
+   tfzassert(pTest, bvFindNext(bv, 2000) == 3001, true, false);
+
+   // The index follows changes, including ones made through the words.
+   bvClear(bv, 5);
+   tfzassert(pTest, bvRank(bv, 100) == 0, true, false);
+   tfzassert(pTest, bvSelect(bv, 0) == 102, true, false);
+   uint64_t words = 0;
+   uint64_t* pWords = bvWords(bv, &words);
+   pWords[0] = 1;
+   bvTouch(bv);
+   tfzassert(pTest, bvSelect(bv, 0) == 0, true, false);
+   tfzassert(pTest, bvRank(bv, 150) == 2, true, false);
+
+   // Success.
+   bvdestroy(&bv);
+   return tfzassert_ptr(pTest, bv, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("bitvector tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testBits(tfz);
+   testOps(tfz);
+   testSearch(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
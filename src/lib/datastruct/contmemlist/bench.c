@@ -0,0 +1,453 @@
+/*
+Date: 17 Oct 2026 21:03:47.215830694
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_6A0F3C8E1B5D49274D8B2F6A0E3C7D19__
+Purpose: Benchmarks for contmemlist.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (indexed gets)
+17 Oct 2026 Duncan Camilleri           Sequential scans
+17 Oct 2026 Duncan Camilleri           Growth policies
+17 Oct 2026 Duncan Camilleri           Gathered and batched adds
+17 Oct 2026 Duncan Camilleri           Aligned payloads
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <sys/uio.h>
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+#include <commons.h>
+#include <contmemlist.h>
+
+//
+// MACROS
+//
+
+// Largest power of ten of items benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 6
+// Random gets timed per size (and by walking from the head, O(n) each).
+#define BENCH_GETS                           4000000
+#define BENCH_WALK_GETS                      2000
+// Full scans timed per size.
+#define BENCH_SCANS                          5
+// Records per cmlAddBatch call.
+#define BENCH_BATCH                          1024
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+// Finds item index by walking from the head as cmlGet did before the index.
+memlistitem benchWalk(memlist cml, uint32_t index)
+{
+   memlistitem item = cmlFirst(cml);
+   while (item && index-- > 0) item = cmlNext(cml, item);
+   return item;
+}
+
+// Adds the last byte of an item to the sum in pCtx.
+bool benchVisit(void* pData, uint32_t size, void* pCtx)
+{
+   *(uint64_t*)pCtx += ((uint8_t*)pData)[size - 1];
+   return true;
+}
+
+// Sums the bytes of a payload of a multiple of 16 bytes, 16 bytes at a time
+// (aligned says the payload is 16 byte aligned).
+uint64_t benchSumPayload(const uint8_t* pData, uint32_t size, bool aligned)
+{
+#if defined __SSE2__
+   __m128i zero = _mm_setzero_si128();
+   __m128i sum = zero;
+   for (uint32_t n = 0; n < size; n += 16) {
+      __m128i bytes = (aligned ?
+         _mm_load_si128((const __m128i*)(pData + n)) :
+         _mm_loadu_si128((const __m128i*)(pData + n)));
+      sum = _mm_add_epi64(sum, _mm_sad_epu8(bytes, zero));
+   }
+   return (uint64_t)_mm_cvtsi128_si64(sum) +
+      (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum));
+#else
+   uint64_t sum = 0;
+   for (uint32_t n = 0; n < size; ++n) sum += pData[n];
+   return sum;
+#endif
+}
+
+// Sums the payloads of every item in the list BENCH_SCANS times and returns
+// the payload GB per second (the sum in *pSum).
+double benchSumList(memlist cml, uint64_t bytes, bool aligned, uint64_t* pSum)
+{
+   double start = benchNow();
+   for (uint32_t s = 0; s < BENCH_SCANS; ++s) {
+      for (memlistitem i = cmlFirst(cml); i; i = cmlNext(cml, i)) {
+         *pSum += benchSumPayload(
+            (const uint8_t*)cmlItemData(i), cmlItemSize(i), aligned
+         );
+      }
+   }
+   return BENCH_SCANS * bytes / (benchNow() - start) / 1e9;
+}
+
+// Sums the first byte of count random items found by get.
+uint64_t benchGets(memlist cml, uint64_t items, uint64_t count,
+   memlistitem (*get)(memlist, uint32_t))
+{
+   uint64_t sum = 0, seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count; ++n) {
+      CMLBuffer buf;
+      createCMLBuffer(get(cml, (uint32_t)(benchRandom(&seed) % items)), &buf,
+         false
+      );
+      sum += ((uint8_t*)buf.mpData)[0];
+   }
+   return sum;
+}
+
+//
+// BENCHMARKS
+//
+
+// Fills lists of count items of 8 to 120 bytes with a dense and a sparse
+// index, then times random gets through each index and by walking.
+void benchIndex(uint64_t count)
+{
+   memlist dense = cmlcreate(null, 0, 0);
+   memlist sparse = cmlcreatex(null, 0, 0, cmlfsparseindex);
+   if (!dense || !sparse) {
+      cmldestroy(&dense);
+      cmldestroy(&sparse);
+      return;
+   }
+
+   uint8_t data[128];
+   for (uint64_t n = 0; n < count; ++n) {
+      memset(data, (uint8_t)n, sizeof(data));
+      cmlAdd(&dense, data, 8 + (uint32_t)(n % 113));
+      cmlAdd(&sparse, data, 8 + (uint32_t)(n % 113));
+   }
+
+   // The first get builds the lazy index.
+   double start = benchNow();
+   cmlGet(dense, (uint32_t)(count - 1));
+   double build = benchNow() - start;
+   cmlGet(sparse, (uint32_t)(count - 1));
+
+   uint64_t sums[3];
+   start = benchNow();
+   sums[0] = benchGets(dense, count, BENCH_GETS, cmlGet);
+   double denseRate = BENCH_GETS / (benchNow() - start) / 1e6;
+   start = benchNow();
+   sums[1] = benchGets(sparse, count, BENCH_GETS, cmlGet);
+   double sparseRate = BENCH_GETS / (benchNow() - start) / 1e6;
+   start = benchNow();
+   sums[2] = benchGets(dense, count, BENCH_WALK_GETS, benchWalk);
+   double walkRate = BENCH_WALK_GETS / (benchNow() - start) / 1e6;
+
+   printf("%10" PRIu64 " %10.2f %10.2f %10.2f %10.4f %" PRIu64 " %s\n", count,
+      build * 1e3, denseRate, sparseRate, walkRate, sums[2] & 1,
+      (sums[0] == sums[1] ? "" : "(mismatch!)")
+   );
+
+   cmldestroy(&dense);
+   cmldestroy(&sparse);
+}
+
+// Times full scans of count items of 8 to 120 bytes: reading the raw layout
+// (a uint32_t size followed by the data) without prefetching, with the
+// cursors, with cmlForEach and with indexed gets.
+void benchScan(uint64_t count)
+{
+   memlist cml = cmlcreate(null, 0, 0);
+   if (!cml) return;
+
+   uint8_t data[128];
+   for (uint64_t n = 0; n < count; ++n) {
+      memset(data, (uint8_t)n, sizeof(data));
+      cmlAdd(&cml, data, 8 + (uint32_t)(n % 113));
+   }
+   cmlGet(cml, (uint32_t)(count - 1));
+
+   uint64_t sums[4] = { 0, 0, 0, 0 };
+   double rates[4];
+   double start = benchNow();
+   for (uint32_t s = 0; s < BENCH_SCANS; ++s) {
+      uint8_t* p = (uint8_t*)cmlGet(cml, 0);
+      for (uint64_t n = 0; n < count; ++n) {
+         uint32_t size;
+         memcpy(&size, p, sizeof(uint32_t));
+         sums[0] += p[sizeof(uint32_t) + size - 1];
+         p += sizeof(uint32_t) + size;
+      }
+   }
+   rates[0] = BENCH_SCANS * count / (benchNow() - start) / 1e6;
+
+   start = benchNow();
+   for (uint32_t s = 0; s < BENCH_SCANS; ++s) {
+      for (memlistitem i = cmlFirst(cml); i; i = cmlNext(cml, i)) {
+         sums[1] += ((uint8_t*)cmlItemData(i))[cmlItemSize(i) - 1];
+      }
+   }
+   rates[1] = BENCH_SCANS * count / (benchNow() - start) / 1e6;
+
+   start = benchNow();
+   for (uint32_t s = 0; s < BENCH_SCANS; ++s) {
+      cmlForEach(cml, benchVisit, &sums[2]);
+   }
+   rates[2] = BENCH_SCANS * count / (benchNow() - start) / 1e6;
+
+   start = benchNow();
+   for (uint32_t s = 0; s < BENCH_SCANS; ++s) {
+      for (uint64_t n = 0; n < count; ++n) {
+         memlistitem i = cmlGet(cml, (uint32_t)n);
+         sums[3] += ((uint8_t*)cmlItemData(i))[cmlItemSize(i) - 1];
+      }
+   }
+   rates[3] = BENCH_SCANS * count / (benchNow() - start) / 1e6;
+
+   bool same = (sums[0] == sums[1] && sums[0] == sums[2] &&
+      sums[0] == sums[3]);
+   printf("%10" PRIu64 " %10.2f %10.2f %10.2f %10.2f %s\n", count, rates[0],
+      rates[1], rates[2], rates[3], (same ? "" : "(mismatch!)")
+   );
+
+   cmldestroy(&cml);
+}
+
+// Times loading count items of 8 to 120 bytes growing by blocks, doubling,
+// doubling in pages and into a reserved list. Reports ms and allocations.
+void benchGrowth(uint64_t count)
+{
+   uint32_t flags[] = { cmlfnone, cmlfgeometric, cmlfpagegrowth, cmlfnone };
+   printf("%10" PRIu64, count);
+   uint8_t data[128];
+   memset(data, 0x5A, sizeof(data));
+   uint64_t bytes = 0;
+   for (uint64_t n = 0; n < count; ++n) bytes += 8 + n % 113;
+   for (uint32_t f = 0; f < 4; ++f) {
+      double start = benchNow();
+      memlist cml = cmlcreatex(null, 0, 0, flags[f]);
+      if (!cml) return;
+      if (f == 3) cmlReserve(&cml, bytes, count);
+      for (uint64_t n = 0; n < count; ++n) {
+         cmlAdd(&cml, data, 8 + (uint32_t)(n % 113));
+      }
+      double ms = (benchNow() - start) * 1e3;
+      printf(" %10.2f %6" PRIu32, ms, cmlGetAllocCount(cml));
+      cmldestroy(&cml);
+   }
+   printf("\n");
+}
+
+// Times adding count records made of a 16 byte header, an 8 byte key and an
+// 8 to 120 byte payload (all lists grow by blocks):
+//    staged   : fragments copied into a buffer, then cmlAdd
+//    addv     : fragments gathered by cmlAddv
+//    add      : whole records added one at a time with cmlAdd
+//    batch    : the same records added BENCH_BATCH at a time
+// Reports million records per second and the allocations of add and batch.
+void benchIngest(uint64_t count)
+{
+   uint8_t header[16], key[8], payload[128], staged[152];
+   memset(header, 0x11, sizeof(header));
+   memset(key, 0x22, sizeof(key));
+   memset(payload, 0x33, sizeof(payload));
+
+   // The records back to back for add and batch.
+   uint64_t bytes = 0;
+   for (uint64_t n = 0; n < count; ++n) bytes += 24 + 8 + n % 113;
+   uint8_t* pRecords = (uint8_t*)malloc(bytes);
+   uint32_t* pSizes = (uint32_t*)malloc(count * sizeof(uint32_t));
+   if (!pRecords || !pSizes) {
+      free(pRecords);
+      free(pSizes);
+      return;
+   }
+   uint8_t* pRecord = pRecords;
+   for (uint64_t n = 0; n < count; ++n) {
+      pSizes[n] = 24 + 8 + (uint32_t)(n % 113);
+      memcpy(pRecord, header, 16);
+      memcpy(pRecord + 16, key, 8);
+      memcpy(pRecord + 24, payload, pSizes[n] - 24);
+      pRecord += pSizes[n];
+   }
+
+   double rates[4];
+   uint32_t allocs[4];
+   uint64_t counts[4];
+   for (uint32_t mode = 0; mode < 4; ++mode) {
+      memlist cml = cmlcreate(null, 0, 0);
+      if (!cml) break;
+      double start = benchNow();
+      pRecord = pRecords;
+      for (uint64_t n = 0; n < count; ) {
+         uint32_t size = pSizes[n];
+         if (mode == 0) {
+            memcpy(staged, header, 16);
+            memcpy(staged + 16, key, 8);
+            memcpy(staged + 24, payload, size - 24);
+            cmlAdd(&cml, staged, size);
+            n++;
+         } else if (mode == 1) {
+            struct iovec iov[] = {
+               { header, 16 }, { key, 8 }, { payload, size - 24 }
+            };
+            cmlAddv(&cml, iov, 3);
+            n++;
+         } else if (mode == 2) {
+            cmlAdd(&cml, pRecord, size);
+            pRecord += size;
+            n++;
+         } else {
+            uint64_t batch = count - n;
+            if (batch > BENCH_BATCH) batch = BENCH_BATCH;
+            cmlAddBatch(&cml, pRecord, pSizes + n, batch);
+            for (uint64_t b = 0; b < batch; ++b) pRecord += pSizes[n++];
+         }
+      }
+      rates[mode] = count / (benchNow() - start) / 1e6;
+      allocs[mode] = cmlGetAllocCount(cml);
+      counts[mode] = cmlGetCount(cml);
+      cmldestroy(&cml);
+   }
+
+   bool same = (counts[0] == count && counts[1] == count &&
+      counts[2] == count && counts[3] == count);
+   printf("%10" PRIu64 " %10.2f %10.2f %10.2f %10.2f %10" PRIu32 " %10"
+      PRIu32 " %s\n", count, rates[0], rates[1], rates[2], rates[3],
+      allocs[2], allocs[3], (same ? "" : "(mismatch!)")
+   );
+
+   free(pRecords);
+   free(pSizes);
+}
+
+// Fills a packed, a 16 and a 64 byte aligned list with count payloads of 16
+// to 128 bytes and sums the payloads with SIMD loads. Reports the padding as
+// a percentage of the payload bytes, then payload GB per second: packed
+// (unaligned loads), 16 aligned with unaligned and aligned loads and 64
+// aligned.
+void benchAlign(uint64_t count)
+{
+   uint32_t flags[] = { cmlfnone, cmlfalign16, cmlfalign64 };
+   memlist lists[3];
+   uint8_t data[128];
+   uint64_t bytes = 0;
+   for (uint32_t f = 0; f < 3; ++f) {
+      lists[f] = cmlcreatex(null, 0, 0, flags[f] | cmlfgeometric);
+      if (!lists[f]) {
+         while (f > 0) cmldestroy(&lists[--f]);
+         return;
+      }
+   }
+   for (uint64_t n = 0; n < count; ++n) {
+      uint32_t size = 16 * (1 + (uint32_t)(n % 8));
+      memset(data, (uint8_t)n, sizeof(data));
+      for (uint32_t f = 0; f < 3; ++f) cmlAdd(&lists[f], data, size);
+      bytes += size;
+   }
+
+   uint64_t sums[4] = { 0, 0, 0, 0 };
+   double rates[4];
+   rates[0] = benchSumList(lists[0], bytes, false, &sums[0]);
+   rates[1] = benchSumList(lists[1], bytes, false, &sums[1]);
+   rates[2] = benchSumList(lists[1], bytes, true, &sums[2]);
+   rates[3] = benchSumList(lists[2], bytes, true, &sums[3]);
+
+   bool same = (sums[0] == sums[1] && sums[0] == sums[2] &&
+      sums[0] == sums[3]);
+   printf("%10" PRIu64 " %8.1f%% %8.1f%% %10.2f %10.2f %10.2f %10.2f %s\n",
+      count, 100.0 * cmlGetPadding(lists[1]) / bytes,
+      100.0 * cmlGetPadding(lists[2]) / bytes, rates[0], rates[1], rates[2],
+      rates[3], (same ? "" : "(mismatch!)")
+   );
+
+   for (uint32_t f = 0; f < 3; ++f) cmldestroy(&lists[f]);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 7) maxExp = 7;
+
+   // Index build time (ms), then million random gets per second (the last
+   // column keeps the walk sums alive).
+   printf("%10s %10s %10s %10s %10s\n", "items", "build ms", "dense",
+      "sparse", "walk");
+   uint64_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchIndex(count);
+
+   // Million items per second scanned in order.
+   printf("\n%10s %10s %10s %10s %10s\n", "items", "raw", "cursor",
+      "foreach", "get");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchScan(count);
+
+   // Load time (ms) and buffer allocations for each growth policy.
+   printf("\n%10s %17s %17s %17s %17s\n", "items", "blocks", "geometric",
+      "pages", "reserved");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchGrowth(count);
+
+   // Million records per second added (and allocations made adding them
+   // whole and in batches).
+   printf("\n%10s %10s %10s %10s %10s %10s %10s\n", "records", "staged",
+      "addv", "add", "batch", "add allocs", "bat allocs");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchIngest(count);
+
+   // Padding of 16 and 64 byte aligned lists (% of payload bytes), then
+   // payload GB per second summed with SIMD loads.
+   printf("\n%10s %9s %9s %10s %10s %10s %10s\n", "items", "pad 16",
+      "pad 64", "packed", "a16 loadu", "a16 load", "a64 load");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchAlign(count);
+
+   return 0;
+}
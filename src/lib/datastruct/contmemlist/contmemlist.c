@@ -30,39 +30,73 @@ Purpose: There are times where multiple items of data of varying size need to be
 
 Version control
 27 Nov 2023 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           Item index (O(1) cmlGet), cmlcreatex
+17 Oct 2026 Duncan Camilleri           Cursors and cmlForEach
+17 Oct 2026 Duncan Camilleri           Geometric growth, cmlReserve
+17 Oct 2026 Duncan Camilleri           Gathered and batched adds (cmlAddv/Batch)
+17 Oct 2026 Duncan Camilleri           Aligned payloads (cmlfalign8/16/64)
 */
 
 //
 // INCLUDES
 //
 #include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <memory.h>
 #include <malloc.h>
+#include <unistd.h>
+#include <sys/uio.h>
 
 #include <commons.h>
+#include <vector.h>
 #include <contmemlist.h>
 
 //
 // MACROS
 //
 #define CONTMEMLIST_DEFAULT_BLOCKSIZE              512
+#define CONTMEMLIST_DEFAULT_PAGESIZE               4096
+// Most a geometric list grows by at once (64MB).
+#define CONTMEMLIST_GROWTH_CAP                     0x4000000ull
+// Items per index entry with cmlfsparseindex.
+#define CONTMEMLIST_SPARSE_STRIDE                  16
+// How far ahead of a walk memory is prefetched (a few lines).
+#define CONTMEMLIST_PREFETCH_BYTES                 256
 
 //
 // STRUCTS
 //
 
 // One single item in the list. Yes, it only consists of the size. What follows
-// it is the actual data to that amount in size.
+// it is the actual data to that amount in size. In an aligned list the
+// padding goes in front of the header so that the data starts on an
+// alignment boundary (relative to the start of the list, which is itself
+// aligned); it is found again from the offset where the previous item ended.
 // Oh - CMLI stands for contiguous memory list item.
 typedef struct _CMLI {
    uint32_t mItemSize;                             // size of item
 } CMLI;
 
 // Contiguous memory list represented as a structure.
+// The index holds the offsets (from the start of the list) of items rather
+// than pointers so that it survives the list being moved by realloc. It
+// covers the first mIndexed items: one entry per item, or one per
+// CONTMEMLIST_SPARSE_STRIDE items with cmlfsparseindex. mIndexEnd is the
+// offset just past the last item covered.
 typedef struct _CML {
    uint32_t mBlockSize;                            // size of one alloc block
+   uint32_t mFlags;                                // cmlflags
+   uint32_t mPageSize;                             // page size (cmlfpagegrowth)
+   uint32_t mAllocCount;                           // buffer (re)allocations
+   uint32_t mAlign;                                // payload alignment (or 1)
+   uint64_t mPadding;                              // bytes spent aligning
    uint64_t mTotalSize;                            // size of whole data
    uint64_t mTotalUsed;                            // used amount of bytes
+   uint64_t mItemCount;                            // number of items
+   uint64_t mIndexed;                              // items covered by index
+   uint64_t mIndexEnd;                             // offset past those items
+   cvector mIndex;                                 // uint64_t item offsets
 
    CMLI* mpHead;                                   // pointers to head and tail
    CMLI* mpTail;
@@ -73,6 +107,24 @@ typedef struct _CML {
 // These are merely convenience and readability tools.
 //
 
+// Returns the payload alignment given by the flags (1 if packed).
+uint32_t listAlignment(uint32_t flags)
+{
+   if (flags & cmlfalign64) return 64;
+   if (flags & cmlfalign16) return 16;
+   if (flags & cmlfalign8) return 8;
+   return 1;
+}
+
+// Returns the offset of the header of an item placed after offset end, such
+// that its data is aligned (end itself in a packed list).
+// Never pass null. This is an internal function.
+uint64_t listItemOffset(const CML* pCML, uint64_t end)
+{
+   uint64_t mask = (uint64_t)pCML->mAlign - 1;
+   return ((end + sizeof(CMLI) + mask) & ~mask) - sizeof(CMLI);
+}
+
 // Returns a pointer to the first item in the list.
 // Never pass null. This is an internal function.
 void* listToFirstItem(memlist ml)
@@ -80,30 +132,38 @@ void* listToFirstItem(memlist ml)
    CML* pCML = (CML*)ml;
    
    // No item?
-   if (pCML->mTotalSize == sizeof(CML)) {
+   if (pCML->mItemCount == 0) {
       return nul;
    }
 
    // Get first valid item.
    void* pFirst = (void*)ml;
-   return pFirst + sizeof(CML);
+   return pFirst + listItemOffset(pCML, sizeof(CML));
 }
 
 // Returns a pointer to the list item data buffer from a public memlist item.
 // Never pass null. This is an internal function.
 void* listItemToData(memlistitem mli)
 {
-   CMLI* pCMLI = (CMLI*)mli;
    void* pData = (void*)mli;
-   return pData + pCMLI->mItemSize;
+   return pData + sizeof(CMLI);
+}
+
+// Returns the size of the item data. Items are packed so the header may not
+// be aligned; it is always copied rather than read in place.
+// Never pass null. This is an internal function.
+uint32_t listItemDataSize(memlistitem mli)
+{
+   CMLI item;
+   memcpy(&item, mli, sizeof(CMLI));
+   return item.mItemSize;
 }
 
 // Returns the total list item size (including the header).
 // Never pass null. This is an internal function.
 uint32_t listItemSize(memlistitem mli)
 {
-   CMLI* pCMLI = (CMLI*)mli;
-   return sizeof(CMLI) + pCMLI->mItemSize;
+   return sizeof(CMLI) + listItemDataSize(mli);
 }
 
 // Returns next item from item.
@@ -113,7 +173,161 @@ memlistitem fromItemToNext(memlist ml, memlistitem mli)
    CML* pCML = (CML*)ml;
    if (mli >= (memlistitem)pCML->mpTail) return nul;
 
-   return mli + listItemSize(mli);
+   uint64_t end = (uint64_t)(mli - ml) + listItemSize(mli);
+   return ml + listItemOffset(pCML, end);
+}
+
+// Prefetches the memory CONTMEMLIST_PREFETCH_BYTES after item (if that is
+// still within the items) so a walk does not wait on it later.
+// Never pass null. This is an internal function.
+void listPrefetch(memlist ml, memlistitem mli)
+{
+   CML* pCML = (CML*)ml;
+   void* pAhead = mli + CONTMEMLIST_PREFETCH_BYTES;
+   if (pAhead < (void*)pCML + pCML->mTotalUsed) __builtin_prefetch(pAhead);
+}
+
+// Returns size rounded up to whole units.
+uint64_t listRoundUp(uint64_t size, uint64_t unit)
+{
+   return ((size + unit - 1) / unit) * unit;
+}
+
+// Returns the total size a list should grow to so that at least sizeNeeded
+// bytes fit. This is where the growth policy is applied: by default the list
+// grows by whole blocks; a geometric list doubles (growing by at most
+// CONTMEMLIST_GROWTH_CAP at once) and with cmlfpagegrowth whole pages are
+// allocated instead of blocks. When exact is true (reservations) the list
+// does not grow beyond sizeNeeded other than to round it.
+// Never pass null. This is an internal function.
+uint64_t listGrowthTarget(const CML* p, uint64_t sizeNeeded, bool exact)
+{
+   uint64_t target = sizeNeeded;
+   if (!exact && (p->mFlags & (cmlfgeometric | cmlfpagegrowth))) {
+      uint64_t step = p->mTotalSize;
+      if (step > CONTMEMLIST_GROWTH_CAP) step = CONTMEMLIST_GROWTH_CAP;
+      if (target < p->mTotalSize + step) target = p->mTotalSize + step;
+   }
+
+   return listRoundUp(target,
+      (p->mFlags & cmlfpagegrowth) ? p->mPageSize : p->mBlockSize);
+}
+
+// Reallocates the list to newSize bytes. *ppList is updated if the list
+// moves. Returns fail if memory ran out (the list is left as it was).
+// Never pass null. This is an internal function.
+retcode listResize(memlist* ppList, uint64_t newSize)
+{
+   CML* p = (CML*)*ppList;
+
+   // Try to reallocate larger needed buffer. realloc() only keeps the
+   // alignment of malloc() so a list aligned beyond that is moved by hand.
+   uint64_t tailOffset = (p->mpTail ? (void*)p->mpTail - (void*)p : 0);
+   void* pNew = nul;
+   if (p->mAlign > _Alignof(max_align_t)) {
+      if (0 != posix_memalign(&pNew, p->mAlign, newSize)) {
+         return fail;
+      }
+      memcpy(pNew, (void*)p, p->mTotalUsed);
+      free((void*)p);
+   } else {
+      pNew = realloc((void*)p, newSize);
+      if (!pNew) {
+         return fail;
+      }
+   }
+
+   // Update input pointer to new structure.
+   *ppList = (memlist)pNew;
+   p = (CML*)pNew;
+
+   // Update size in header data.
+   p->mTotalSize = newSize;
+   p->mAllocCount++;
+
+   // Correct any header pointers (we only store head and tail).
+   if (p->mItemCount > 0) {
+      p->mpHead = (CMLI*)listToFirstItem((memlist)p);
+      p->mpTail = (CMLI*)((void*)p + tailOffset);
+   }
+
+   return success;
+}
+
+// Makes sure sizeNeeded more bytes fit in the list, growing it as its growth
+// policy dictates if needed. *ppList is updated if the list moves. Returns
+// fail if memory ran out.
+// Never pass null. This is an internal function.
+retcode listEnsure(memlist* ppList, uint64_t sizeNeeded)
+{
+   CML* p = (CML*)*ppList;
+   if (p->mTotalSize - p->mTotalUsed >= sizeNeeded) return success;
+
+   uint64_t target = listGrowthTarget(p, p->mTotalUsed + sizeNeeded, false);
+   return listResize(ppList, target);
+}
+
+// Returns the bytes an item of size bytes takes up (padding included) when
+// added to the list as it is now.
+// Never pass null. This is an internal function.
+uint64_t listAppendSize(const CML* p, uint32_t size)
+{
+   return listItemOffset(p, p->mTotalUsed) - p->mTotalUsed +
+      sizeof(CMLI) + (uint64_t)size;
+}
+
+// Appends an item of size bytes (header only; the data is left to the
+// caller) where there is already room for it. Returns the new item.
+// Never pass null. This is an internal function.
+CMLI* listPlace(CML* p, uint32_t size)
+{
+   uint64_t offset = listItemOffset(p, p->mTotalUsed);
+   p->mPadding += offset - p->mTotalUsed;
+   CMLI* pItem = (CMLI*)((void*)p + offset);
+   CMLI item = { size };
+   memcpy(pItem, &item, sizeof(CMLI));
+   p->mTotalUsed = offset + sizeof(CMLI) + (uint64_t)size;
+   p->mItemCount++;
+   p->mpTail = pItem;
+   if (!p->mpHead) p->mpHead = pItem;
+   return pItem;
+}
+
+// Appends an item of size bytes (header only; the data is left to the
+// caller), growing the list if needed. *ppList is updated if the list moves.
+// Returns the new item or nul if memory ran out.
+// Never pass null. This is an internal function.
+CMLI* listAppend(memlist* ppList, uint32_t size)
+{
+   CML* p = (CML*)*ppList;
+   if (fail == listEnsure(ppList, listAppendSize(p, size))) return nul;
+   return listPlace((CML*)*ppList, size);
+}
+
+// Extends the index to cover item index, walking from the last item it
+// covers. Returns false if the index could not grow.
+// Never pass null. This is an internal function.
+bool listIndexTo(CML* pCML, uint64_t index)
+{
+   uint64_t stride = (pCML->mFlags & cmlfsparseindex) ?
+      CONTMEMLIST_SPARSE_STRIDE : 1;
+   if (!pCML->mIndex) {
+      pCML->mIndex = cvcreate(sizeof(uint64_t));
+      if (!pCML->mIndex) return false;
+      pCML->mIndexEnd = sizeof(CML);
+   }
+
+   // Walk the items not covered yet.
+   while (pCML->mIndexed <= index) {
+      uint64_t offset = listItemOffset(pCML, pCML->mIndexEnd);
+      if (pCML->mIndexed % stride == 0) {
+         if (!cvPushBack(pCML->mIndex, &offset)) return false;
+      }
+      pCML->mIndexEnd = offset + listItemSize((void*)pCML + offset);
+      pCML->mIndexed++;
+   }
+
+   return true;
 }
 
 //
@@ -125,47 +339,67 @@ memlistitem fromItemToNext(memlist ml, memlistitem mli)
 //    pData          : data being added to the list (can be null)
 //    size           : size of data added (0 if null)
 //    blocksize      : size of each allocation block (0 defaults to 512)
+// The list grows by whole blocks (see cmlcreatex for geometric growth).
 memlist cmlcreate(void* pData, uint32_t size, uint32_t blocksize)
+{
+   return cmlcreatex(pData, size, blocksize, cmlfnone);
+}
+
+// Create a new CML with cmlflags (see cmlcreate).
+memlist cmlcreatex(void* pData, uint32_t size, uint32_t blocksize,
+   uint32_t flags)
 {
    // Validation.
    if (0 == blocksize) blocksize = CONTMEMLIST_DEFAULT_BLOCKSIZE;
    if (nul == pData && size > 0) return nul;
    if (pData && size == 0) return nul;
+   uint32_t alignFlags = flags & (cmlfalign8 | cmlfalign16 | cmlfalign64);
+   if (alignFlags & (alignFlags - 1)) return nul;
+   uint32_t align = listAlignment(flags);
 
    // Get buffer space needed.
-   uint32_t sizeNeeded = sizeof(CML);
+   uint64_t sizeNeeded = sizeof(CML);
    if (size > 0) {
-      sizeNeeded +=  sizeof(CMLI) + size;
+      sizeNeeded +=  (align - 1) + sizeof(CMLI) + size;
    }
 
-   // Find out the total number of blocks that need to be allocated.
-   uint32_t allocsize = blocksize;
-   while (sizeNeeded > allocsize) {
-      allocsize += blocksize;
+   // Find out the total number of blocks (or pages) to be allocated.
+   uint32_t pageSize = 0;
+   if (flags & cmlfpagegrowth) {
+      long sysPageSize = sysconf(_SC_PAGESIZE);
+      pageSize = (sysPageSize > 0 ?
+         (uint32_t)sysPageSize : CONTMEMLIST_DEFAULT_PAGESIZE);
    }
+   uint64_t allocsize = listRoundUp(sizeNeeded,
+      (flags & cmlfpagegrowth) ? pageSize : blocksize);
 
    // Alloc!
-   void* p = malloc(allocsize);
-   if (!p) return nul;
+   void* p = nul;
+   if (align > _Alignof(max_align_t)) {
+      if (0 != posix_memalign(&p, align, allocsize)) return nul;
+   } else {
+      p = malloc(allocsize);
+      if (!p) return nul;
+   }
    memset(p, 0, allocsize);
 
    // Initialize.
    CML* pCML = (CML*)p;
    pCML->mBlockSize = blocksize;
+   pCML->mFlags = flags;
+   pCML->mPageSize = pageSize;
+   pCML->mAllocCount = 1;
+   pCML->mAlign = align;
    pCML->mTotalSize = allocsize;
-   pCML->mTotalUsed = sizeNeeded;
-   if (size == 0) {
-      // No input data.
-      pCML->mpHead = pCML->mpTail = 0;
-   } else {
-      // Input data available.
-      pCML->mpHead = listToFirstItem((memlist)pCML);
-      pCML->mpTail = pCML->mpHead;
-
-      // Populate data to structure.
-      void* payload = listItemToData(pCML->mpHead);
-      memcpy(payload, pData, size);
-      pCML->mpHead->mItemSize = size;
+   pCML->mTotalUsed = sizeof(CML);
+   pCML->mpHead = pCML->mpTail = 0;
+
+   // Input data available?
+   if (size > 0) {
+      memlist ml = (memlist)pCML;
+      CMLI* pItem = listAppend(&ml, size);
+      memcpy(listItemToData(pItem), pData, size);
+      if (flags & cmlfeagerindex) listIndexTo(pCML, 0);
    }
 
    // Done.
@@ -177,6 +411,9 @@ void cmldestroy(memlist* pp)
 {
    if (nul == pp || nul == *pp) return;
 
+   CML* pCML = (CML*)*pp;
+   cvdestroy(&pCML->mIndex);
+
    free(*pp);
    *pp = 0;
 }
@@ -192,79 +429,204 @@ memlistitem cmlAdd(memlist* ppList, void* pData, uint32_t size)
 {
    // Validation.
    if (nul == pData || size == 0 || !ppList || !*ppList) return nul;
+
+   // Append and fill the new item.
+   CMLI* pItem = listAppend(ppList, size);
+   if (!pItem) return nul;
+   memcpy(listItemToData((memlistitem)pItem), pData, size);
+
+   // An eager index follows every item (if it cannot grow it catches up on
+   // the next cmlGet).
    CML* p = (CML*)*ppList;
+   if (p->mFlags & cmlfeagerindex) listIndexTo(p, p->mItemCount - 1);
 
-   // Get buffer space needed.
-   uint32_t sizeNeeded = sizeof(CMLI) + size;
-   uint32_t sizeAvail = p->mTotalSize - p->mTotalUsed;
-   uint32_t allocsize = 0;
-   while (sizeAvail + allocsize < sizeNeeded) {
-      allocsize += p->mBlockSize;
-   }
+   // Done!
+   return (memlistitem)pItem;
+}
 
-   // Realloc buffer?
-   if (0 < allocsize) {
-      // Try to reallocate larger needed buffer.
-      void* pNew = realloc((void*)p, p->mTotalSize + allocsize);
-      if (!pNew) {
-         return nul;
-      }
+// Adds a new item gathered from count fragments (as writev() would write
+// them) and returns it. Fragments may be empty but the item may not.
+// Returns nul if parameters invalid or on failure.
+// Note: Calling cmlAddv may invalidate any external CMLBuffers.
+memlistitem cmlAddv(memlist* ppList, const struct iovec* pIov, uint32_t count)
+{
+   // Validation.
+   if (!ppList || !*ppList || (!pIov && count > 0)) return nul;
+   uint64_t size = 0;
+   for (uint32_t n = 0; n < count; ++n) {
+      if (!pIov[n].iov_base && pIov[n].iov_len > 0) return nul;
+      size += pIov[n].iov_len;
+   }
+   if (size == 0 || size > UINT32_MAX) return nul;
+
+   // Append and copy each fragment straight into the new item.
+   CMLI* pItem = listAppend(ppList, (uint32_t)size);
+   if (!pItem) return nul;
+   uint8_t* pDest = (uint8_t*)listItemToData((memlistitem)pItem);
+   for (uint32_t n = 0; n < count; ++n) {
+      if (pIov[n].iov_len == 0) continue;
+      memcpy(pDest, pIov[n].iov_base, pIov[n].iov_len);
+      pDest += pIov[n].iov_len;
+   }
 
-      // Update input pointer to new structure.
-      *ppList = (memlist)pNew;
-      p = (CML*)pNew;
+   CML* p = (CML*)*ppList;
+   if (p->mFlags & cmlfeagerindex) listIndexTo(p, p->mItemCount - 1);
 
-      // Update size in header data.
-      p->mTotalSize += allocsize;
+   // Done!
+   return (memlistitem)pItem;
+}
 
-      // Correct any header pointers (we only store head and tail).
-      void* pNewHead = listToFirstItem((memlist)p);
-      uint32_t tailToHead = ((void*)p->mpTail) - ((void*)p->mpHead);
-      p->mpHead = (CMLI*)pNewHead;
-      p->mpTail = (CMLI*)(pNewHead + tailToHead);
+// Adds count items stored back to back in pData, item n being pSizes[n]
+// bytes long. Room for all of them is made at once so the list grows at
+// most once. Either all items are added or (on failure) none.
+// Note: Calling cmlAddBatch may invalidate any external CMLBuffers.
+retcode cmlAddBatch(memlist* ppList, const void* pData,
+   const uint32_t* pSizes, uint64_t count)
+{
+   // Validation.
+   if (!ppList || !*ppList || (!pSizes && count > 0)) return fail;
+   if (count == 0) return success;
+   if (!pData) return fail;
+   CML* p = (CML*)*ppList;
+   uint64_t end = p->mTotalUsed;
+   for (uint64_t n = 0; n < count; ++n) {
+      if (pSizes[n] == 0) return fail;
+      end = listItemOffset(p, end) + sizeof(CMLI) + (uint64_t)pSizes[n];
    }
-
-   // Ok we have enough buffer data now. All we do is append to end.
-   if (!p->mpHead) {
-      // No previous head?
-      p->mpHead = (CMLI*)listToFirstItem((memlist)p);
-      p->mpTail = p->mpHead;
+   uint64_t sizeNeeded = end - p->mTotalUsed;
+
+   // One capacity check, then place every item.
+   if (fail == listEnsure(ppList, sizeNeeded)) return fail;
+   p = (CML*)*ppList;
+   const uint8_t* pSrc = (const uint8_t*)pData;
+   for (uint64_t n = 0; n < count; ++n) {
+      CMLI* pItem = listPlace(p, pSizes[n]);
+      memcpy(listItemToData((memlistitem)pItem), pSrc, pSizes[n]);
+      pSrc += pSizes[n];
    }
 
-   // Position tail to new item.
-   uint32_t currentTailSize = listItemSize((void*)p->mpTail);
-   p->mpTail = ((void*)p->mpTail) + currentTailSize;
-   p->mpTail->mItemSize = size;
-   memcpy(listItemToData((memlistitem)p->mpTail), pData, size);
+   if (p->mFlags & cmlfeagerindex) listIndexTo(p, p->mItemCount - 1);
+   return success;
+}
 
-   // Done!
-   return (memlistitem)p->mpTail;
+// Returns the number of items in the list.
+uint64_t cmlGetCount(memlist pList)
+{
+   if (!pList) return 0;
+   return ((CML*)pList)->mItemCount;
 }
 
-// Locates item at a particular index in the list.
+// Returns the bytes of padding spent aligning the items (0 if packed).
+uint64_t cmlGetPadding(memlist pList)
+{
+   if (!pList) return 0;
+   return ((CML*)pList)->mPadding;
+}
+
+// Returns the number of times the list buffer was allocated (including its
+// creation).
+uint32_t cmlGetAllocCount(memlist pList)
+{
+   if (!pList) return 0;
+   return ((CML*)pList)->mAllocCount;
+}
+
+// Makes room for count more items holding bytes of data between them so
+// that adding them does not reallocate the list. The list is grown exactly
+// to what is needed (rounded to its blocks or pages). *ppList is updated if
+// the list moves. Any non persistent CMLBuffers may become invalid.
+retcode cmlReserve(memlist* ppList, uint64_t bytes, uint64_t count)
+{
+   if (!ppList || !*ppList) return fail;
+
+   CML* p = (CML*)*ppList;
+   uint64_t sizeNeeded = p->mTotalUsed + bytes +
+      count * (sizeof(CMLI) + p->mAlign - 1);
+   if (sizeNeeded <= p->mTotalSize) return success;
+   return listResize(ppList, listGrowthTarget(p, sizeNeeded, true));
+}
+
+// Locates item at a particular index in the list. The index is extended as
+// far as index if it does not cover it yet, so a get costs O(1) (or a walk of
+// under CONTMEMLIST_SPARSE_STRIDE items with cmlfsparseindex).
 memlistitem cmlGet(memlist pList, uint32_t index)
 {
-   if (!pList || !((CML*)pList)->mpHead) return nul;
+   CML* pCML = (CML*)pList;
+   if (!pCML || index >= pCML->mItemCount) return nul;
+
+   // Make sure the index covers the item.
+   if (index >= pCML->mIndexed && !listIndexTo(pCML, index)) return nul;
+
+   // Find the closest indexed item and walk from it.
+   const uint64_t* pOffsets = (const uint64_t*)cvData(pCML->mIndex);
+   if (pCML->mFlags & cmlfsparseindex) {
+      memlistitem item = (void*)pCML +
+         pOffsets[index / CONTMEMLIST_SPARSE_STRIDE];
+      for (uint32_t n = index % CONTMEMLIST_SPARSE_STRIDE; n > 0; --n) {
+         item = fromItemToNext(pCML, item);
+      }
+      return item;
+   }
+   return (void*)pCML + pOffsets[index];
+}
+
+//
+// Cursors.
+//
+
+// Returns the first item (nul if the list is empty).
+memlistitem cmlFirst(memlist pList)
+{
+   if (!pList) return nul;
 
-   // Get first item.
-   uint32_t n = 0;
    memlistitem item = listToFirstItem(pList);
-   if (nul == item) return nul;
+   if (item) listPrefetch(pList, item);
+   return item;
+}
 
-   // Keep getting until index found or reached max utilized memory.
-   while (n < index && item) {
-      // Find next item.
-      if (n == index) {
-         return item;
-      }
+// Returns the item after item (nul after the last one).
+memlistitem cmlNext(memlist pList, memlistitem item)
+{
+   if (!pList || !item) return nul;
+
+   item = fromItemToNext(pList, item);
+   if (item) listPrefetch(pList, item);
+   return item;
+}
 
-      // Next item.
-      item = fromItemToNext(pList, item);
-      ++n;
+// Returns the data of item.
+void* cmlItemData(memlistitem item)
+{
+   if (!item) return nul;
+   return listItemToData(item);
+}
+
+// Returns the size of the data of item.
+uint32_t cmlItemSize(memlistitem item)
+{
+   if (!item) return 0;
+   return listItemDataSize(item);
+}
+
+// Calls visit for every item in order until it returns false. Returns the
+// number of items visited.
+uint64_t cmlForEach(memlist pList, cmlvisitor visit, void* pCtx)
+{
+   if (!pList || !visit) return 0;
+
+   uint64_t visited = 0;
+   CML* pCML = (CML*)pList;
+   memlistitem item = listToFirstItem(pList);
+   for (uint64_t n = 0; n < pCML->mItemCount; ++n) {
+      listPrefetch(pList, item);
+      uint32_t size = listItemDataSize(item);
+      visited++;
+      if (!visit(listItemToData(item), size, pCtx)) break;
+      uint64_t end = (uint64_t)(item - pList) + sizeof(CMLI) + size;
+      item = pList + listItemOffset(pCML, end);
    }
 
-   // Not found!
-   return nul;
+   return visited;
 }
 
 //
@@ -281,13 +643,12 @@ bool createCMLBuffer(memlistitem item, CMLBuffer* pBuffer, bool persist)
 {
    // Ident item.
    if (!item || !pBuffer) return false;
-   CMLI* pItem = (CMLI*)item;
 
    // Fill buffer.
    pBuffer->mPersist = persist;
-   pBuffer->mSize = pItem->mItemSize;
+   pBuffer->mSize = listItemDataSize(item);
    if (persist) {
-      pBuffer->mpData = malloc(pItem->mItemSize);
+      pBuffer->mpData = malloc(pBuffer->mSize);
       if (!pBuffer->mpData) return false;
 
       memcpy(pBuffer->mpData, listItemToData(item), pBuffer->mSize);
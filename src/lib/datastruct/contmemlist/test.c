@@ -27,11 +27,17 @@ Purpose: Tests for contmemlist.c.
 
 Version control
 28 Nov 2023 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           Indexed gets
+17 Oct 2026 Duncan Camilleri           Cursors and cmlForEach
+17 Oct 2026 Duncan Camilleri           Growth policies and reservations
+17 Oct 2026 Duncan Camilleri           Gathered and batched adds
+17 Oct 2026 Duncan Camilleri           Aligned payloads
 */
 
 #include <stdio.h>
 #include <inttypes.h>
 #include <memory.h>
+#include <sys/uio.h>
 #include <commons.h>
 #include <testfaze.h>
 #include <contmemlist.h>
@@ -40,6 +46,20 @@ Version control
 // MACROS
 //
 
+//
+// HELPERS
+//
+
+// Checks item data against its position (counted in pCtx) and stops after
+// 100 items.
+bool visitItem(void* pData, uint32_t size, void* pCtx)
+{
+   uint32_t* pVisited = (uint32_t*)pCtx;
+   if (size != 1 + *pVisited % 61) return false;
+   if (((uint8_t*)pData)[size - 1] != (uint8_t)*pVisited) return false;
+   return (++(*pVisited) < 100);
+}
+
 //
 // TEST CASES
 //
@@ -96,7 +116,7 @@ bool testAdd(TFSuite pTest)
    destroyCMLBuffer(&buf);
 
    // Add another item using cmlAdd.
-   if (!cmlAdd(&cmli, "EFG", 3)) {
+   if (!cmlAdd(&cml, "EFG", 3)) {
       cmldestroy(&cml);
       return false;
    }
@@ -126,6 +146,294 @@ bool testAdd(TFSuite pTest)
    return true;
 }
 
+// Tests indexed gets with each index flag while the list keeps growing.
+bool testIndex(TFSuite pTest)
+{
+   uint32_t flags[] = { cmlfnone, cmlfeagerindex, cmlfsparseindex,
+      cmlfeagerindex | cmlfsparseindex };
+   for (uint32_t f = 0; f < 4; ++f) {
+      memlist cml = cmlcreatex(null, 0, 64, flags[f]);
+      if (false == tfzassert(pTest, cml != null, true, false)) {
+         return false;
+      }
+
+      // Items of 1 to 61 bytes (item n filled with n), read back in a
+      // scattered order after every batch of adds.
+      uint8_t data[64];
+      bool ok = true;
+      uint32_t count = 0;
+      for (uint32_t batch = 0; batch < 5; ++batch) {
+         for (uint32_t n = 0; n < 700; ++n, ++count) {
+            memset(data, (uint8_t)count, sizeof(data));
+            if (!cmlAdd(&cml, data, 1 + count % 61)) ok = false;
+         }
+         for (uint32_t n = 0; n < count; ++n) {
+            uint32_t index = (n * 7919) % count;
+            CMLBuffer buf;
+            if (!createCMLBuffer(cmlGet(cml, index), &buf, false)) {
+               ok = false;
+               break;
+            }
+            if (buf.mSize != 1 + index % 61) ok = false;
+            if (((uint8_t*)buf.mpData)[buf.mSize - 1] != (uint8_t)index) {
+               ok = false;
+            }
+            destroyCMLBuffer(&buf);
+         }
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, cmlGetCount(cml) == count, true, false);
+      tfzassert_ptr(pTest, cmlGet(cml, count), null, false);
+
+      cmldestroy(&cml);
+      tfzassert_ptr(pTest, cml, null, false);
+   }
+
+   // Success.
+   return true;
+}
+
+// Tests walking the items with cursors and cmlForEach.
+bool testCursor(TFSuite pTest)
+{
+   memlist cml = cmlcreate(null, 0, 64);
+   if (false == tfzassert(pTest, cml != null, true, false)) {
+      return false;
+   }
+   tfzassert_ptr(pTest, cmlFirst(cml), null, false);
+   tfzassert(pTest, cmlForEach(cml, visitItem, null) == 0, true, false);
+
+   // Items of 1 to 61 bytes (item n filled with n) walked in order.
+   uint8_t data[64];
+   for (uint32_t n = 0; n < 2000; ++n) {
+      memset(data, (uint8_t)n, sizeof(data));
+      cmlAdd(&cml, data, 1 + n % 61);
+   }
+   bool ok = true;
+   uint32_t count = 0;
+   for (memlistitem i = cmlFirst(cml); i; i = cmlNext(cml, i), ++count) {
+      uint32_t size = cmlItemSize(i);
+      if (size != 1 + count % 61) ok = false;
+      if (((uint8_t*)cmlItemData(i))[size - 1] != (uint8_t)count) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, count == 2000, true, false);
+
+   // The visitor stops the walk after 100 items.
+   uint32_t visited = 0;
+   tfzassert(pTest, cmlForEach(cml, visitItem, &visited) == 100, true, false);
+   tfzassert(pTest, visited == 100, true, false);
+
+   // Success.
+   cmldestroy(&cml);
+   return tfzassert_ptr(pTest, cml, null, false);
+}
+
+// Tests the growth policies and reservations.
+bool testGrowth(TFSuite pTest)
+{
+   uint32_t flags[] = { cmlfnone, cmlfgeometric, cmlfpagegrowth };
+   uint8_t data[128];
+   for (uint32_t f = 0; f < 3; ++f) {
+      memlist cml = cmlcreatex(null, 0, 0, flags[f]);
+      if (false == tfzassert(pTest, cml != null, true, false)) {
+         return false;
+      }
+      tfzassert(pTest, cmlGetAllocCount(cml) == 1, true, false);
+
+      // 20000 items of 1 to 128 bytes (item n filled with n).
+      bool ok = true;
+      for (uint32_t n = 0; n < 20000; ++n) {
+         memset(data, (uint8_t)n, sizeof(data));
+         if (!cmlAdd(&cml, data, 1 + n % 128)) ok = false;
+      }
+      uint32_t count = 0;
+      for (memlistitem i = cmlFirst(cml); i; i = cmlNext(cml, i), ++count) {
+         uint32_t size = cmlItemSize(i);
+         if (size != 1 + count % 128) ok = false;
+         if (((uint8_t*)cmlItemData(i))[size - 1] != (uint8_t)count) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, count == 20000, true, false);
+
+      // About 1.3MB: a block at a time is thousands of reallocations,
+      // doubling is a handful.
+      uint32_t allocs = cmlGetAllocCount(cml);
+      if (flags[f] == cmlfnone) {
+         tfzassert(pTest, allocs > 2000, true, false);
+      } else {
+         tfzassert(pTest, allocs < 20, true, false);
+      }
+
+      // A reservation makes room for the next items exactly.
+      tfzassert(pTest, cmlReserve(&cml, 5000 * 64, 5000), success, false);
+      allocs = cmlGetAllocCount(cml);
+      for (uint32_t n = 0; n < 5000; ++n) cmlAdd(&cml, data, 64);
+      tfzassert(pTest, cmlGetAllocCount(cml) == allocs, true, false);
+      tfzassert(pTest, cmlReserve(&cml, 0, 0), success, false);
+      tfzassert(pTest, cmlGetAllocCount(cml) == allocs, true, false);
+      tfzassert(pTest, cmlGetCount(cml) == 25000, true, false);
+
+      cmldestroy(&cml);
+      tfzassert_ptr(pTest, cml, null, false);
+   }
+
+   // A pre-sized load never reallocates.
+   memlist cml = cmlcreate(null, 0, 0);
+   if (false == tfzassert(pTest, cml != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, cmlReserve(&cml, 100000 * 16, 100000), success, false);
+   tfzassert(pTest, cmlGetAllocCount(cml) == 2, true, false);
+   for (uint32_t n = 0; n < 100000; ++n) cmlAdd(&cml, data, 16);
+   tfzassert(pTest, cmlGetAllocCount(cml) == 2, true, false);
+   tfzassert(pTest, cmlReserve(null, 16, 1), fail, false);
+
+   // Success.
+   cmldestroy(&cml);
+   return tfzassert_ptr(pTest, cml, null, false);
+}
+
+// Tests gathering fragments into items and adding items in batches.
+bool testBatch(TFSuite pTest)
+{
+   memlist cml = cmlcreatex(null, 0, 64, cmlfeagerindex);
+   if (false == tfzassert(pTest, cml != null, true, false)) {
+      return false;
+   }
+
+   // A record gathered from a header, an empty fragment, a key and a payload.
+   char header[] = "hdr:", key[] = "key:", payload[] = "payload";
+   struct iovec iov[] = {
+      { header, 4 }, { nul, 0 }, { key, 4 }, { payload, 7 }
+   };
+   memlistitem item = cmlAddv(&cml, iov, 4);
+   if (false == tfzassert(pTest, item != null, true, false)) {
+      cmldestroy(&cml);
+      return false;
+   }
+   tfzassert(pTest, cmlItemSize(item) == 15, true, false);
+   tfzassert(pTest,
+      memcmp(cmlItemData(item), "hdr:key:payload", 15) == 0, true, false);
+   tfzassert_ptr(pTest, cmlAddv(&cml, iov + 1, 1), null, false);
+   tfzassert_ptr(pTest, cmlAddv(&cml, null, 2), null, false);
+
+   // 1000 items of 1 to 61 bytes (item n filled with n) in one batch.
+   static uint8_t data[64 * 1000];
+   uint32_t sizes[1000];
+   uint64_t offset = 0;
+   for (uint32_t n = 0; n < 1000; ++n) {
+      sizes[n] = 1 + n % 61;
+      memset(data + offset, (uint8_t)n, sizes[n]);
+      offset += sizes[n];
+   }
+   uint32_t allocs = cmlGetAllocCount(cml);
+   tfzassert(pTest, cmlAddBatch(&cml, data, sizes, 1000), success, false);
+   tfzassert(pTest, cmlGetAllocCount(cml) == allocs + 1, true, false);
+   tfzassert(pTest, cmlGetCount(cml) == 1001, true, false);
+   bool ok = true;
+   for (uint32_t n = 0; n < 1000; ++n) {
+      item = cmlGet(cml, n + 1);
+      if (!item || cmlItemSize(item) != sizes[n]) {
+         ok = false;
+         break;
+      }
+      if (((uint8_t*)cmlItemData(item))[sizes[n] - 1] != (uint8_t)n) {
+         ok = false;
+      }
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // An empty item fails the whole batch.
+   sizes[500] = 0;
+   tfzassert(pTest, cmlAddBatch(&cml, data, sizes, 1000), fail, false);
+   tfzassert(pTest, cmlGetCount(cml) == 1001, true, false);
+   tfzassert(pTest, cmlAddBatch(&cml, data, sizes, 0), success, false);
+
+   // Success.
+   cmldestroy(&cml);
+   return tfzassert_ptr(pTest, cml, null, false);
+}
+
+// Tests that aligned lists align the data of every item however it is added
+// and found.
+bool testAlign(TFSuite pTest)
+{
+   tfzassert_ptr(pTest, cmlcreatex(null, 0, 0, cmlfalign8 | cmlfalign64),
+      null, false);
+
+   uint32_t flags[] = { cmlfalign8, cmlfalign16 | cmlfsparseindex,
+      cmlfalign64 | cmlfeagerindex, cmlfalign64 | cmlfgeometric };
+   uint32_t aligns[] = { 8, 16, 64, 64 };
+   static uint8_t data[64 * 300];
+   uint32_t sizes[300];
+   for (uint32_t f = 0; f < 4; ++f) {
+      data[0] = 0;
+      memlist cml = cmlcreatex(data, 1, 64, flags[f]);
+      if (false == tfzassert(pTest, cml != null, true, false)) {
+         return false;
+      }
+
+      // Items of 1 to 61 bytes (item n filled with n) added one at a time,
+      // gathered and in batches, through many reallocations.
+      uint32_t count = 1;
+      bool ok = true;
+      for (uint32_t round = 0; round < 10; ++round) {
+         for (uint32_t n = 0; n < 300; ++n, ++count) {
+            memset(data, (uint8_t)count, 64);
+            if (n % 2) {
+               if (!cmlAdd(&cml, data, 1 + count % 61)) ok = false;
+            } else {
+               struct iovec iov[] = { { data, 1 }, { data, count % 61 } };
+               if (!cmlAddv(&cml, iov, 2)) ok = false;
+            }
+         }
+         uint64_t offset = 0;
+         for (uint32_t n = 0; n < 300; ++n) {
+            sizes[n] = 1 + (count + n) % 61;
+            memset(data + offset, (uint8_t)(count + n), sizes[n]);
+            offset += sizes[n];
+         }
+         if (fail == cmlAddBatch(&cml, data, sizes, 300)) ok = false;
+         count += 300;
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, cmlGetCount(cml) == count, true, false);
+      tfzassert(pTest, cmlGetPadding(cml) > 0, true, false);
+
+      // Walked, visited and got: all aligned and intact.
+      uint32_t n = 0;
+      for (memlistitem i = cmlFirst(cml); i; i = cmlNext(cml, i), ++n) {
+         uint8_t* pData = (uint8_t*)cmlItemData(i);
+         if ((uintptr_t)pData % aligns[f]) ok = false;
+         if (cmlItemSize(i) != 1 + n % 61) ok = false;
+         if (pData[cmlItemSize(i) - 1] != (uint8_t)n) ok = false;
+         if (cmlGet(cml, (n * 7919) % count) == null) ok = false;
+         if (cmlGet(cml, n) != i) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, n == count, true, false);
+      uint32_t visited = 0;
+      cmlForEach(cml, visitItem, &visited);
+      tfzassert(pTest, visited == 100, true, false);
+
+      // Reserving counts the padding of the items too.
+      tfzassert(pTest, cmlReserve(&cml, 1000, 1000), success, false);
+      uint32_t allocs = cmlGetAllocCount(cml);
+      for (n = 0; n < 1000; ++n) cmlAdd(&cml, data, 1);
+      tfzassert(pTest, cmlGetAllocCount(cml) == allocs, true, false);
+      tfzassert(pTest,
+         (uintptr_t)cmlItemData(cmlGet(cml, count + 999)) % aligns[f] == 0,
+         true, false);
+
+      cmldestroy(&cml);
+      tfzassert_ptr(pTest, cml, null, false);
+   }
+
+   // Success.
+   return true;
+}
+
 void runTests()
 {
    // Test suite.
@@ -138,6 +446,11 @@ void runTests()
    // Individual tests.
    testCreate(tfz);
    testAdd(tfz);
+   testIndex(tfz);
+   testCursor(tfz);
+   testGrowth(tfz);
+   testBatch(tfz);
+   testAlign(tfz);
 
    // Show results.
    tfzShowResults(tfz);
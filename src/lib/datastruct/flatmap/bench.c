@@ -0,0 +1,170 @@
+/*
+Date: 17 Oct 2026 18:44:27.421370548
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_7D2B5F91C3E04A6885C1F7B3D0E9A264__
+Purpose: Benchmarks for flatmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (lookups, inserts)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+#include <flatmap.h>
+
+//
+// MACROS
+//
+
+// Largest power of ten benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 7
+// One at a time inserts are only timed up to this many keys.
+#define BENCH_PUT_MAXCOUNT                   100000
+// Lookups timed per size.
+#define BENCH_LOOKUPS                        2000000
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+// Orders 64 bit keys.
+int8_t cmpKey(void* a, void* b)
+{
+   uint64_t x = *(uint64_t*)a, y = *(uint64_t*)b;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+//
+// BENCHMARKS
+//
+
+// Times a bulk load, lookups of present keys and (for smaller sizes) one at
+// a time inserts against keeping a vector sorted with cvInsertAt.
+void benchMap(uint64_t count)
+{
+   uint64_t* pKeys = (uint64_t*)malloc(sizeof(uint64_t) * count);
+   flatmap binary = fmcreate(sizeof(uint64_t), sizeof(uint64_t), cmpKey);
+   flatmap eytz = fmcreatex(sizeof(uint64_t), sizeof(uint64_t), cmpKey,
+      fmfeytzinger, 0);
+   if (!pKeys || !binary || !eytz) {
+      free(pKeys);
+      fmdestroy(&binary);
+      fmdestroy(&eytz);
+      return;
+   }
+
+   uint64_t seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count; ++n) pKeys[n] = benchRandom(&seed);
+
+   // Bulk loads (values are the keys).
+   double start = benchNow();
+   fmPutN(binary, pKeys, pKeys, count);
+   double load = benchNow() - start;
+   fmPutN(eytz, pKeys, pKeys, count);
+
+   // Lookups in random order (the Eytzinger keys are built by the first).
+   uint64_t sums[2] = { 0 };
+   fmGet(eytz, &pKeys[0]);
+   flatmap maps[] = { binary, eytz };
+   double lookups[2];
+   for (uint32_t m = 0; m < 2; ++m) {
+      uint64_t lookupSeed = 7;
+      start = benchNow();
+      for (uint64_t n = 0; n < BENCH_LOOKUPS; ++n) {
+         uint64_t* pKey = &pKeys[benchRandom(&lookupSeed) % count];
+         sums[m] += *(uint64_t*)fmGet(maps[m], pKey);
+      }
+      lookups[m] = BENCH_LOOKUPS / (benchNow() - start) / 1e6;
+   }
+
+   // One at a time: flat map tail against a vector kept sorted.
+   char puts[2][16] = { "-", "-" };
+   if (count <= BENCH_PUT_MAXCOUNT) {
+      flatmap fm = fmcreate(sizeof(uint64_t), sizeof(uint64_t), cmpKey);
+      start = benchNow();
+      for (uint64_t n = 0; n < count; ++n) fmPut(fm, &pKeys[n], &pKeys[n]);
+      fmFlush(fm);
+      snprintf(puts[0], 16, "%.2f", count / (benchNow() - start) / 1e6);
+      fmdestroy(&fm);
+
+      cvector v = cvcreate(sizeof(uint64_t));
+      start = benchNow();
+      for (uint64_t n = 0; n < count; ++n) {
+         cvInsertAt(v, cvLowerBound(v, &pKeys[n], cmpKey), &pKeys[n]);
+      }
+      snprintf(puts[1], 16, "%.2f", count / (benchNow() - start) / 1e6);
+      cvdestroy(&v);
+   }
+
+   printf("%12" PRIu64 " %10.2f %10s %10s %10.2f %10.2f %s\n", count,
+      count / load / 1e6, puts[0], puts[1], lookups[0], lookups[1],
+      (sums[0] == sums[1] ? "" : "(mismatch!)")
+   );
+
+   free(pKeys);
+   fmdestroy(&binary);
+   fmdestroy(&eytz);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 8) maxExp = 8;
+
+   // Million items or operations per second.
+   printf("%12s %10s %10s %10s %10s %10s\n", "keys", "bulk load",
+      "put tail", "put sorted", "get binary", "get eytz");
+   uint64_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchMap(count);
+   }
+
+   return 0;
+}
@@ -0,0 +1,512 @@
+/*
+Date: 17 Oct 2026 18:44:27.374158203
+File: flatmap.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __FLATMAP_C_B81D3F6A0E5C47299D3B6E1A8F0C4D72__
+Purpose: Implements a sorted flat map: keys and values are kept in two
+         vectors in key order and found by binary (or Eytzinger layout)
+         search. New keys are buffered in a small unsorted tail which is
+         merged in once it passes a threshold.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+#include <flatmap.h>
+
+//
+// MACROS
+//
+
+// Keys buffered in the tail unless given at creation.
+#define FLATMAP_DEFAULTTAIL                  64
+// A tail grown past this many times its maximum (by fmPutN) is shrunk.
+#define FLATMAP_TAILSHRINK                   4
+
+//
+// STRUCTS
+//
+
+// mKeys and mValues hold the merged items in key order. mTail holds records
+// of a key followed by its value (at mTailValue) in the order they were put;
+// as the key starts the record, the key comparator orders records too.
+// With fmfeytzinger, mEytzKeys holds the keys in breadth first order from
+// index 1 and mEytzIndex the position of each in mKeys.
+typedef struct _fmap {
+   uint32_t mKeySize;                              // size of a key
+   uint32_t mValueSize;                            // size of a value
+   uint32_t mTailValue;                            // value within a record
+   uint32_t mFlags;                                // fmflags
+   uint32_t mTailMax;                              // records before a merge
+   bool mEytzValid;                                // Eytzinger keys current
+   comparator mCmp;                                // key order
+   cvector mKeys;                                  // keys in order
+   cvector mValues;                                // values in key order
+   cvector mTail;                                  // unsorted records
+   cvector mEytzKeys;                              // keys breadth first
+   cvector mEytzIndex;                             // their index in mKeys
+} fmap;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new flat map with binary search. Initially the map will be empty.
+// No memory is allocated for items unless necessary.
+flatmap fmcreate(uint32_t keySize, uint32_t valueSize, comparator cmp)
+{
+   return fmcreatex(keySize, valueSize, cmp, fmfnone, 0);
+}
+
+// Create a new flat map with fmflags and a tail of tailMax records.
+flatmap fmcreatex(uint32_t keySize, uint32_t valueSize, comparator cmp,
+   uint32_t flags, uint32_t tailMax)
+{
+   if (keySize == 0 || valueSize == 0 || !cmp) return nul;
+
+   fmap* pfm = (fmap*)malloc(sizeof(fmap));
+   if (!pfm) return nul;
+   memset(pfm, 0, sizeof(fmap));
+
+   // Values in tail records start 8 byte aligned.
+   pfm->mKeySize = keySize;
+   pfm->mValueSize = valueSize;
+   pfm->mTailValue = (keySize + 7) & ~7u;
+   pfm->mFlags = flags;
+   pfm->mTailMax = (tailMax ? tailMax : FLATMAP_DEFAULTTAIL);
+   pfm->mCmp = cmp;
+
+   // Create the vectors.
+   bool ok = (nul != (pfm->mKeys = cvcreate(keySize))) &&
+      (nul != (pfm->mValues = cvcreate(valueSize))) &&
+      (nul != (pfm->mTail = cvcreate(pfm->mTailValue + valueSize)));
+   if (ok && (flags & fmfeytzinger)) {
+      ok = (nul != (pfm->mEytzKeys = cvcreate(keySize))) &&
+         (nul != (pfm->mEytzIndex = cvcreate(sizeof(uint64_t))));
+   }
+   if (!ok) {
+      flatmap fm = (flatmap)pfm;
+      fmdestroy(&fm);
+      return nul;
+   }
+
+   // Done.
+   return (flatmap)pfm;
+}
+
+// Destroy existing flat map.
+void fmdestroy(flatmap* pfm)
+{
+   if (nul == pfm) return;
+   if (nul == (*pfm)) return;
+
+   fmap* fm = (fmap*)*pfm;
+   cvdestroy(&fm->mKeys);
+   cvdestroy(&fm->mValues);
+   cvdestroy(&fm->mTail);
+   cvdestroy(&fm->mEytzKeys);
+   cvdestroy(&fm->mEytzIndex);
+
+   free(*pfm);
+   *pfm = 0;
+}
+
+//
+// Private API - Eytzinger layout.
+//
+
+// Copies keys from index onwards to the subtree at node k in order. Returns
+// the index of the next key to copy.
+uint64_t flatEytzFill(fmap* pfm, uint64_t index, uint64_t k, uint64_t count)
+{
+   if (k > count) return index;
+
+   index = flatEytzFill(pfm, index, 2 * k, count);
+   memcpy(cvAt(pfm->mEytzKeys, k), cvAt(pfm->mKeys, index), pfm->mKeySize);
+   ((uint64_t*)cvData(pfm->mEytzIndex))[k] = index;
+   return flatEytzFill(pfm, index + 1, (2 * k) + 1, count);
+}
+
+// Rebuilds the Eytzinger keys from the sorted keys.
+retcode flatEytzBuild(fmap* pfm)
+{
+   if (pfm->mEytzValid) return success;
+
+   uint64_t count = cvCount(pfm->mKeys);
+   cvClear(pfm->mEytzKeys);
+   cvClear(pfm->mEytzIndex);
+   if (!cvEmplaceBackN(pfm->mEytzKeys, count + 1)) return fail;
+   if (!cvEmplaceBackN(pfm->mEytzIndex, count + 1)) return fail;
+
+   flatEytzFill(pfm, 0, 1, count);
+   pfm->mEytzValid = true;
+   return success;
+}
+
+// Returns the index in mKeys of the first key not less than pKey (the
+// count if none), searching the Eytzinger keys. Each step goes one level
+// down the tree; the 16 descendants four levels down are contiguous and are
+// prefetched.
+uint64_t flatEytzLowerBound(fmap* pfm, const void* pKey)
+{
+   uint64_t count = cvCount(pfm->mKeys);
+   const uint8_t* pKeys = (const uint8_t*)cvData(pfm->mEytzKeys);
+   uint32_t size = pfm->mKeySize;
+
+   uint64_t k = 1;
+   while (k <= count) {
+      __builtin_prefetch(pKeys + ((k * 16) * size));
+      k = (2 * k) + (pfm->mCmp((void*)(pKeys + (k * size)), (void*)pKey) < 0);
+   }
+
+   // Undo the right turns taken after the last left turn.
+   k >>= __builtin_ffsll(~k);
+   if (k == 0) return count;
+   return ((const uint64_t*)cvData(pfm->mEytzIndex))[k];
+}
+
+//
+// Private API - Searching.
+//
+
+// Returns the index in mKeys of the first key not less than pKey.
+uint64_t flatLowerBound(fmap* pfm, const void* pKey)
+{
+   if ((pfm->mFlags & fmfeytzinger) && success == flatEytzBuild(pfm)) {
+      return flatEytzLowerBound(pfm, pKey);
+   }
+
+   return cvLowerBound(pfm->mKeys, pKey, pfm->mCmp);
+}
+
+// Returns the index in mKeys of pKey or FM_NPOS.
+uint64_t flatFind(fmap* pfm, const void* pKey)
+{
+   uint64_t index = flatLowerBound(pfm, pKey);
+   if (index < cvCount(pfm->mKeys) &&
+      0 == pfm->mCmp(cvAt(pfm->mKeys, index), (void*)pKey)) {
+      return index;
+   }
+   return FM_NPOS;
+}
+
+// Returns the index of the tail record of pKey or FM_NPOS.
+uint64_t flatFindTail(fmap* pfm, const void* pKey)
+{
+   uint64_t count = cvCount(pfm->mTail);
+   for (uint64_t n = 0; n < count; ++n) {
+      if (0 == pfm->mCmp(cvAt(pfm->mTail, n), (void*)pKey)) return n;
+   }
+   return FM_NPOS;
+}
+
+//
+// Private API - Merging.
+//
+
+// Merges the tail into the sorted items. Tail records are sorted (stably,
+// so the last of equal keys wins), records of keys already in the map
+// overwrite their values, and the rest are merged from the back.
+retcode flatMerge(fmap* pfm)
+{
+   uint64_t tailCount = cvCount(pfm->mTail);
+   if (tailCount == 0) return success;
+   if (fail == cvStableSort(pfm->mTail, pfm->mCmp)) return fail;
+
+   // Keep new keys only (the last of each run of equal keys).
+   uint64_t keep = 0;
+   for (uint64_t r = 0; r < tailCount; ++r) {
+      void* pRecord = cvAt(pfm->mTail, r);
+      if (r + 1 < tailCount &&
+         0 == pfm->mCmp(pRecord, cvAt(pfm->mTail, r + 1))) continue;
+
+      // Binary search here: the Eytzinger keys are rebuilt after the merge.
+      uint64_t index = cvBinarySearch(pfm->mKeys, pRecord, pfm->mCmp);
+      if (index != CV_NPOS) {
+         memcpy(cvAt(pfm->mValues, index), pRecord + pfm->mTailValue,
+            pfm->mValueSize);
+         continue;
+      }
+      if (keep != r) {
+         memcpy(cvAt(pfm->mTail, keep), pRecord, cvStride(pfm->mTail));
+      }
+      keep++;
+   }
+
+   // Room for the new keys. If there is none only the new keys are left in
+   // the tail (the rest were merged above) for a later merge.
+   uint64_t count = cvCount(pfm->mKeys);
+   if (keep > 0) {
+      bool grown = (nul != cvEmplaceBackN(pfm->mKeys, keep));
+      if (grown && !cvEmplaceBackN(pfm->mValues, keep)) {
+         cvEraseRange(pfm->mKeys, count, keep);
+         grown = false;
+      }
+      if (!grown) {
+         cvEraseRange(pfm->mTail, keep, tailCount - keep);
+         return fail;
+      }
+   }
+
+   // Merge from the back so nothing is overwritten before it is moved.
+   uint64_t i = count, j = keep, k = count + keep;
+   while (j > 0) {
+      void* pRecord = cvAt(pfm->mTail, j - 1);
+      if (i > 0 && pfm->mCmp(cvAt(pfm->mKeys, i - 1), pRecord) > 0) {
+         i--;
+         memcpy(cvAt(pfm->mKeys, k - 1), cvAt(pfm->mKeys, i), pfm->mKeySize);
+         memcpy(cvAt(pfm->mValues, k - 1), cvAt(pfm->mValues, i),
+            pfm->mValueSize);
+      } else {
+         j--;
+         memcpy(cvAt(pfm->mKeys, k - 1), pRecord, pfm->mKeySize);
+         memcpy(cvAt(pfm->mValues, k - 1), pRecord + pfm->mTailValue,
+            pfm->mValueSize);
+      }
+      k--;
+   }
+
+   cvClear(pfm->mTail);
+   pfm->mEytzValid = false;
+   return success;
+}
+
+//
+// Size management.
+//
+
+// Returns the number of items in the map. Keys put twice while in the tail
+// are counted once.
+uint64_t fmGetCount(cflatmap cfm)
+{
+   const fmap* pfm = (const fmap*)cfm;
+   return (pfm ? cvCount(pfm->mKeys) + cvCount(pfm->mTail) : 0);
+}
+
+// Reserve itemCount items in the map.
+retcode fmReserve(flatmap fm, uint64_t itemCount)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) return fail;
+
+   if (fail == cvReserve(pfm->mKeys, itemCount)) return fail;
+   return cvReserve(pfm->mValues, itemCount);
+}
+
+// Removes all items.
+void fmClear(flatmap fm)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) return;
+
+   cvClear(pfm->mKeys);
+   cvClear(pfm->mValues);
+   cvClear(pfm->mTail);
+   pfm->mEytzValid = false;
+}
+
+// Frees memory not needed for the items held.
+void fmShrink(flatmap fm)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) return;
+
+   cvShrink(pfm->mKeys);
+   cvShrink(pfm->mValues);
+   cvShrink(pfm->mTail);
+   if (pfm->mFlags & fmfeytzinger) {
+      pfm->mEytzValid = false;
+      cvClear(pfm->mEytzKeys);
+      cvClear(pfm->mEytzIndex);
+      cvShrink(pfm->mEytzKeys);
+      cvShrink(pfm->mEytzIndex);
+   }
+}
+
+//
+// Items.
+//
+
+// Adds pKey with pValue, or overwrites its value. New keys go to the tail,
+// which is merged once it passes its maximum. Returns the value. If the merge
+// fails the key stays in the tail (its value is returned) and a later put
+// merges it.
+void* fmPut(flatmap fm, const void* pKey, const void* pValue)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm || !pKey || !pValue) return nul;
+
+   // Overwrite an existing key.
+   void* pDst = fmGet(fm, pKey);
+   if (pDst) {
+      memcpy(pDst, pValue, pfm->mValueSize);
+      return pDst;
+   }
+
+   // Add to the tail.
+   uint8_t* pRecord = (uint8_t*)cvEmplaceBackN(pfm->mTail, 1);
+   if (!pRecord) return nul;
+   memcpy(pRecord, pKey, pfm->mKeySize);
+   memcpy(pRecord + pfm->mTailValue, pValue, pfm->mValueSize);
+   if (cvCount(pfm->mTail) <= pfm->mTailMax) return pRecord + pfm->mTailValue;
+
+   if (fail == flatMerge(pfm)) return fmGet(fm, pKey);
+   return cvAt(pfm->mValues, flatFind(pfm, pKey));
+}
+
+// Adds count keys and values, sorting and merging them once.
+retcode fmPutN(flatmap fm, const void* pKeys, const void* pValues,
+   uint64_t count)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm || !pKeys || !pValues || count == 0) return fail;
+
+   // Merge what is there so the last put wins.
+   if (fail == flatMerge(pfm)) return fail;
+
+   // Room for every key to be new, so that the merge below cannot fail once
+   // it starts overwriting values (the vectors grow as pushes would).
+   uint64_t keys = cvCount(pfm->mKeys);
+   if (!cvEmplaceBackN(pfm->mKeys, count)) return fail;
+   bool room = (nul != cvEmplaceBackN(pfm->mValues, count));
+   cvEraseRange(pfm->mKeys, keys, count);
+   if (!room) return fail;
+   cvEraseRange(pfm->mValues, keys, count);
+
+   uint8_t* pRecord = (uint8_t*)cvEmplaceBackN(pfm->mTail, count);
+   if (!pRecord) return fail;
+   for (uint64_t n = 0; n < count; ++n) {
+      memcpy(pRecord, pKeys + (n * pfm->mKeySize), pfm->mKeySize);
+      memcpy(pRecord + pfm->mTailValue, pValues + (n * pfm->mValueSize),
+         pfm->mValueSize);
+      pRecord += cvStride(pfm->mTail);
+   }
+
+   if (fail == flatMerge(pfm)) {
+      cvClear(pfm->mTail);
+      return fail;
+   }
+
+   // Done. Keep the tail buffer unless the batch grew it far past its use.
+   if (cvGetSize(pfm->mTail) > (uint64_t)pfm->mTailMax * FLATMAP_TAILSHRINK) {
+      cvShrink(pfm->mTail);
+   }
+   return success;
+}
+
+// Returns the value of pKey or null if not in the map.
+void* fmGet(flatmap fm, const void* pKey)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm || !pKey) return nul;
+
+   uint64_t index = flatFind(pfm, pKey);
+   if (index != FM_NPOS) return cvAt(pfm->mValues, index);
+
+   index = flatFindTail(pfm, pKey);
+   if (index != FM_NPOS) return cvAt(pfm->mTail, index) + pfm->mTailValue;
+   return nul;
+}
+
+// Returns true if pKey is in the map.
+bool fmContains(flatmap fm, const void* pKey)
+{
+   return (nul != fmGet(fm, pKey));
+}
+
+// Removes pKey from the map.
+retcode fmErase(flatmap fm, const void* pKey)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm || !pKey) return fail;
+
+   // Tail order does not matter.
+   uint64_t index = flatFindTail(pfm, pKey);
+   if (index != FM_NPOS) return cvSwapRemove(pfm->mTail, index);
+
+   index = flatFind(pfm, pKey);
+   if (index == FM_NPOS) return fail;
+
+   cvEraseAt(pfm->mKeys, index);
+   cvEraseAt(pfm->mValues, index);
+   pfm->mEytzValid = false;
+   return success;
+}
+
+//
+// Ordered access.
+//
+
+// Merges the tail into the sorted items.
+void fmFlush(flatmap fm)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) return;
+   flatMerge(pfm);
+}
+
+// Returns the index of the first key not less than pKey.
+uint64_t fmLowerBound(flatmap fm, const void* pKey)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm || !pKey) return 0;
+
+   flatMerge(pfm);
+   return flatLowerBound(pfm, pKey);
+}
+
+// Returns a span over the keys in order.
+cvspan fmKeys(flatmap fm)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+
+   flatMerge(pfm);
+   return cvSpan(pfm->mKeys);
+}
+
+// Returns a span over the values in key order.
+cvspan fmValues(flatmap fm)
+{
+   fmap* pfm = (fmap*)fm;
+   if (!pfm) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+
+   flatMerge(pfm);
+   return cvSpan(pfm->mValues);
+}
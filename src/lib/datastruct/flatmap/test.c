@@ -0,0 +1,221 @@
+/*
+Date: 17 Oct 2026 18:44:27.405829361
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_E4C0A6B28D1F53970B4E8D2A6C1F3B59__
+Purpose: Tests for flatmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <flatmap.h>
+
+//
+// MACROS
+//
+
+// Keys used by the random operations test.
+#define TEST_KEYS                            3000
+
+//
+// HELPERS
+//
+
+// Orders 32 bit keys.
+int8_t cmpKey(void* a, void* b)
+{
+   uint32_t x = *(uint32_t*)a, y = *(uint32_t*)b;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+//
+// TEST CASES
+//
+
+// Tests put, get and erase against a table of expected values, with both
+// searches and a tail small enough to merge often.
+bool testRandom(TFSuite pTest)
+{
+   tfzassert_ptr(pTest, fmcreate(4, 4, null), null, false);
+   tfzassert_ptr(pTest, fmcreate(4, 0, cmpKey), null, false);
+
+   uint32_t flags[] = { fmfnone, fmfeytzinger };
+   for (uint32_t f = 0; f < 2; ++f) {
+      flatmap fm = fmcreatex(sizeof(uint32_t), sizeof(uint64_t), cmpKey,
+         flags[f], 16);
+      if (false == tfzassert(pTest, fm != null, true, false)) {
+         return false;
+      }
+      uint32_t key = 5;
+      tfzassert_ptr(pTest, fmGet(fm, &key), null, false);
+      tfzassert(pTest, fmLowerBound(fm, &key) == 0, true, false);
+
+      // Random operations.
+      static uint64_t expected[TEST_KEYS];
+      memset(expected, 0, sizeof(expected));
+      uint64_t seed = 31, count = 0;
+      bool ok = true;
+      for (uint32_t n = 0; n < TEST_KEYS * 10; ++n) {
+         seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+         key = (uint32_t)((seed >> 33) % TEST_KEYS);
+         uint64_t value = (seed >> 20) | 1;
+         if ((seed >> 60) < 11) {
+            uint64_t* pv = (uint64_t*)fmPut(fm, &key, &value);
+            if (!pv || *pv != value) ok = false;
+            if (!expected[key]) count++;
+            expected[key] = value;
+         } else {
+            retcode rc = fmErase(fm, &key);
+            if (rc != (expected[key] ? success : fail)) ok = false;
+            if (expected[key]) count--;
+            expected[key] = 0;
+         }
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, fmGetCount(fm) == count, true, false);
+
+      // Every key looked up.
+      ok = true;
+      for (key = 0; key < TEST_KEYS; ++key) {
+         uint64_t* pv = (uint64_t*)fmGet(fm, &key);
+         if ((pv ? *pv : 0) != expected[key]) ok = false;
+         if (fmContains(fm, &key) != (expected[key] != 0)) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+
+      // Ordered access merges the tail.
+      cvspan keys = fmKeys(fm);
+      cvspan values = fmValues(fm);
+      tfzassert(pTest, cvSpanCount(keys) == count, true, false);
+      ok = true;
+      uint32_t last = 0, index = 0;
+      cvforeach(uint32_t, pk, keys) {
+         if (index > 0 && *pk <= last) ok = false;
+         if (((uint64_t*)values.mpBegin)[index] != expected[*pk]) ok = false;
+         last = *pk;
+         index++;
+      }
+      tfzassert(pTest, ok, true, false);
+
+      // Lower bound matches a walk over the keys.
+      ok = true;
+      for (key = 0; key <= TEST_KEYS; key += 7) {
+         uint64_t bound = fmLowerBound(fm, &key);
+         uint64_t walk = 0;
+         while (walk < count && ((uint32_t*)keys.mpBegin)[walk] < key) walk++;
+         if (bound != walk) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+
+      fmdestroy(&fm);
+      tfzassert_ptr(pTest, fm, null, false);
+   }
+
+   // Success.
+   return true;
+}
+
+// Tests bulk loads.
+bool testBulk(TFSuite pTest)
+{
+   flatmap fm = fmcreatex(sizeof(uint32_t), sizeof(uint32_t), cmpKey,
+      fmfeytzinger, 0);
+   if (false == tfzassert(pTest, fm != null, true, false)) {
+      return false;
+   }
+
+   // Unsorted keys with repeats; the last of each wins.
+   uint32_t keys[1000], values[1000];
+   for (uint32_t n = 0; n < 1000; ++n) {
+      keys[n] = (n * 7919) % 600;
+      values[n] = n;
+   }
+   tfzassert(pTest, fmReserve(fm, 1000), success, false);
+   tfzassert(pTest, fmPutN(fm, keys, values, 1000), success, false);
+   tfzassert(pTest, fmGetCount(fm) == 600, true, false);
+   bool ok = true;
+   for (uint32_t n = 0; n < 1000; ++n) {
+      uint32_t* pv = (uint32_t*)fmGet(fm, &keys[n]);
+      uint32_t expected = (n + 600 < 1000 && keys[n + 600] == keys[n] ?
+         n + 600 : n);
+      if (!pv || *pv != expected) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // A second load overwrites and adds; a tail put before it is kept.
+   uint32_t key = 5000, value = 1;
+   fmPut(fm, &key, &value);
+   for (uint32_t n = 0; n < 1000; ++n) {
+      keys[n] = n;
+      values[n] = 7;
+   }
+   tfzassert(pTest, fmPutN(fm, keys, values, 1000), success, false);
+   tfzassert(pTest, fmGetCount(fm) == 1001, true, false);
+   key = 599;
+   tfzassert_ui32(pTest, *(uint32_t*)fmGet(fm, &key), 7, false);
+   key = 5000;
+   tfzassert_ui32(pTest, *(uint32_t*)fmGet(fm, &key), 1, false);
+
+   // Clear and shrink.
+   fmClear(fm);
+   fmShrink(fm);
+   tfzassert(pTest, fmGetCount(fm) == 0, true, false);
+   tfzassert_ptr(pTest, fmGet(fm, &key), null, false);
+
+   // Success.
+   fmdestroy(&fm);
+   return tfzassert_ptr(pTest, fm, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("flatmap tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testRandom(tfz);
+   testBulk(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
@@ -0,0 +1,170 @@
+/*
+Date: 17 Oct 2026 17:58:12.671094583
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_0A7F3C5E1B9D48623F0C7A2E5D1B8F94__
+Purpose: Benchmarks for hashmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (load factors)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+#include <hashmap.h>
+
+//
+// MACROS
+//
+
+// Table size (log2 of the slot count) unless given on the command line.
+#define BENCH_DEFAULT_LOG2SLOTS              20
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+// Orders 64 bit keys.
+int8_t cmpKey(void* a, void* b)
+{
+   uint64_t x = *(uint64_t*)a, y = *(uint64_t*)b;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+//
+// BENCHMARKS
+//
+
+// Fills a table of slots slots to loadFactor with 64 bit keys and values and
+// times inserts, lookups that hit and miss, erase/insert churn, and binary
+// search over a sorted vector of the same keys.
+void benchLoad(uint64_t slots, double loadFactor)
+{
+   uint64_t count = (uint64_t)(slots * loadFactor);
+   uint64_t* pKeys = (uint64_t*)malloc(sizeof(uint64_t) * count * 2);
+   hashmap hm = hmcreate(sizeof(uint64_t), sizeof(uint64_t));
+   cvector sorted = cvcreate(sizeof(uint64_t));
+   if (!pKeys || !hm || !sorted) {
+      free(pKeys);
+      hmdestroy(&hm);
+      cvdestroy(&sorted);
+      return;
+   }
+
+   // Keys to insert, then keys that are not in the map.
+   uint64_t seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count * 2; ++n) pKeys[n] = benchRandom(&seed);
+   uint64_t* pMisses = pKeys + count;
+
+   // Inserts into a table sized up front (it must not grow).
+   hmSetMaxLoad(hm, 0.95);
+   hmReserve(hm, count);
+   double start = benchNow();
+   for (uint64_t n = 0; n < count; ++n) {
+      hmPut(hm, &pKeys[n], &n);
+   }
+   double insert = benchNow() - start;
+
+   uint64_t found = 0;
+   start = benchNow();
+   for (uint64_t n = 0; n < count; ++n) {
+      found += (hmGet(hm, &pKeys[n]) != null);
+   }
+   double hit = benchNow() - start;
+
+   start = benchNow();
+   for (uint64_t n = 0; n < count; ++n) {
+      found += (hmGet(hm, &pMisses[n]) != null);
+   }
+   double miss = benchNow() - start;
+
+   // Churn: replace each key with a new one (tombstones and cleanup).
+   start = benchNow();
+   for (uint64_t n = 0; n < count; ++n) {
+      hmErase(hm, &pKeys[n]);
+      hmPut(hm, &pMisses[n], &n);
+   }
+   double churn = benchNow() - start;
+
+   // Binary search over the same keys.
+   cvPushBackN(sorted, pMisses, count);
+   cvSort(sorted, cmpKey);
+   start = benchNow();
+   for (uint64_t n = 0; n < count; ++n) {
+      found += (CV_NPOS != cvBinarySearch(sorted, &pMisses[n], cmpKey));
+   }
+   double search = benchNow() - start;
+
+   printf("%6.2f %12" PRIu64 " %10.1f %10.1f %10.1f %10.1f %10.1f %s\n",
+      loadFactor, hmGetCapacity(hm),
+      count / insert / 1e6, count / hit / 1e6, count / miss / 1e6,
+      count / churn / 1e6, count / search / 1e6,
+      (found == count * 2 && hmGetCount(hm) == count ? "" : "(mismatch!)")
+   );
+
+   free(pKeys);
+   hmdestroy(&hm);
+   cvdestroy(&sorted);
+}
+
+int main(int argc, char** argv)
+{
+   int log2Slots = BENCH_DEFAULT_LOG2SLOTS;
+   if (argc > 1) log2Slots = atoi(argv[1]);
+   if (log2Slots < 10) log2Slots = 10;
+   if (log2Slots > 26) log2Slots = 26;
+
+   // Million operations per second at each load factor.
+   printf("%6s %12s %10s %10s %10s %10s %10s\n", "load", "slots",
+      "insert", "hit", "miss", "churn", "bsearch");
+   double loads[] = { 0.5, 0.6, 0.7, 0.8, 0.9 };
+   for (uint32_t n = 0; n < 5; ++n) {
+      benchLoad((uint64_t)1 << log2Slots, loads[n]);
+   }
+
+   return 0;
+}
@@ -0,0 +1,583 @@
+/*
+Date: 17 Oct 2026 17:58:12.624518306
+File: hashmap.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __HASHMAP_C_D27A4E0B9F1C63854A0E2B7D1F6C9A35__
+Purpose: Implements an open addressing hash map with fixed size keys and
+         values. Slots are probed a group of 16 at a time: a control byte per
+         slot holds 7 bits of the hash, and SSE2 compares a whole group of
+         control bytes in one go (SwissTable style).
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <commons.h>
+#include <hashmap.h>
+
+//
+// MACROS
+//
+
+// Control bytes. Full slots hold the low 7 bits of the hash (0..127).
+#define HASHMAP_EMPTY                        ((int8_t)-128)
+#define HASHMAP_DELETED                      ((int8_t)-2)
+
+// Slots probed together and the smallest table.
+#define HASHMAP_GROUP                        16
+#define HASHMAP_MINCAPACITY                  16
+
+#define HASHMAP_DEFAULTLOAD                  0.875
+#define HASHMAP_MINLOAD                      0.25
+#define HASHMAP_MAXLOAD                      0.95
+
+// Position of slots when not found.
+#define HASHMAP_NPOS                         ((uint64_t)-1)
+
+//
+// STRUCTS
+//
+
+// The table is one block: mCapacity control bytes (plus a copy of the first
+// group after them so any group can be loaded without wrapping), then the
+// slots. A slot is a key followed by its value at mValueOffset.
+// mGrowthLeft counts empty slots that may still be filled before the table
+// must be rehashed; erased slots become tombstones (HASHMAP_DELETED) unless
+// no probe can have passed over them.
+typedef struct _hmap {
+   uint32_t mKeySize;                              // size of a key
+   uint32_t mValueSize;                            // size of a value
+   uint32_t mValueOffset;                          // value within a slot
+   uint32_t mSlotSize;                             // key + value (aligned)
+   hasher mHash;                                   // key hash
+   comparator mCmp;                                // key equality (or null)
+   double mMaxLoad;                                // maximum load factor
+   uint64_t mCount;                                // items held
+   uint64_t mDeleted;                              // tombstones
+   uint64_t mGrowthLeft;                           // empties left to fill
+   uint64_t mCapacity;                             // slots (0 or power of 2)
+   int8_t* mpCtrl;                                 // control bytes
+   uint8_t* mpSlots;                               // slots
+} hmap;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new hash map hashing and comparing key bytes. Initially the map
+// will be empty. No table is allocated unless necessary.
+hashmap hmcreate(uint32_t keySize, uint32_t valueSize)
+{
+   return hmcreatex(keySize, valueSize, nul, nul);
+}
+
+// Returns the alignment suited to an item of size bytes (up to 8).
+uint32_t hashAlignOf(uint32_t size)
+{
+   uint32_t align = (size & (~size + 1));
+   return (align == 0 || align > 8 ? 8 : align);
+}
+
+// Create a new hash map with the hash function and comparator given.
+hashmap hmcreatex(uint32_t keySize, uint32_t valueSize, hasher hash,
+   comparator cmp)
+{
+   if (keySize == 0) return nul;
+
+   hmap* phm = (hmap*)malloc(sizeof(hmap));
+   if (!phm) return nul;
+   memset(phm, 0, sizeof(hmap));
+
+   // Values are aligned to their size within a slot and slots to the larger
+   // of key and value alignment.
+   uint32_t valueAlign = (valueSize ? hashAlignOf(valueSize) : 1);
+   uint32_t keyAlign = hashAlignOf(keySize);
+   uint32_t slotAlign = (valueAlign > keyAlign ? valueAlign : keyAlign);
+   phm->mKeySize = keySize;
+   phm->mValueSize = valueSize;
+   phm->mValueOffset = (keySize + valueAlign - 1) & ~(valueAlign - 1);
+   phm->mSlotSize = (phm->mValueOffset + valueSize + slotAlign - 1) &
+      ~(slotAlign - 1);
+   phm->mHash = (hash ? hash : hmHashBytes);
+   phm->mCmp = cmp;
+   phm->mMaxLoad = HASHMAP_DEFAULTLOAD;
+
+   // Done.
+   return (hashmap)phm;
+}
+
+// Destroy existing hash map.
+void hmdestroy(hashmap* phm)
+{
+   if (nul == phm) return;
+   if (nul == (*phm)) return;
+
+   hmap* hm = (hmap*)*phm;
+   if (hm->mpCtrl) free(hm->mpCtrl);
+
+   free(*phm);
+   *phm = 0;
+}
+
+//
+// Private API - Hashing.
+//
+
+// Mixes all bits of x into all bits of the result (murmur3 finalizer).
+uint64_t hashMix(uint64_t x)
+{
+   x ^= x >> 33;
+   x *= 0xFF51AFD7ED558CCDull;
+   x ^= x >> 33;
+   x *= 0xC4CEB9FE1A85EC53ull;
+   x ^= x >> 33;
+   return x;
+}
+
+// Returns true if keys a and b are equal.
+bool hashEqual(const hmap* phm, const void* a, const void* b)
+{
+   if (phm->mCmp) return (0 == phm->mCmp((void*)a, (void*)b));
+   if (phm->mKeySize == 8) return (*(const uint64_t*)a == *(const uint64_t*)b);
+   if (phm->mKeySize == 4) return (*(const uint32_t*)a == *(const uint32_t*)b);
+   return (0 == memcmp(a, b, phm->mKeySize));
+}
+
+//
+// Private API - Groups.
+//
+
+// Bit i of a mask is set when control byte i of the group at pCtrl...
+#if defined __SSE2__
+// ...equals h2.
+uint32_t hashMatch(const int8_t* pCtrl, int8_t h2)
+{
+   __m128i group = _mm_loadu_si128((const __m128i*)pCtrl);
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+}
+
+// ...is empty.
+uint32_t hashMatchEmpty(const int8_t* pCtrl)
+{
+   return hashMatch(pCtrl, HASHMAP_EMPTY);
+}
+
+// ...is empty or deleted (sign bit set).
+uint32_t hashMatchFree(const int8_t* pCtrl)
+{
+   return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)pCtrl));
+}
+#else
+// ...equals h2.
+uint32_t hashMatch(const int8_t* pCtrl, int8_t h2)
+{
+   uint32_t mask = 0;
+   for (uint32_t i = 0; i < HASHMAP_GROUP; ++i) {
+      if (pCtrl[i] == h2) mask |= (1u << i);
+   }
+   return mask;
+}
+
+// ...is empty.
+uint32_t hashMatchEmpty(const int8_t* pCtrl)
+{
+   return hashMatch(pCtrl, HASHMAP_EMPTY);
+}
+
+// ...is empty or deleted (sign bit set).
+uint32_t hashMatchFree(const int8_t* pCtrl)
+{
+   uint32_t mask = 0;
+   for (uint32_t i = 0; i < HASHMAP_GROUP; ++i) {
+      if (pCtrl[i] < 0) mask |= (1u << i);
+   }
+   return mask;
+}
+#endif
+
+//
+// Private API - Table.
+//
+
+// Returns slot index.
+uint8_t* hashSlot(const hmap* phm, uint64_t index)
+{
+   return phm->mpSlots + ((size_t)index * phm->mSlotSize);
+}
+
+// Returns the number of items a table of capacity slots may hold.
+uint64_t hashMaxItems(const hmap* phm, uint64_t capacity)
+{
+   uint64_t items = (uint64_t)((double)capacity * phm->mMaxLoad);
+   if (items >= capacity) items = capacity - 1;
+   return items;
+}
+
+// Returns the smallest capacity holding itemCount items.
+uint64_t hashCapacityFor(const hmap* phm, uint64_t itemCount)
+{
+   uint64_t capacity = HASHMAP_MINCAPACITY;
+   while (hashMaxItems(phm, capacity) < itemCount) capacity <<= 1;
+   return capacity;
+}
+
+// Sets control byte index (and its copy after the table).
+void hashSetCtrl(hmap* phm, uint64_t index, int8_t ctrl)
+{
+   phm->mpCtrl[index] = ctrl;
+   if (index < HASHMAP_GROUP) phm->mpCtrl[phm->mCapacity + index] = ctrl;
+}
+
+// Returns the slot holding pKey or HASHMAP_NPOS.
+uint64_t hashFind(const hmap* phm, const void* pKey, uint64_t hash)
+{
+   if (phm->mCapacity == 0) return HASHMAP_NPOS;
+
+   // Probe groups at triangular offsets (visits every group).
+   int8_t h2 = (int8_t)(hash & 0x7F);
+   uint64_t mask = phm->mCapacity - 1;
+   uint64_t pos = (hash >> 7) & mask;
+   for (uint64_t step = HASHMAP_GROUP;; step += HASHMAP_GROUP) {
+      const int8_t* pGroup = phm->mpCtrl + pos;
+      for (uint32_t m = hashMatch(pGroup, h2); m; m &= (m - 1)) {
+         uint64_t index = (pos + __builtin_ctz(m)) & mask;
+         if (hashEqual(phm, pKey, hashSlot(phm, index))) return index;
+      }
+      if (hashMatchEmpty(pGroup)) return HASHMAP_NPOS;
+      pos = (pos + step) & mask;
+   }
+}
+
+// Returns the first empty or deleted slot on the probe sequence of hash.
+uint64_t hashFindFree(const hmap* phm, uint64_t hash)
+{
+   uint64_t mask = phm->mCapacity - 1;
+   uint64_t pos = (hash >> 7) & mask;
+   for (uint64_t step = HASHMAP_GROUP;; step += HASHMAP_GROUP) {
+      uint32_t m = hashMatchFree(phm->mpCtrl + pos);
+      if (m) return (pos + __builtin_ctz(m)) & mask;
+      pos = (pos + step) & mask;
+   }
+}
+
+// Moves all items into a new table of capacity slots (0 frees the table).
+// Tombstones are dropped.
+retcode hashRehash(hmap* phm, uint64_t capacity)
+{
+   // New table (control bytes, their copy, then slots aligned to 16).
+   int8_t* pCtrl = nul;
+   uint8_t* pSlots = nul;
+   if (capacity > 0) {
+      size_t ctrlSize = (capacity + HASHMAP_GROUP + 15) & ~(size_t)15;
+      pCtrl = (int8_t*)malloc(ctrlSize + ((size_t)capacity * phm->mSlotSize));
+      if (!pCtrl) return fail;
+      memset(pCtrl, HASHMAP_EMPTY, capacity + HASHMAP_GROUP);
+      pSlots = (uint8_t*)pCtrl + ctrlSize;
+   }
+
+   // Move items across.
+   hmap old = *phm;
+   phm->mpCtrl = pCtrl;
+   phm->mpSlots = pSlots;
+   phm->mCapacity = capacity;
+   for (uint64_t i = 0; i < old.mCapacity; ++i) {
+      if (old.mpCtrl[i] < 0) continue;
+      const uint8_t* pSlot = hashSlot(&old, i);
+      uint64_t hash = phm->mHash(pSlot, phm->mKeySize);
+      uint64_t index = hashFindFree(phm, hash);
+      hashSetCtrl(phm, index, (int8_t)(hash & 0x7F));
+      memcpy(hashSlot(phm, index), pSlot, phm->mSlotSize);
+   }
+   if (old.mpCtrl) free(old.mpCtrl);
+
+   phm->mDeleted = 0;
+   phm->mGrowthLeft =
+      (capacity ? hashMaxItems(phm, capacity) - phm->mCount : 0);
+   return success;
+}
+
+// Makes room for one more item in an empty slot. Tables where tombstones
+// take at least 1/32 of the room are cleaned at the same size (so erase and
+// insert churn does not grow them); others double.
+retcode hashMakeRoom(hmap* phm)
+{
+   if (phm->mCapacity == 0) return hashRehash(phm, HASHMAP_MINCAPACITY);
+
+   uint64_t capacity = phm->mCapacity;
+   uint64_t deleted = phm->mDeleted;
+   if (deleted == 0 || deleted < hashMaxItems(phm, capacity) / 32) {
+      capacity <<= 1;
+   }
+   return hashRehash(phm, capacity);
+}
+
+//
+// Size management.
+//
+
+// Returns the number of items in the map.
+uint64_t hmGetCount(chashmap chm)
+{
+   const hmap* phm = (const hmap*)chm;
+   return (phm ? phm->mCount : 0);
+}
+
+// Returns the number of slots in the table.
+uint64_t hmGetCapacity(chashmap chm)
+{
+   const hmap* phm = (const hmap*)chm;
+   return (phm ? phm->mCapacity : 0);
+}
+
+// Sets the maximum load factor, rehashing if the table is now too full.
+retcode hmSetMaxLoad(hashmap hm, double maxLoad)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm) return fail;
+   if (maxLoad < HASHMAP_MINLOAD || maxLoad > HASHMAP_MAXLOAD) return fail;
+
+   phm->mMaxLoad = maxLoad;
+   if (phm->mCapacity == 0) return success;
+
+   uint64_t maxItems = hashMaxItems(phm, phm->mCapacity);
+   if (phm->mCount + phm->mDeleted > maxItems) {
+      return hashRehash(phm, hashCapacityFor(phm, phm->mCount));
+   }
+   phm->mGrowthLeft = maxItems - phm->mCount - phm->mDeleted;
+   return success;
+}
+
+// Makes room for itemCount items in total.
+retcode hmReserve(hashmap hm, uint64_t itemCount)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm) return fail;
+
+   uint64_t capacity = hashCapacityFor(phm, itemCount);
+   if (capacity <= phm->mCapacity) return success;
+   return hashRehash(phm, capacity);
+}
+
+// Removes all items. The table is kept until hmShrink() is called.
+void hmClear(hashmap hm)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm || phm->mCapacity == 0) return;
+
+   memset(phm->mpCtrl, HASHMAP_EMPTY, phm->mCapacity + HASHMAP_GROUP);
+   phm->mCount = 0;
+   phm->mDeleted = 0;
+   phm->mGrowthLeft = hashMaxItems(phm, phm->mCapacity);
+}
+
+// Rehashes into the smallest table holding the items (none if empty).
+void hmShrink(hashmap hm)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm) return;
+
+   uint64_t capacity = (phm->mCount ? hashCapacityFor(phm, phm->mCount) : 0);
+   if (capacity < phm->mCapacity || phm->mDeleted > 0) {
+      hashRehash(phm, capacity);
+   }
+}
+
+//
+// Items.
+//
+
+// Adds pKey with pValue, or overwrites its value. Returns the value.
+void* hmPut(hashmap hm, const void* pKey, const void* pValue)
+{
+   void* pDst = hmEmplace(hm, pKey, nul);
+   if (pDst && pValue) memcpy(pDst, pValue, ((hmap*)hm)->mValueSize);
+   return pDst;
+}
+
+// Returns the value of pKey, adding the key with a blank value if it is not
+// in the map. Returns null on failure.
+void* hmEmplace(hashmap hm, const void* pKey, bool* pInserted)
+{
+   hmap* phm = (hmap*)hm;
+   if (pInserted) *pInserted = false;
+   if (!phm || !pKey) return nul;
+
+   uint64_t hash = phm->mHash(pKey, phm->mKeySize);
+   uint64_t index = hashFind(phm, pKey, hash);
+   if (index != HASHMAP_NPOS) return hashSlot(phm, index) + phm->mValueOffset;
+
+   // Reuse a tombstone or fill an empty slot (growing if none are left).
+   if (phm->mCapacity > 0) index = hashFindFree(phm, hash);
+   if (phm->mCapacity == 0 ||
+      (phm->mpCtrl[index] == HASHMAP_EMPTY && phm->mGrowthLeft == 0)) {
+      if (fail == hashMakeRoom(phm)) return nul;
+      index = hashFindFree(phm, hash);
+   }
+   if (phm->mpCtrl[index] == HASHMAP_EMPTY) {
+      phm->mGrowthLeft--;
+   } else {
+      phm->mDeleted--;
+   }
+
+   hashSetCtrl(phm, index, (int8_t)(hash & 0x7F));
+   uint8_t* pSlot = hashSlot(phm, index);
+   memcpy(pSlot, pKey, phm->mKeySize);
+   memset(pSlot + phm->mValueOffset, 0, phm->mValueSize);
+   phm->mCount++;
+
+   // Done.
+   if (pInserted) *pInserted = true;
+   return pSlot + phm->mValueOffset;
+}
+
+// Returns the value of pKey or null if not in the map.
+void* hmGet(hashmap hm, const void* pKey)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm || !pKey) return nul;
+
+   uint64_t index = hashFind(phm, pKey, phm->mHash(pKey, phm->mKeySize));
+   if (index == HASHMAP_NPOS) return nul;
+   return hashSlot(phm, index) + phm->mValueOffset;
+}
+
+// Returns true if pKey is in the map.
+bool hmContains(chashmap chm, const void* pKey)
+{
+   const hmap* phm = (const hmap*)chm;
+   if (!phm || !pKey) return false;
+   return HASHMAP_NPOS != hashFind(phm, pKey, phm->mHash(pKey, phm->mKeySize));
+}
+
+// Removes pKey from the map.
+retcode hmErase(hashmap hm, const void* pKey)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm || !pKey) return fail;
+
+   uint64_t index = hashFind(phm, pKey, phm->mHash(pKey, phm->mKeySize));
+   if (index == HASHMAP_NPOS) return fail;
+
+   // If the group before and the group from index leave no run of 16 full
+   // or deleted slots around index, no probe ever passed over it - it can
+   // simply be emptied. Otherwise it becomes a tombstone.
+   uint64_t mask = phm->mCapacity - 1;
+   uint32_t before =
+      hashMatchEmpty(phm->mpCtrl + ((index - HASHMAP_GROUP) & mask));
+   uint32_t after = hashMatchEmpty(phm->mpCtrl + index);
+   bool wasNeverFull = before && after &&
+      (__builtin_ctz(after) + __builtin_clz(before << 16)) < HASHMAP_GROUP;
+   if (wasNeverFull) {
+      hashSetCtrl(phm, index, HASHMAP_EMPTY);
+      phm->mGrowthLeft++;
+   } else {
+      hashSetCtrl(phm, index, HASHMAP_DELETED);
+      phm->mDeleted++;
+   }
+   phm->mCount--;
+   return success;
+}
+
+//
+// Iteration.
+//
+
+// Returns the first full slot at or after pos, or HM_END.
+uint64_t hashNextFull(const hmap* phm, uint64_t pos)
+{
+   while (pos < phm->mCapacity) {
+      uint32_t full = ~hashMatchFree(phm->mpCtrl + pos) & 0xFFFF;
+      if (full) {
+         pos += __builtin_ctz(full);
+         return (pos < phm->mCapacity ? pos : HM_END);
+      }
+      pos += HASHMAP_GROUP;
+   }
+   return HM_END;
+}
+
+// Returns the position of the first item or HM_END.
+uint64_t hmFirst(chashmap chm)
+{
+   const hmap* phm = (const hmap*)chm;
+   if (!phm) return HM_END;
+   return hashNextFull(phm, 0);
+}
+
+// Returns the position of the item after pos or HM_END.
+uint64_t hmNext(chashmap chm, uint64_t pos)
+{
+   const hmap* phm = (const hmap*)chm;
+   if (!phm || pos >= phm->mCapacity) return HM_END;
+   return hashNextFull(phm, pos + 1);
+}
+
+// Returns the key at pos or null.
+void* hmKeyAt(hashmap hm, uint64_t pos)
+{
+   hmap* phm = (hmap*)hm;
+   if (!phm || pos >= phm->mCapacity || phm->mpCtrl[pos] < 0) return nul;
+   return hashSlot(phm, pos);
+}
+
+// Returns the value at pos or null.
+void* hmValueAt(hashmap hm, uint64_t pos)
+{
+   uint8_t* pKey = (uint8_t*)hmKeyAt(hm, pos);
+   return (pKey ? pKey + ((hmap*)hm)->mValueOffset : nul);
+}
+
+//
+// Default hash function.
+//
+
+// Hashes size bytes at a, 8 at a time.
+uint64_t hmHashBytes(const void* a, uint32_t size)
+{
+   const uint8_t* p = (const uint8_t*)a;
+   uint64_t h = 0x9E3779B97F4A7C15ull ^
+      ((uint64_t)size * 0xC2B2AE3D27D4EB4Full);
+   while (size >= 8) {
+      uint64_t w;
+      memcpy(&w, p, 8);
+      h = (h ^ hashMix(w)) * 0x9FB21C651E98DF25ull;
+      p += 8;
+      size -= 8;
+   }
+   if (size > 0) {
+      uint64_t w = 0;
+      memcpy(&w, p, size);
+      h = (h ^ hashMix(w)) * 0x9FB21C651E98DF25ull;
+   }
+   return hashMix(h);
+}
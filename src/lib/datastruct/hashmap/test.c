@@ -0,0 +1,238 @@
+/*
+Date: 17 Oct 2026 17:58:12.655871402
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_6B1E9D3A0C7F42D58E2A4B1C9F0D7E63__
+Purpose: Tests for hashmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <hashmap.h>
+
+//
+// MACROS
+//
+
+// Keys used by the random operations test.
+#define TEST_KEYS                            5000
+
+//
+// HELPERS
+//
+
+// Compares names (nul terminated within 16 bytes).
+int8_t cmpName(void* a, void* b)
+{
+   int r = strncmp((const char*)a, (const char*)b, 16);
+   return (r < 0 ? -1 : (r > 0 ? 1 : 0));
+}
+
+// Hashes a name up to its terminator.
+uint64_t hashName(const void* a, uint32_t size)
+{
+   return hmHashBytes(a, (uint32_t)strnlen((const char*)a, size));
+}
+
+// A poor hash sending every key to the same group.
+uint64_t hashPoor(const void* a, uint32_t size)
+{
+   return (*(const uint32_t*)a & 0x7F);
+}
+
+//
+// TEST CASES
+//
+
+// Tests put, get and erase against a table of expected values.
+bool testRandom(TFSuite pTest)
+{
+   hasher hashes[] = { nul, hashPoor };
+   for (uint32_t h = 0; h < 2; ++h) {
+      hashmap hm = hmcreatex(sizeof(uint32_t), sizeof(uint64_t), hashes[h],
+         nul);
+      if (false == tfzassert(pTest, hm != null, true, false)) {
+         return false;
+      }
+      tfzassert_ptr(pTest, hmGet(hm, &h), null, false);
+      tfzassert(pTest, hmFirst(hm) == HM_END, true, false);
+
+      // Random operations (the poor hash gets fewer, all collisions).
+      static uint64_t expected[TEST_KEYS];
+      memset(expected, 0, sizeof(expected));
+      uint32_t keys = (h == 0 ? TEST_KEYS : 300);
+      uint64_t seed = 99, count = 0;
+      bool ok = true;
+      for (uint32_t n = 0; n < keys * 20; ++n) {
+         seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+         uint32_t key = (uint32_t)((seed >> 33) % keys);
+         uint64_t value = (seed >> 20) | 1;
+         if ((seed >> 60) < 9) {
+            bool inserted = false;
+            uint64_t* pv = (uint64_t*)hmEmplace(hm, &key, &inserted);
+            if (!pv || inserted != (expected[key] == 0)) ok = false;
+            if (inserted) count++;
+            *pv = value;
+            expected[key] = value;
+         } else {
+            retcode rc = hmErase(hm, &key);
+            if (rc != (expected[key] ? success : fail)) ok = false;
+            if (expected[key]) count--;
+            expected[key] = 0;
+         }
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, hmGetCount(hm) == count, true, false);
+
+      // Every key looked up.
+      ok = true;
+      for (uint32_t key = 0; key < keys; ++key) {
+         uint64_t* pv = (uint64_t*)hmGet(hm, &key);
+         if ((pv ? *pv : 0) != expected[key]) ok = false;
+         if (hmContains(hm, &key) != (expected[key] != 0)) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+
+      // Iteration visits each item once.
+      uint64_t visited = 0;
+      ok = true;
+      for (uint64_t pos = hmFirst(hm); pos != HM_END; pos = hmNext(hm, pos)) {
+         uint32_t key = *(uint32_t*)hmKeyAt(hm, pos);
+         if (expected[key] != *(uint64_t*)hmValueAt(hm, pos)) ok = false;
+         visited++;
+      }
+      tfzassert(pTest, ok, true, false);
+      tfzassert(pTest, visited == count, true, false);
+
+      // Shrinking drops tombstones and keeps the items.
+      hmShrink(hm);
+      tfzassert(pTest, hmGetCount(hm) == count, true, false);
+      ok = true;
+      for (uint32_t key = 0; key < keys; ++key) {
+         uint64_t* pv = (uint64_t*)hmGet(hm, &key);
+         if ((pv ? *pv : 0) != expected[key]) ok = false;
+      }
+      tfzassert(pTest, ok, true, false);
+
+      hmdestroy(&hm);
+      tfzassert_ptr(pTest, hm, null, false);
+   }
+
+   // Success.
+   return true;
+}
+
+// Tests capacity management and custom keys.
+bool testCapacity(TFSuite pTest)
+{
+   tfzassert_ptr(pTest, hmcreate(0, 4), null, false);
+   hashmap hm = hmcreate(sizeof(uint64_t), 0);
+   if (false == tfzassert(pTest, hm != null, true, false)) {
+      return false;
+   }
+
+   // Reserve then fill without growing.
+   tfzassert(pTest, hmSetMaxLoad(hm, 0.1), fail, false);
+   tfzassert(pTest, hmSetMaxLoad(hm, 0.5), success, false);
+   tfzassert(pTest, hmReserve(hm, 1000), success, false);
+   uint64_t capacity = hmGetCapacity(hm);
+   tfzassert(pTest, capacity == 2048, true, false);
+   for (uint64_t key = 0; key < 1000; ++key) hmPut(hm, &key, null);
+   tfzassert(pTest, hmGetCapacity(hm) == capacity, true, false);
+
+   // Erase and insert churn does not grow the table.
+   tfzassert(pTest, hmSetMaxLoad(hm, 0.9), success, false);
+   for (uint64_t key = 1000; key < 100000; ++key) {
+      uint64_t old = key - 1000;
+      hmErase(hm, &old);
+      hmPut(hm, &key, null);
+   }
+   tfzassert(pTest, hmGetCapacity(hm) == capacity, true, false);
+   tfzassert(pTest, hmGetCount(hm) == 1000, true, false);
+
+   // The raised load factor allows more items in the same table.
+   for (uint64_t key = 100000; key < 100800; ++key) hmPut(hm, &key, null);
+   tfzassert(pTest, hmGetCapacity(hm) == capacity, true, false);
+   tfzassert(pTest, hmGetCount(hm) == 1800, true, false);
+
+   // Clear keeps the table; shrink frees it.
+   hmClear(hm);
+   tfzassert(pTest, hmGetCount(hm) == 0, true, false);
+   tfzassert(pTest, hmGetCapacity(hm) == capacity, true, false);
+   hmShrink(hm);
+   tfzassert(pTest, hmGetCapacity(hm) == 0, true, false);
+   hmdestroy(&hm);
+
+   // Names with their own hash and comparator.
+   hm = hmcreatex(16, sizeof(uint32_t), hashName, cmpName);
+   if (false == tfzassert(pTest, hm != null, true, false)) {
+      return false;
+   }
+   char name[16];
+   memset(name, 'x', sizeof(name));
+   strcpy(name, "alpha");
+   uint32_t value = 1;
+   hmPut(hm, name, &value);
+   char other[16] = "alpha";
+   tfzassert(pTest, hmGet(hm, other) != null, true, false);
+   tfzassert_ui32(pTest, *(uint32_t*)hmGet(hm, other), 1, false);
+   strcpy(other, "beta");
+   tfzassert_ptr(pTest, hmGet(hm, other), null, false);
+
+   // Success.
+   hmdestroy(&hm);
+   return tfzassert_ptr(pTest, hm, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("hashmap tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testRandom(tfz);
+   testCapacity(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
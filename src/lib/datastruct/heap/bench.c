@@ -0,0 +1,192 @@
+/*
+Date: 17 Oct 2026 17:21:40.146027718
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_4F0C9B2E7A1D5836C2F9E04B1D7A6C53__
+Purpose: Benchmarks for heap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (push/pop vs re-sort)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+#include <heap.h>
+
+//
+// TYPES
+//
+
+// A scheduled task, ordered by due time.
+typedef struct _task {
+   uint64_t mDue;
+   uint64_t mId;
+} task;
+
+//
+// MACROS
+//
+
+// Largest power of ten benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 6
+// Pop/push operations timed on the heaps.
+#define BENCH_HEAP_OPS                       2000000
+// Operations timed on the re-sorted vector (and the largest size tried).
+#define BENCH_RESORT_OPS                     1000
+#define BENCH_RESORT_MAXCOUNT                10000
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Orders tasks by due time.
+int8_t cmpDue(void* a, void* b)
+{
+   uint64_t x = ((task*)a)->mDue, y = ((task*)b)->mDue;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// Orders tasks by due time, latest first (the soonest is last in a sorted
+// vector so it can be popped from the back).
+int8_t cmpDueReverse(void* a, void* b)
+{
+   return cmpDue(b, a);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+//
+// BENCHMARKS
+//
+
+// Scheduler loop on a sorted vector re-sorted after each insert (the way
+// queues were kept before). Returns million operations per second.
+double benchResort(uint32_t count, uint32_t ops, uint64_t* pCheck)
+{
+   cvector v = cvcreate(sizeof(task));
+   if (!v) return 0;
+
+   uint64_t seed = 88172645463325252ull;
+   for (uint32_t n = 0; n < count; ++n) {
+      task t = { benchRandom(&seed) % 1000000, n };
+      cvPushBack(v, makecvitem(t));
+   }
+   cvSort(v, cmpDueReverse);
+
+   // Take the soonest task and schedule it again later.
+   double start = benchNow();
+   for (uint32_t n = 0; n < ops; ++n) {
+      task t = *(task*)cvAt(v, cvCount(v) - 1);
+      cvPopBack(v);
+      *pCheck += t.mDue;
+      t.mDue += benchRandom(&seed) % 1000000;
+      cvPushBack(v, makecvitem(t));
+      cvSort(v, cmpDueReverse);
+   }
+   double elapsed = benchNow() - start;
+
+   cvdestroy(&v);
+   return ops / elapsed / 1e6;
+}
+
+// Same scheduler loop on a heap. Returns million operations per second.
+double benchHeap(uint32_t count, uint32_t ops, uint32_t flags,
+   uint64_t* pCheck)
+{
+   heap h = hpcreatex(sizeof(task), cmpDue, flags);
+   if (!h) return 0;
+
+   uint64_t seed = 88172645463325252ull;
+   for (uint32_t n = 0; n < count; ++n) {
+      task t = { benchRandom(&seed) % 1000000, n };
+      hpPush(h, &t, null);
+   }
+
+   double start = benchNow();
+   for (uint32_t n = 0; n < ops; ++n) {
+      task t;
+      hpPop(h, &t);
+      *pCheck += t.mDue;
+      t.mDue += benchRandom(&seed) % 1000000;
+      hpPush(h, &t, null);
+   }
+   double elapsed = benchNow() - start;
+
+   hpdestroy(&h);
+   return ops / elapsed / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 2) maxExp = 2;
+   if (maxExp > 7) maxExp = 7;
+
+   // Pop the soonest task and push it back later (million ops per second).
+   printf("%12s %10s %10s %10s\n", "tasks", "re-sort", "binary", "4-ary");
+   uint32_t count = 100;
+   for (int exp = 2; exp <= maxExp; ++exp, count *= 10) {
+      uint64_t checks[3] = { 0 };
+      double binary = benchHeap(count, BENCH_HEAP_OPS, hpfnone, &checks[1]);
+      double quaternary =
+         benchHeap(count, BENCH_HEAP_OPS, hpfquaternary, &checks[2]);
+      if (count <= BENCH_RESORT_MAXCOUNT) {
+         uint64_t check = 0;
+         double resort = benchResort(count, BENCH_RESORT_OPS, &checks[0]);
+         benchHeap(count, BENCH_RESORT_OPS, hpfnone, &check);
+         printf("%12" PRIu32 " %10.3f %10.2f %10.2f %s\n", count, resort,
+            binary, quaternary,
+            (checks[0] == check && checks[1] == checks[2] ? "" : "(mismatch!)")
+         );
+      } else {
+         printf("%12" PRIu32 " %10s %10.2f %10.2f %s\n", count, "-",
+            binary, quaternary, (checks[1] == checks[2] ? "" : "(mismatch!)")
+         );
+      }
+   }
+
+   return 0;
+}
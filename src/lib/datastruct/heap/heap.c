@@ -0,0 +1,476 @@
+/*
+Date: 17 Oct 2026 17:21:40.102958431
+File: heap.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __HEAP_C_71B4D09E2F6A4C38B0E5D17A9C3F6E82__
+Purpose: Implements a binary (or 4-ary) heap priority queue stored in a
+         vector. The smallest item according to the comparator given is
+         always at the top. Items can optionally be tracked by handles so
+         they can be updated or removed while in the heap.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <heap.h>
+
+//
+// STRUCTS
+//
+
+// Items are kept in heap order in mItems. With handles, mSlots holds the
+// handle of each item and mPositions the item index of each handle (or
+// HP_NOHANDLE for handles in mFree). mFree always has room for every handle
+// so releasing one never allocates. Sifting moves items into a hole rather
+// than swapping them, using mpTemp for the item being placed.
+typedef struct _heapq {
+   uint32_t mItemSize;                             // size of each item
+   uint32_t mArity;                                // children per node
+   uint32_t mFlags;                                // hpflags
+   comparator mCmp;                                // item order
+   cvector mItems;                                 // items in heap order
+   cvector mSlots;                                 // handle of each item
+   cvector mPositions;                             // item of each handle
+   cvector mFree;                                  // released handles
+   void* mpTemp;                                   // one item (follows struct)
+} heapq;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new binary heap. Initially the heap will be empty. No memory will
+// be allocated for items unless necessary.
+heap hpcreate(uint32_t itemSize, comparator cmp)
+{
+   return hpcreatex(itemSize, cmp, hpfnone);
+}
+
+// Create a new heap with hpflags.
+heap hpcreatex(uint32_t itemSize, comparator cmp, uint32_t flags)
+{
+   if (itemSize == 0 || !cmp) return nul;
+
+   // Heap and scratch item in one allocation.
+   heapq* ph = (heapq*)malloc(sizeof(heapq) + itemSize);
+   if (!ph) return nul;
+   memset(ph, 0, sizeof(heapq));
+
+   ph->mItemSize = itemSize;
+   ph->mArity = ((flags & hpfquaternary) ? 4 : 2);
+   ph->mFlags = flags;
+   ph->mCmp = cmp;
+   ph->mpTemp = (void*)(ph + 1);
+
+   // Create the vectors.
+   bool ok = (nul != (ph->mItems = cvcreate(itemSize)));
+   if (ok && (flags & hpfhandles)) {
+      ok = (nul != (ph->mSlots = cvcreate(sizeof(hphandle)))) &&
+         (nul != (ph->mPositions = cvcreate(sizeof(uint64_t)))) &&
+         (nul != (ph->mFree = cvcreate(sizeof(hphandle))));
+   }
+   if (!ok) {
+      heap h = (heap)ph;
+      hpdestroy(&h);
+      return nul;
+   }
+
+   // Done.
+   return (heap)ph;
+}
+
+// Destroy existing heap.
+void hpdestroy(heap* php)
+{
+   if (nul == php) return;
+   if (nul == (*php)) return;
+
+   heapq* h = (heapq*)*php;
+   cvdestroy(&h->mItems);
+   cvdestroy(&h->mSlots);
+   cvdestroy(&h->mPositions);
+   cvdestroy(&h->mFree);
+
+   free(*php);
+   *php = 0;
+}
+
+//
+// Private API - Ordering.
+//
+
+// Returns item index.
+void* heapItem(heapq* ph, uint64_t index)
+{
+   return cvData(ph->mItems) + ((size_t)index * ph->mItemSize);
+}
+
+// Copies item pSrc with handle to index.
+void heapPlace(heapq* ph, uint64_t index, const void* pSrc, hphandle handle)
+{
+   memcpy(heapItem(ph, index), pSrc, ph->mItemSize);
+   if (ph->mFlags & hpfhandles) {
+      ((hphandle*)cvData(ph->mSlots))[index] = handle;
+      ((uint64_t*)cvData(ph->mPositions))[handle] = index;
+   }
+}
+
+// Returns the handle of item index.
+hphandle heapHandle(heapq* ph, uint64_t index)
+{
+   if (!(ph->mFlags & hpfhandles)) return HP_NOHANDLE;
+   return ((hphandle*)cvData(ph->mSlots))[index];
+}
+
+// Moves item index up until its parent is not larger.
+void heapSiftUp(heapq* ph, uint64_t index)
+{
+   if (index == 0) return;
+
+   hphandle handle = heapHandle(ph, index);
+   memcpy(ph->mpTemp, heapItem(ph, index), ph->mItemSize);
+   while (index > 0) {
+      uint64_t parent = (index - 1) / ph->mArity;
+      void* pParent = heapItem(ph, parent);
+      if (ph->mCmp(ph->mpTemp, pParent) >= 0) break;
+      heapPlace(ph, index, pParent, heapHandle(ph, parent));
+      index = parent;
+   }
+   heapPlace(ph, index, ph->mpTemp, handle);
+}
+
+// Moves item index down until no child is smaller.
+void heapSiftDown(heapq* ph, uint64_t index)
+{
+   uint64_t count = cvCount(ph->mItems);
+   hphandle handle = heapHandle(ph, index);
+   memcpy(ph->mpTemp, heapItem(ph, index), ph->mItemSize);
+   for (;;) {
+      uint64_t first = (index * ph->mArity) + 1;
+      if (first >= count) break;
+
+      // Smallest child.
+      uint64_t last = first + ph->mArity;
+      if (last > count) last = count;
+      uint64_t child = first;
+      void* pChild = heapItem(ph, first);
+      for (uint64_t c = first + 1; c < last; ++c) {
+         void* pItem = heapItem(ph, c);
+         if (ph->mCmp(pItem, pChild) < 0) {
+            child = c;
+            pChild = pItem;
+         }
+      }
+
+      if (ph->mCmp(pChild, ph->mpTemp) >= 0) break;
+      heapPlace(ph, index, pChild, heapHandle(ph, child));
+      index = child;
+   }
+   heapPlace(ph, index, ph->mpTemp, handle);
+}
+
+// Moves item index up or down to its place.
+void heapResift(heapq* ph, uint64_t index)
+{
+   if (index > 0 && ph->mCmp(heapItem(ph, index),
+      heapItem(ph, (index - 1) / ph->mArity)) < 0) {
+      heapSiftUp(ph, index);
+   } else {
+      heapSiftDown(ph, index);
+   }
+}
+
+//
+// Private API - Handles.
+//
+
+// Returns item index of handle or HP_NOHANDLE if handle is not in use.
+uint64_t heapPosition(heapq* ph, hphandle handle)
+{
+   if (!(ph->mFlags & hpfhandles)) return HP_NOHANDLE;
+   if (handle >= cvCount(ph->mPositions)) return HP_NOHANDLE;
+   return ((uint64_t*)cvData(ph->mPositions))[handle];
+}
+
+// Returns an unused handle or HP_NOHANDLE on failure.
+hphandle heapNewHandle(heapq* ph)
+{
+   uint64_t freeCount = cvCount(ph->mFree);
+   if (freeCount > 0) {
+      hphandle handle = ((hphandle*)cvData(ph->mFree))[freeCount - 1];
+      cvPopBack(ph->mFree);
+      return handle;
+   }
+
+   hphandle handle = cvCount(ph->mPositions);
+   uint64_t position = HP_NOHANDLE;
+   if (!cvPushBack(ph->mPositions, makecvitem(position))) return HP_NOHANDLE;
+
+   // The free list always has room for every handle so freeing cannot fail.
+   if (cvGetSize(ph->mFree) < cvCount(ph->mPositions) &&
+      fail == cvReserve(ph->mFree, cvGetSize(ph->mPositions))) {
+      cvPopBack(ph->mPositions);
+      return HP_NOHANDLE;
+   }
+   return handle;
+}
+
+// Releases handle for reuse. The free list has room for all handles (see
+// heapNewHandle) so this does not allocate.
+void heapFreeHandle(heapq* ph, hphandle handle)
+{
+   ((uint64_t*)cvData(ph->mPositions))[handle] = HP_NOHANDLE;
+   cvPushBack(ph->mFree, makecvitem(handle));
+}
+
+// Removes item index, filling its place with the last item.
+void heapRemoveAt(heapq* ph, uint64_t index)
+{
+   if (ph->mFlags & hpfhandles) heapFreeHandle(ph, heapHandle(ph, index));
+
+   uint64_t last = cvCount(ph->mItems) - 1;
+   if (index < last) {
+      heapPlace(ph, index, heapItem(ph, last), heapHandle(ph, last));
+   }
+   cvPopBack(ph->mItems);
+   if (ph->mFlags & hpfhandles) cvPopBack(ph->mSlots);
+   if (index < last) heapResift(ph, index);
+}
+
+//
+// Item management.
+//
+
+// Returns the number of items in the heap.
+uint64_t hpGetCount(cheap ch)
+{
+   const heapq* ph = (const heapq*)ch;
+   return (ph ? cvCount(ph->mItems) : 0);
+}
+
+// Sets the growth policy of the item vector and the handle vectors (see
+// cvSetGrowthPolicy).
+retcode hpSetGrowthPolicy(heap h, cvgrowth policy, uint32_t param)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return fail;
+
+   if (fail == cvSetGrowthPolicy(ph->mItems, policy, param)) return fail;
+   if (ph->mFlags & hpfhandles) {
+      if (fail == cvSetGrowthPolicy(ph->mSlots, policy, param)) return fail;
+      if (fail == cvSetGrowthPolicy(ph->mPositions, policy, param)) {
+         return fail;
+      }
+      return cvSetGrowthPolicy(ph->mFree, policy, param);
+   }
+   return success;
+}
+
+// Reserve itemCount items in the heap.
+retcode hpReserve(heap h, uint64_t itemCount)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return fail;
+
+   if (fail == cvReserve(ph->mItems, itemCount)) return fail;
+   if (ph->mFlags & hpfhandles) {
+      if (fail == cvReserve(ph->mSlots, itemCount)) return fail;
+      if (fail == cvReserve(ph->mPositions, itemCount)) return fail;
+      if (fail == cvReserve(ph->mFree, itemCount)) return fail;
+   }
+   return success;
+}
+
+// Adds an item to the heap.
+retcode hpPush(heap h, ccvitem item, hphandle* pHandle)
+{
+   return hpPushN(h, item, 1, pHandle);
+}
+
+// Adds count items (stored contiguously at items) to the heap. Either all
+// items are added or none.
+retcode hpPushN(heap h, ccvitem items, uint64_t count, hphandle* pHandles)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph || !items || count == 0) return fail;
+
+   // Room for the items (and their handles).
+   uint64_t first = cvCount(ph->mItems);
+   void* pDst = cvEmplaceBackN(ph->mItems, count);
+   if (!pDst) return fail;
+   if (ph->mFlags & hpfhandles) {
+      uint64_t handles = cvCount(ph->mPositions) + count;
+      bool ok = (nul != cvEmplaceBackN(ph->mSlots, count)) &&
+         (success == cvReserve(ph->mPositions, handles)) &&
+         (success == cvReserve(ph->mFree, handles));
+      if (!ok) {
+         cvEraseRange(ph->mItems, first, count);
+         if (cvCount(ph->mSlots) > first) {
+            cvEraseRange(ph->mSlots, first, count);
+         }
+         return fail;
+      }
+   }
+   memcpy(pDst, items, (size_t)count * ph->mItemSize);
+
+   // Handles cannot fail now that positions have room.
+   for (uint64_t n = 0; n < count; ++n) {
+      hphandle handle = HP_NOHANDLE;
+      if (ph->mFlags & hpfhandles) {
+         handle = heapNewHandle(ph);
+         ((hphandle*)cvData(ph->mSlots))[first + n] = handle;
+         ((uint64_t*)cvData(ph->mPositions))[handle] = first + n;
+      }
+      if (pHandles) pHandles[n] = handle;
+   }
+
+   // Many items are cheaper to heapify bottom up than to sift up one by one.
+   uint64_t total = first + count;
+   if (count > first) {
+      uint64_t parents = (total + ph->mArity - 2) / ph->mArity;
+      for (uint64_t n = parents; n-- > 0;) {
+         heapSiftDown(ph, n);
+      }
+   } else {
+      for (uint64_t n = first; n < total; ++n) {
+         heapSiftUp(ph, n);
+      }
+   }
+
+   // Done.
+   return success;
+}
+
+// Returns the top (smallest) item or null if empty.
+void* hpPeek(cheap ch)
+{
+   heapq* ph = (heapq*)ch;
+   if (!ph || cvCount(ph->mItems) == 0) return nul;
+   return cvData(ph->mItems);
+}
+
+// Removes the top item, copying it to pItem if given.
+retcode hpPop(heap h, cvitem pItem)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph || cvCount(ph->mItems) == 0) return fail;
+
+   if (pItem) memcpy(pItem, cvData(ph->mItems), ph->mItemSize);
+   heapRemoveAt(ph, 0);
+   return success;
+}
+
+// Removes all items (all handles become invalid).
+void hpClear(heap h)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return;
+
+   cvClear(ph->mItems);
+   if (ph->mFlags & hpfhandles) {
+      cvClear(ph->mSlots);
+      cvClear(ph->mPositions);
+      cvClear(ph->mFree);
+   }
+}
+
+// Frees memory not needed for the items held.
+void hpShrink(heap h)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return;
+
+   cvShrink(ph->mItems);
+   if (ph->mFlags & hpfhandles) {
+      cvShrink(ph->mSlots);
+      cvShrink(ph->mPositions);
+      // mFree is left with room for every handle (see heapNewHandle).
+   }
+}
+
+//
+// Handles.
+//
+
+// Returns the item of handle or null.
+void* hpGetItem(heap h, hphandle handle)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return nul;
+
+   uint64_t index = heapPosition(ph, handle);
+   if (index == HP_NOHANDLE) return nul;
+   return heapItem(ph, index);
+}
+
+// Replaces the item of handle with a smaller (or equal) item.
+retcode hpDecreaseKey(heap h, hphandle handle, ccvitem item)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph || !item) return fail;
+
+   uint64_t index = heapPosition(ph, handle);
+   if (index == HP_NOHANDLE) return fail;
+   if (ph->mCmp((void*)item, heapItem(ph, index)) > 0) return fail;
+
+   memcpy(heapItem(ph, index), item, ph->mItemSize);
+   heapSiftUp(ph, index);
+   return success;
+}
+
+// Replaces the item of handle.
+retcode hpUpdate(heap h, hphandle handle, ccvitem item)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph || !item) return fail;
+
+   uint64_t index = heapPosition(ph, handle);
+   if (index == HP_NOHANDLE) return fail;
+
+   memcpy(heapItem(ph, index), item, ph->mItemSize);
+   heapResift(ph, index);
+   return success;
+}
+
+// Removes the item of handle, copying it to pItem if given.
+retcode hpRemove(heap h, hphandle handle, cvitem pItem)
+{
+   heapq* ph = (heapq*)h;
+   if (!ph) return fail;
+
+   uint64_t index = heapPosition(ph, handle);
+   if (index == HP_NOHANDLE) return fail;
+
+   if (pItem) memcpy(pItem, heapItem(ph, index), ph->mItemSize);
+   heapRemoveAt(ph, index);
+   return success;
+}
@@ -0,0 +1,241 @@
+/*
+Date: 17 Oct 2026 17:21:40.131582094
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_A5D2C7E19F0B43865D1E7A2C4B9F0D36__
+Purpose: Tests for heap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <heap.h>
+
+//
+// TYPES
+//
+
+// A task in the heap tests, ordered by priority.
+typedef struct _task {
+   uint32_t mPriority;
+   uint32_t mId;
+} task;
+
+//
+// HELPERS
+//
+
+// Orders tasks by priority.
+int8_t cmpTask(void* a, void* b)
+{
+   uint32_t x = ((task*)a)->mPriority, y = ((task*)b)->mPriority;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// Pops every task and checks they come out in order. Returns the number
+// popped or -1 if out of order.
+int64_t drainInOrder(heap h)
+{
+   int64_t popped = 0;
+   uint32_t last = 0;
+   task t;
+   while (success == hpPop(h, &t)) {
+      if (t.mPriority < last) return -1;
+      last = t.mPriority;
+      popped++;
+   }
+   return popped;
+}
+
+//
+// TEST CASES
+//
+
+// Tests push, peek and pop on both layouts.
+bool testOrder(TFSuite pTest)
+{
+   uint32_t flags[] = { hpfnone, hpfquaternary };
+   tfzassert_ptr(pTest, hpcreate(0, cmpTask), null, false);
+   tfzassert_ptr(pTest, hpcreate(sizeof(task), null), null, false);
+
+   for (uint32_t f = 0; f < 2; ++f) {
+      heap h = hpcreatex(sizeof(task), cmpTask, flags[f]);
+      if (false == tfzassert(pTest, h != null, true, false)) {
+         return false;
+      }
+      tfzassert_ptr(pTest, hpPeek(h), null, false);
+      tfzassert(pTest, hpPop(h, null), fail, false);
+
+      // One at a time, pseudo random priorities.
+      uint64_t seed = 7;
+      uint32_t smallest = (uint32_t)-1;
+      hphandle handle = 0;
+      for (uint32_t n = 0; n < 1000; ++n) {
+         seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+         task t = { (uint32_t)(seed >> 40), n };
+         if (t.mPriority < smallest) smallest = t.mPriority;
+         tfzassert(pTest, hpPush(h, &t, &handle), success, true);
+      }
+      tfzassert(pTest, handle == HP_NOHANDLE, true, false);
+      tfzassert(pTest, hpGetCount(h) == 1000, true, false);
+      tfzassert(pTest, ((task*)hpPeek(h))->mPriority == smallest, true, false);
+      tfzassert(pTest, drainInOrder(h) == 1000, true, false);
+
+      // In bulk (heapify), then bulk onto a larger heap (sift up).
+      task tasks[500];
+      for (uint32_t n = 0; n < 500; ++n) {
+         tasks[n].mPriority = (n * 7919) % 500;
+         tasks[n].mId = n;
+      }
+      tfzassert(pTest, hpPushN(h, tasks, 400, null), success, false);
+      tfzassert(pTest, hpPushN(h, &tasks[400], 100, null), success, false);
+      tfzassert(pTest, ((task*)hpPeek(h))->mPriority == 0, true, false);
+      tfzassert(pTest, drainInOrder(h) == 500, true, false);
+
+      // Clear and shrink.
+      hpPushN(h, tasks, 500, null);
+      hpClear(h);
+      hpShrink(h);
+      tfzassert(pTest, hpGetCount(h) == 0, true, false);
+
+      hpdestroy(&h);
+      tfzassert_ptr(pTest, h, null, false);
+   }
+
+   // Success.
+   return true;
+}
+
+// Tests handles: decrease key, update and remove.
+bool testHandles(TFSuite pTest)
+{
+   heap h = hpcreatex(sizeof(task), cmpTask, hpfhandles | hpfquaternary);
+   if (false == tfzassert(pTest, h != null, true, false)) {
+      return false;
+   }
+
+   // Handles follow their items around the heap.
+   task tasks[200];
+   hphandle handles[200];
+   for (uint32_t n = 0; n < 200; ++n) {
+      tasks[n].mPriority = 1000 + ((n * 37) % 200);
+      tasks[n].mId = n;
+   }
+   tfzassert(pTest, hpPushN(h, tasks, 200, handles), success, false);
+   bool ok = true;
+   for (uint32_t n = 0; n < 200; ++n) {
+      task* pt = (task*)hpGetItem(h, handles[n]);
+      if (!pt || pt->mId != n) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // Decrease key brings an item to the top; increasing fails.
+   task t = { 5, 150 };
+   tfzassert(pTest, hpDecreaseKey(h, handles[150], &t), success, false);
+   tfzassert(pTest, ((task*)hpPeek(h))->mId == 150, true, false);
+   t.mPriority = 6;
+   tfzassert(pTest, hpDecreaseKey(h, handles[150], &t), fail, false);
+
+   // Update moves an item down.
+   t.mPriority = 5000;
+   tfzassert(pTest, hpUpdate(h, handles[150], &t), success, false);
+   tfzassert(pTest, ((task*)hpPeek(h))->mId != 150, true, false);
+
+   // Remove by handle; the handle is then invalid.
+   tfzassert(pTest, hpRemove(h, handles[150], &t), success, false);
+   tfzassert(pTest, t.mPriority == 5000, true, false);
+   tfzassert_ptr(pTest, hpGetItem(h, handles[150]), null, false);
+   tfzassert(pTest, hpRemove(h, handles[150], null), fail, false);
+   tfzassert(pTest, hpRemove(h, handles[20], null), success, false);
+   tfzassert(pTest, hpGetCount(h) == 198, true, false);
+
+   // Handles are still right after pops and reuse.
+   hpPop(h, null);
+   t.mPriority = 1;
+   t.mId = 999;
+   hphandle reused = HP_NOHANDLE;
+   tfzassert(pTest, hpPush(h, &t, &reused), success, false);
+   tfzassert(pTest, ((task*)hpGetItem(h, reused))->mId == 999, true, false);
+   ok = true;
+   for (uint32_t n = 0; n < 200; ++n) {
+      task* pt = (task*)hpGetItem(h, handles[n]);
+      if (pt && pt->mId != n && handles[n] != reused) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, drainInOrder(h) == 198, true, false);
+
+   // Handles are reused after shrinking and with any growth policy.
+   tfzassert(pTest, hpSetGrowthPolicy(h, cvgrowfixed, 16), success, false);
+   hpShrink(h);
+   for (uint32_t n = 0; n < 300; ++n) {
+      t.mPriority = n;
+      t.mId = n;
+      hpPush(h, &t, &handles[n % 200]);
+   }
+   ok = true;
+   for (uint32_t n = 100; n < 300; ++n) {
+      task* pt = (task*)hpGetItem(h, handles[n % 200]);
+      if (!pt || pt->mId != n) ok = false;
+      if (fail == hpRemove(h, handles[n % 200], null)) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, hpGetCount(h) == 100, true, false);
+   hpShrink(h);
+   tfzassert(pTest, drainInOrder(h) == 100, true, false);
+
+   // Success.
+   hpdestroy(&h);
+   return tfzassert_ptr(pTest, h, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("heap tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testOrder(tfz);
+   testHandles(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
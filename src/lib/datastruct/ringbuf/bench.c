@@ -0,0 +1,149 @@
+/*
+Date: 17 Oct 2026 19:21:06.529163840
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_7E2A0D5C9B3F41868A1D4E7C0F3B9A52__
+Purpose: Benchmarks for ringbuf.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (FIFO throughput)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <ringbuf.h>
+
+//
+// MACROS
+//
+
+// Largest power of ten queue depth benchmarked unless given on the command
+// line.
+#define BENCH_DEFAULT_MAXEXP                 5
+// Dequeue/enqueue pairs timed on the ring buffer.
+#define BENCH_RING_OPS                       10000000
+// Pairs timed on the vector used as a FIFO (it shifts on every dequeue).
+#define BENCH_VECTOR_OPS                     20000
+// Items moved per batch with spans.
+#define BENCH_BATCH                          256
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+//
+// BENCHMARKS
+//
+
+// Times a queue held at depth items, each step dequeuing the oldest item and
+// enqueuing a new one: a vector shifting down after cvGetAt(0), the ring
+// buffer one item at a time and the ring buffer in batches through spans.
+void benchFifo(uint64_t depth)
+{
+   cvector v = cvcreate(sizeof(uint64_t));
+   ringbuf rb = rbcreate(sizeof(uint64_t), depth + BENCH_BATCH);
+   if (!v || !rb) {
+      cvdestroy(&v);
+      rbdestroy(&rb);
+      return;
+   }
+   uint64_t sums[3] = { 0 };
+
+   // Vector used as a FIFO.
+   for (uint64_t n = 0; n < depth; ++n) cvPushBack(v, &n);
+   double start = benchNow();
+   for (uint64_t n = depth; n < depth + BENCH_VECTOR_OPS; ++n) {
+      sums[0] += *(uint64_t*)cvGetAt(v, 0);
+      cvEraseAt(v, 0);
+      cvPushBack(v, &n);
+   }
+   double vectorRate = BENCH_VECTOR_OPS / (benchNow() - start) / 1e6;
+
+   // Ring buffer, one item at a time.
+   for (uint64_t n = 0; n < depth; ++n) rbPush(rb, &n);
+   start = benchNow();
+   for (uint64_t n = depth; n < depth + BENCH_RING_OPS; ++n) {
+      uint64_t item;
+      rbPop(rb, &item);
+      sums[1] += item;
+      rbPush(rb, &n);
+   }
+   double ringRate = BENCH_RING_OPS / (benchNow() - start) / 1e6;
+
+   // Ring buffer in batches, processed in place.
+   rbClear(rb);
+   for (uint64_t n = 0; n < depth; ++n) rbPush(rb, &n);
+   uint64_t next = depth;
+   start = benchNow();
+   for (uint64_t n = 0; n < BENCH_RING_OPS; ) {
+      cvspan first, second;
+      uint64_t read = rbReadSpans(rb, BENCH_BATCH, &first, &second);
+      cvforeach(uint64_t, p, first) sums[2] += *p;
+      cvforeach(uint64_t, p, second) sums[2] += *p;
+      rbConsume(rb, read);
+
+      uint64_t written = rbWriteSpans(rb, read, &first, &second);
+      cvforeach(uint64_t, p, first) *p = next++;
+      cvforeach(uint64_t, p, second) *p = next++;
+      rbCommit(rb, written);
+      n += read;
+   }
+   double batchRate = BENCH_RING_OPS / (benchNow() - start) / 1e6;
+
+   printf("%10" PRIu64 " %12.2f %12.2f %12.2f %" PRIu64 "\n", depth,
+      vectorRate, ringRate, batchRate, (sums[0] + sums[1] + sums[2]) & 1
+   );
+
+   cvdestroy(&v);
+   rbdestroy(&rb);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 1) maxExp = 1;
+   if (maxExp > 7) maxExp = 7;
+
+   // Million dequeue/enqueue pairs per second (the last column keeps the
+   // sums alive).
+   printf("%10s %12s %12s %12s\n", "depth", "vector", "ring", "ring spans");
+   uint64_t depth = 10;
+   for (int exp = 1; exp <= maxExp; ++exp, depth *= 10) benchFifo(depth);
+
+   return 0;
+}
@@ -0,0 +1,386 @@
+/*
+Date: 17 Oct 2026 19:21:06.497301258
+File: ringbuf.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __RINGBUF_C_9A3E6C1F0B7D42584C8E1A9F3D0B6E27__
+Purpose: Implements a ring buffer (bounded FIFO queue) over vector storage.
+         Positions are free running counters masked by the power of two
+         capacity, so pushing and popping never move items.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <ringbuf.h>
+
+//
+// MACROS
+//
+#define RINGBUF_DEFAULTCAPACITY              16
+#define RINGBUF_MAXCAPACITY                  ((uint64_t)1 << 62)
+
+//
+// STRUCTS
+//
+
+// Every item of mItems is a slot, so its count is the capacity. mHead and
+// mTail count the items ever popped and pushed; they only ever increase and
+// are masked into slots (tail - head is the item count).
+typedef struct _ring {
+   uint32_t mItemSize;                             // size of each item
+   uint32_t mFlags;                                // rbflags
+   uint64_t mMask;                                 // capacity - 1
+   uint64_t mHead;                                 // position of oldest item
+   uint64_t mTail;                                 // position of next item
+   cvector mItems;                                 // slots
+} ring;
+
+//
+// PROTOTYPES
+//
+uint64_t ringCapacity(uint64_t itemCount);
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new bounded ring buffer for capacity items (rounded up to a power
+// of two).
+ringbuf rbcreate(uint32_t itemSize, uint64_t capacity)
+{
+   return rbcreatex(itemSize, capacity, rbfnone);
+}
+
+// Create a new ring buffer with rbflags.
+ringbuf rbcreatex(uint32_t itemSize, uint64_t capacity, uint32_t flags)
+{
+   if (itemSize == 0) return nul;
+   if (capacity == 0) capacity = RINGBUF_DEFAULTCAPACITY;
+   capacity = ringCapacity(capacity);
+   if (capacity == 0) return nul;
+
+   ring* pr = (ring*)malloc(sizeof(ring));
+   if (!pr) return nul;
+   memset(pr, 0, sizeof(ring));
+
+   pr->mItemSize = itemSize;
+   pr->mFlags = flags;
+   pr->mMask = capacity - 1;
+
+   // Slots are overwritten before they are read; never scrub them.
+   pr->mItems = cvcreatex(itemSize, cvfnoscrub);
+   if (!pr->mItems || !cvEmplaceBackN(pr->mItems, capacity)) {
+      ringbuf rb = (ringbuf)pr;
+      rbdestroy(&rb);
+      return nul;
+   }
+
+   // Done.
+   return (ringbuf)pr;
+}
+
+// Destroy existing ring buffer.
+void rbdestroy(ringbuf* prb)
+{
+   if (nul == prb) return;
+   if (nul == (*prb)) return;
+
+   ring* r = (ring*)*prb;
+   cvdestroy(&r->mItems);
+
+   free(*prb);
+   *prb = 0;
+}
+
+//
+// Private API - Slots.
+//
+
+// Returns the smallest power of two capacity holding itemCount items (0 if
+// there is none).
+uint64_t ringCapacity(uint64_t itemCount)
+{
+   if (itemCount > RINGBUF_MAXCAPACITY) return 0;
+   if (itemCount <= 1) return 1;
+   return (uint64_t)1 << (64 - __builtin_clzll(itemCount - 1));
+}
+
+// Returns the slot of position pos.
+void* ringSlot(ring* pr, uint64_t pos)
+{
+   return (uint8_t*)cvData(pr->mItems) + ((size_t)(pos & pr->mMask) *
+      pr->mItemSize
+   );
+}
+
+// Grows the slots to capacity (a larger power of two). Items that wrapped
+// past the old end move to follow it so that they stay in order under the
+// new mask.
+retcode ringGrow(ring* pr, uint64_t capacity)
+{
+   uint64_t oldCapacity = pr->mMask + 1;
+   if (capacity <= oldCapacity) return success;
+
+   if (!cvEmplaceBackN(pr->mItems, capacity - oldCapacity)) return fail;
+
+   uint64_t count = pr->mTail - pr->mHead;
+   uint64_t head = pr->mHead & pr->mMask;
+   if (head + count > oldCapacity) {
+      uint8_t* pData = (uint8_t*)cvData(pr->mItems);
+      memcpy(pData + ((size_t)oldCapacity * pr->mItemSize), pData,
+         (size_t)(head + count - oldCapacity) * pr->mItemSize
+      );
+   }
+
+   pr->mHead = head;
+   pr->mTail = head + count;
+   pr->mMask = capacity - 1;
+   return success;
+}
+
+// Makes room for count more items if the buffer is growable.
+void ringMakeRoom(ring* pr, uint64_t count)
+{
+   if (!(pr->mFlags & rbfgrowable)) return;
+
+   uint64_t used = pr->mTail - pr->mHead;
+   if (count <= (pr->mMask + 1) - used) return;
+   if (count > RINGBUF_MAXCAPACITY - used) return;
+
+   uint64_t capacity = ringCapacity(used + count);
+   if (capacity) ringGrow(pr, capacity);
+}
+
+// Sets pFirst and pSecond over count slots from position pos.
+void ringSpans(ring* pr, uint64_t pos, uint64_t count, cvspan* pFirst,
+   cvspan* pSecond)
+{
+   uint8_t* pData = (uint8_t*)cvData(pr->mItems);
+   uint64_t start = pos & pr->mMask;
+   uint64_t first = (pr->mMask + 1) - start;
+   if (first > count) first = count;
+
+   pFirst->mpBegin = pData + ((size_t)start * pr->mItemSize);
+   pFirst->mpEnd = (uint8_t*)pFirst->mpBegin + ((size_t)first *
+      pr->mItemSize
+   );
+   pFirst->mStride = pr->mItemSize;
+   pSecond->mpBegin = pData;
+   pSecond->mpEnd = pData + ((size_t)(count - first) * pr->mItemSize);
+   pSecond->mStride = pr->mItemSize;
+}
+
+//
+// Size management.
+//
+
+// Returns the number of items in the buffer.
+uint64_t rbGetCount(cringbuf crb)
+{
+   const ring* pr = (const ring*)crb;
+   if (!pr) return 0;
+   return pr->mTail - pr->mHead;
+}
+
+// Returns the number of items the buffer holds before it is full.
+uint64_t rbGetCapacity(cringbuf crb)
+{
+   const ring* pr = (const ring*)crb;
+   if (!pr) return 0;
+   return pr->mMask + 1;
+}
+
+// Sets how the underlying vector allocates memory as the buffer grows.
+retcode rbSetGrowthPolicy(ringbuf rb, cvgrowth policy, uint32_t param)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return fail;
+   return cvSetGrowthPolicy(pr->mItems, policy, param);
+}
+
+// Grows the buffer to hold at least itemCount items. Allowed whether or not
+// the buffer is growable.
+retcode rbReserve(ringbuf rb, uint64_t itemCount)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return fail;
+
+   uint64_t capacity = ringCapacity(itemCount);
+   if (capacity == 0) return fail;
+   return ringGrow(pr, capacity);
+}
+
+// Empties the buffer. The capacity is kept.
+void rbClear(ringbuf rb)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return;
+   pr->mHead = pr->mTail = 0;
+}
+
+//
+// Items.
+//
+
+// Adds an item at the back. Fails if the buffer is full and cannot grow.
+retcode rbPush(ringbuf rb, ccvitem item)
+{
+   ring* pr = (ring*)rb;
+   if (!pr || !item) return fail;
+
+   if (pr->mTail - pr->mHead > pr->mMask) {
+      ringMakeRoom(pr, 1);
+      if (pr->mTail - pr->mHead > pr->mMask) return fail;
+   }
+
+   memcpy(ringSlot(pr, pr->mTail), item, pr->mItemSize);
+   pr->mTail++;
+   return success;
+}
+
+// Adds up to count items (stored contiguously) at the back. Returns the
+// number added.
+uint64_t rbPushN(ringbuf rb, ccvitem items, uint64_t count)
+{
+   cvspan first, second;
+   uint64_t n = rbWriteSpans(rb, count, &first, &second);
+   if (n == 0 || !items) return 0;
+
+   size_t firstSize = (uint8_t*)first.mpEnd - (uint8_t*)first.mpBegin;
+   memcpy(first.mpBegin, items, firstSize);
+   memcpy(second.mpBegin, (const uint8_t*)items + firstSize,
+      (uint8_t*)second.mpEnd - (uint8_t*)second.mpBegin
+   );
+   rbCommit(rb, n);
+   return n;
+}
+
+// Removes the oldest item, copying it to pItem if given.
+retcode rbPop(ringbuf rb, cvitem pItem)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return fail;
+   if (pr->mTail == pr->mHead) return fail;
+
+   if (pItem) memcpy(pItem, ringSlot(pr, pr->mHead), pr->mItemSize);
+   pr->mHead++;
+   return success;
+}
+
+// Removes up to count of the oldest items, copying them to pItems if given.
+// Returns the number removed.
+uint64_t rbPopN(ringbuf rb, cvitem pItems, uint64_t count)
+{
+   cvspan first, second;
+   uint64_t n = rbReadSpans(rb, count, &first, &second);
+   if (n == 0) return 0;
+
+   if (pItems) {
+      size_t firstSize = (uint8_t*)first.mpEnd - (uint8_t*)first.mpBegin;
+      memcpy(pItems, first.mpBegin, firstSize);
+      memcpy((uint8_t*)pItems + firstSize, second.mpBegin,
+         (uint8_t*)second.mpEnd - (uint8_t*)second.mpBegin
+      );
+   }
+   rbConsume(rb, n);
+   return n;
+}
+
+// Returns the oldest item or null if the buffer is empty.
+void* rbPeek(ringbuf rb)
+{
+   return rbGetAt(rb, 0);
+}
+
+// Returns item index counting from the oldest (0).
+void* rbGetAt(ringbuf rb, uint64_t index)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return null;
+   if (index >= pr->mTail - pr->mHead) return null;
+   return ringSlot(pr, pr->mHead + index);
+}
+
+//
+// Zero copy batches.
+//
+
+// Sets pFirst and pSecond over the oldest items (at most count). Returns the
+// number of items they cover.
+uint64_t rbReadSpans(ringbuf rb, uint64_t count, cvspan* pFirst,
+   cvspan* pSecond)
+{
+   ring* pr = (ring*)rb;
+   if (!pr || !pFirst || !pSecond) return 0;
+
+   uint64_t used = pr->mTail - pr->mHead;
+   if (count > used) count = used;
+   ringSpans(pr, pr->mHead, count, pFirst, pSecond);
+   return count;
+}
+
+// Drops count of the oldest items (normally after rbReadSpans).
+retcode rbConsume(ringbuf rb, uint64_t count)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return fail;
+   if (count > pr->mTail - pr->mHead) return fail;
+
+   pr->mHead += count;
+   return success;
+}
+
+// Sets pFirst and pSecond over free slots for at most count items, growing
+// the buffer first if it is growable. Returns the number of slots they cover.
+uint64_t rbWriteSpans(ringbuf rb, uint64_t count, cvspan* pFirst,
+   cvspan* pSecond)
+{
+   ring* pr = (ring*)rb;
+   if (!pr || !pFirst || !pSecond) return 0;
+
+   ringMakeRoom(pr, count);
+   uint64_t room = (pr->mMask + 1) - (pr->mTail - pr->mHead);
+   if (count > room) count = room;
+   ringSpans(pr, pr->mTail, count, pFirst, pSecond);
+   return count;
+}
+
+// Adds count items written to the slots given by rbWriteSpans.
+retcode rbCommit(ringbuf rb, uint64_t count)
+{
+   ring* pr = (ring*)rb;
+   if (!pr) return fail;
+   if (count > (pr->mMask + 1) - (pr->mTail - pr->mHead)) return fail;
+
+   pr->mTail += count;
+   return success;
+}
@@ -0,0 +1,229 @@
+/*
+Date: 17 Oct 2026 19:21:06.513840627
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_4C8F1B3E7D0A49265E3B9C0D2F7A1E54__
+Purpose: Tests for ringbuf.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <ringbuf.h>
+
+//
+// MACROS
+//
+
+// Items held by the model queue in the random operations test.
+#define TEST_MODEL_SIZE                      4096
+
+//
+// HELPERS
+//
+
+// Returns true if the items in spans first and second are the count values
+// starting at value.
+bool spansHold(cvspan first, cvspan second, uint32_t value, uint64_t count)
+{
+   if (cvSpanCount(first) + cvSpanCount(second) != count) return false;
+   cvforeach(uint32_t, p, first) {
+      if (*p != value++) return false;
+   }
+   cvforeach(uint32_t, p, second) {
+      if (*p != value++) return false;
+   }
+   return true;
+}
+
+//
+// TEST CASES
+//
+
+// Tests a bounded buffer as it fills, wraps and empties.
+bool testBounded(TFSuite pTest)
+{
+   tfzassert_ptr(pTest, rbcreate(0, 8), null, false);
+   ringbuf rb = rbcreate(sizeof(uint32_t), 5);
+   if (false == tfzassert(pTest, rb != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, rbGetCapacity(rb) == 8, true, false);
+   tfzassert_ptr(pTest, rbPeek(rb), null, false);
+   tfzassert(pTest, rbPop(rb, null), fail, false);
+
+   // Fill up; a full buffer refuses more.
+   uint32_t value = 0;
+   for (uint32_t n = 0; n < 8; ++n, ++value) rbPush(rb, &value);
+   tfzassert(pTest, rbPush(rb, &value), fail, false);
+   tfzassert(pTest, rbGetCount(rb) == 8, true, false);
+
+   // Pop some and wrap around.
+   uint32_t item = 0;
+   tfzassert(pTest, rbPop(rb, &item), success, false);
+   tfzassert_ui32(pTest, item, 0, false);
+   tfzassert(pTest, rbPopN(rb, null, 4) == 4, true, false);
+   uint32_t values[] = { 8, 9, 10, 11, 12, 13 };
+   tfzassert(pTest, rbPushN(rb, values, 6) == 5, true, false);
+   tfzassert_ui32(pTest, *(uint32_t*)rbPeek(rb), 5, false);
+   tfzassert_ui32(pTest, *(uint32_t*)rbGetAt(rb, 7), 12, false);
+   tfzassert_ptr(pTest, rbGetAt(rb, 8), null, false);
+
+   // The items now lie in two spans.
+   cvspan first, second;
+   tfzassert(pTest, rbReadSpans(rb, 100, &first, &second) == 8, true, false);
+   tfzassert(pTest, cvSpanCount(first) == 3, true, false);
+   tfzassert(pTest, spansHold(first, second, 5, 8), true, false);
+   tfzassert(pTest, rbWriteSpans(rb, 1, &first, &second) == 0, true, false);
+   tfzassert(pTest, rbConsume(rb, 9), fail, false);
+   tfzassert(pTest, rbConsume(rb, 6), success, false);
+
+   // Write in place over the free slots.
+   tfzassert(pTest, rbWriteSpans(rb, 5, &first, &second) == 5, true, false);
+   value = 13;
+   cvforeach(uint32_t, p, first) *p = value++;
+   cvforeach(uint32_t, p, second) *p = value++;
+   tfzassert(pTest, rbCommit(rb, 7), fail, false);
+   tfzassert(pTest, rbCommit(rb, 5), success, false);
+   uint32_t out[8];
+   tfzassert(pTest, rbPopN(rb, out, 8) == 7, true, false);
+   bool ok = true;
+   for (uint32_t n = 0; n < 7; ++n) ok = ok && (out[n] == n + 11);
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, rbGetCount(rb) == 0, true, false);
+
+   // Reserve grows even a bounded buffer.
+   tfzassert(pTest, rbReserve(rb, 20), success, false);
+   tfzassert(pTest, rbGetCapacity(rb) == 32, true, false);
+
+   // Success.
+   rbdestroy(&rb);
+   return tfzassert_ptr(pTest, rb, null, false);
+}
+
+// Tests a growable buffer against a model queue with random operations.
+bool testGrowable(TFSuite pTest)
+{
+   ringbuf rb = rbcreatex(sizeof(uint32_t), 2, rbfgrowable);
+   if (false == tfzassert(pTest, rb != null, true, false)) {
+      return false;
+   }
+
+   // Growing while items wrap keeps their order.
+   uint32_t value = 0;
+   for (uint32_t n = 0; n < 2; ++n, ++value) rbPush(rb, &value);
+   rbPop(rb, null);
+   for (uint32_t n = 0; n < 5; ++n, ++value) rbPush(rb, &value);
+   tfzassert(pTest, rbGetCapacity(rb) == 8, true, false);
+   cvspan first, second;
+   rbReadSpans(rb, 100, &first, &second);
+   tfzassert(pTest, spansHold(first, second, 1, 6), true, false);
+   rbClear(rb);
+   tfzassert(pTest, rbGetCount(rb) == 0, true, false);
+
+   // Random operations; the model never wraps.
+   static uint32_t model[TEST_MODEL_SIZE * 8];
+   uint64_t head = 0, tail = 0, seed = 31;
+   uint32_t items[64];
+   bool ok = true;
+   value = 0;
+   for (uint32_t n = 0; n < 20000 && ok; ++n) {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      uint32_t op = (uint32_t)(seed >> 61);
+      uint32_t count = (uint32_t)((seed >> 20) % 64) + 1;
+      if (tail + 64 > TEST_MODEL_SIZE * 8) break;
+      if (tail - head > TEST_MODEL_SIZE) op = 7;
+
+      if (op < 2) {
+         rbPush(rb, &value);
+         model[tail++] = value++;
+      } else if (op < 4) {
+         for (uint32_t i = 0; i < count; ++i) {
+            items[i] = model[tail++] = value++;
+         }
+         ok = (rbPushN(rb, items, count) == count);
+      } else if (op < 5) {
+         uint64_t written = rbWriteSpans(rb, count, &first, &second);
+         ok = (written == count);
+         cvforeach(uint32_t, p, first) *p = model[tail++] = value++;
+         cvforeach(uint32_t, p, second) *p = model[tail++] = value++;
+         rbCommit(rb, written);
+      } else if (op < 6) {
+         uint32_t item = 0;
+         if (head < tail) {
+            ok = (rbPop(rb, &item) == success && item == model[head++]);
+         }
+      } else if (op < 7) {
+         uint64_t read = rbReadSpans(rb, count, &first, &second);
+         ok = (head == tail || spansHold(first, second, model[head], read));
+         rbConsume(rb, read);
+         head += read;
+      } else {
+         uint64_t popped = rbPopN(rb, items, count);
+         for (uint64_t i = 0; i < popped && ok; ++i) {
+            ok = (items[i] == model[head++]);
+         }
+      }
+      ok = ok && (rbGetCount(rb) == tail - head);
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, rbGetCount(rb) == tail - head, true, false);
+   tfzassert(pTest, (rbGetCapacity(rb) & (rbGetCapacity(rb) - 1)) == 0,
+      true, false);
+
+   // Success.
+   rbdestroy(&rb);
+   return tfzassert_ptr(pTest, rb, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("ringbuf tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testBounded(tfz);
+   testGrowable(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
@@ -0,0 +1,170 @@
+/*
+Date: 17 Oct 2026 19:52:33.145207319
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_1F6C3A9E0D2B48574A0E6C1B9F3D5A27__
+Purpose: Benchmarks for slotmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (churn, iteration)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <slotmap.h>
+
+//
+// TYPES
+//
+
+// An entity kept in a vector that is never compacted: erased entities stay
+// behind, marked dead, so that indexes into the vector stay valid.
+typedef struct _entity {
+   uint64_t mValue;
+   uint64_t mAlive;
+} entity;
+
+//
+// MACROS
+//
+
+// Largest power of ten of live items benchmarked unless given on the command
+// line.
+#define BENCH_DEFAULT_MAXEXP                 6
+// Erase/insert pairs timed per size.
+#define BENCH_CHURN_OPS                      2000000
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+//
+// BENCHMARKS
+//
+
+// Keeps count items alive while erasing a random one and inserting another
+// BENCH_CHURN_OPS times, then sums the live items. The vector keeps erased
+// entities (so its indexes stay valid) and the slot map compacts.
+void benchChurn(uint64_t count)
+{
+   cvector v = cvcreate(sizeof(entity));
+   slotmap sm = smcreate(sizeof(uint64_t));
+   uint64_t* pIndexes = (uint64_t*)malloc(sizeof(uint64_t) * count);
+   smhandle* pHandles = (smhandle*)malloc(sizeof(smhandle) * count);
+   if (!v || !sm || !pIndexes || !pHandles) {
+      cvdestroy(&v);
+      smdestroy(&sm);
+      free(pIndexes);
+      free(pHandles);
+      return;
+   }
+
+   // Vector never compacted.
+   uint64_t seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count; ++n) {
+      entity e = { n, 1 };
+      pIndexes[n] = cvGetCount(v);
+      cvPushBack(v, &e);
+   }
+   double start = benchNow();
+   for (uint64_t n = 0; n < BENCH_CHURN_OPS; ++n) {
+      uint64_t pick = benchRandom(&seed) % count;
+      ((entity*)cvAt(v, pIndexes[pick]))->mAlive = 0;
+      entity e = { n, 1 };
+      pIndexes[pick] = cvGetCount(v);
+      cvPushBack(v, &e);
+   }
+   double vectorChurn = BENCH_CHURN_OPS / (benchNow() - start) / 1e6;
+   uint64_t vectorSum = 0;
+   start = benchNow();
+   cvforeach(entity, p, cvSpan(v)) {
+      if (p->mAlive) vectorSum += p->mValue;
+   }
+   double vectorScan = count / (benchNow() - start) / 1e6;
+
+   // Slot map.
+   seed = 88172645463325252ull;
+   for (uint64_t n = 0; n < count; ++n) pHandles[n] = smInsert(sm, &n);
+   start = benchNow();
+   for (uint64_t n = 0; n < BENCH_CHURN_OPS; ++n) {
+      uint64_t pick = benchRandom(&seed) % count;
+      smErase(sm, pHandles[pick], null);
+      pHandles[pick] = smInsert(sm, &n);
+   }
+   double slotChurn = BENCH_CHURN_OPS / (benchNow() - start) / 1e6;
+   uint64_t slotSum = 0;
+   cvspan items = smItems(sm);
+   start = benchNow();
+   cvforeach(uint64_t, p, items) slotSum += *p;
+   double slotScan = count / (benchNow() - start) / 1e6;
+
+   printf("%10" PRIu64 " %10.2f %10.2f %10.1f %10.1f %10" PRIu64 " %s\n",
+      count, vectorChurn, slotChurn, vectorScan, slotScan, cvGetCount(v),
+      (vectorSum == slotSum ? "" : "(mismatch!)")
+   );
+
+   cvdestroy(&v);
+   smdestroy(&sm);
+   free(pIndexes);
+   free(pHandles);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 7) maxExp = 7;
+
+   // Churn in million erase/insert pairs per second, scans in million live
+   // items per second, and the items the never compacted vector ends with.
+   printf("%10s %10s %10s %10s %10s %10s\n", "live", "vec churn",
+      "slot churn", "vec scan", "slot scan", "vec items");
+   uint64_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchChurn(count);
+
+   return 0;
+}
@@ -0,0 +1,312 @@
+/*
+Date: 17 Oct 2026 19:52:33.118094276
+File: slotmap.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SLOTMAP_C_3B7E0A2D9C4F41586E1B8D3A0C7F2E95__
+Purpose: Implements a slot map: items are kept densely in a vector and are
+         reached through stable handles. A slot holds the index of its item
+         and a generation that changes whenever the item is erased.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <slotmap.h>
+
+//
+// MACROS
+//
+
+// End of the free slot list.
+#define SLOTMAP_NOSLOT                       UINT32_MAX
+// Slots available (a slot index never reaches SLOTMAP_NOSLOT).
+#define SLOTMAP_MAXSLOTS                     ((uint64_t)UINT32_MAX - 1)
+
+//
+// STRUCTS
+//
+
+// A slot. An odd generation means the slot is in use and mIndex is its item;
+// an even one means it is free and mIndex is the next free slot.
+typedef struct _smslot {
+   uint32_t mIndex;                                // item or next free slot
+   uint32_t mGeneration;                           // bumped on insert/erase
+} smslot;
+
+// Items are dense in mItems and mBack holds the slot of each item, so the
+// item moved into the gap left by an erase can have its slot fixed up. Free
+// slots form a list through mIndex starting at mFree.
+typedef struct _slots {
+   uint32_t mItemSize;                             // size of each item
+   uint32_t mFree;                                 // first free slot
+   cvector mItems;                                 // items (dense)
+   cvector mBack;                                  // slot of each item
+   cvector mSlots;                                 // smslot per handle slot
+} slots;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new slot map. Initially the map will be empty. No memory will be
+// allocated for items unless necessary.
+slotmap smcreate(uint32_t itemSize)
+{
+   if (itemSize == 0) return nul;
+
+   slots* ps = (slots*)malloc(sizeof(slots));
+   if (!ps) return nul;
+   memset(ps, 0, sizeof(slots));
+
+   ps->mItemSize = itemSize;
+   ps->mFree = SLOTMAP_NOSLOT;
+
+   // Create the vectors.
+   bool ok = (nul != (ps->mItems = cvcreate(itemSize))) &&
+      (nul != (ps->mBack = cvcreate(sizeof(uint32_t)))) &&
+      (nul != (ps->mSlots = cvcreate(sizeof(smslot))));
+   if (!ok) {
+      slotmap sm = (slotmap)ps;
+      smdestroy(&sm);
+      return nul;
+   }
+
+   // Done.
+   return (slotmap)ps;
+}
+
+// Destroy existing slot map.
+void smdestroy(slotmap* psm)
+{
+   if (nul == psm) return;
+   if (nul == (*psm)) return;
+
+   slots* s = (slots*)*psm;
+   cvdestroy(&s->mItems);
+   cvdestroy(&s->mBack);
+   cvdestroy(&s->mSlots);
+
+   free(*psm);
+   *psm = 0;
+}
+
+//
+// Private API - Slots.
+//
+
+// Returns slot index.
+smslot* slotAt(slots* ps, uint32_t slot)
+{
+   return (smslot*)cvData(ps->mSlots) + slot;
+}
+
+// Returns the item index of handle or SM_NOHANDLE if handle is stale or was
+// never given.
+uint64_t slotFind(const slots* ps, smhandle handle)
+{
+   uint32_t slot = (uint32_t)handle;
+   uint32_t generation = (uint32_t)(handle >> 32);
+   if (slot >= cvCount(ps->mSlots)) return SM_NOHANDLE;
+
+   const smslot* pSlot = (const smslot*)cvData(ps->mSlots) + slot;
+   if (pSlot->mGeneration != generation) return SM_NOHANDLE;
+   if ((generation & 1) == 0) return SM_NOHANDLE;
+   return pSlot->mIndex;
+}
+
+// Returns slot to the free list, making its handle stale.
+void slotRelease(slots* ps, uint32_t slot)
+{
+   smslot* pSlot = slotAt(ps, slot);
+   pSlot->mGeneration++;
+   pSlot->mIndex = ps->mFree;
+   ps->mFree = slot;
+}
+
+//
+// Size management.
+//
+
+// Returns the number of items in the map.
+uint64_t smGetCount(cslotmap csm)
+{
+   const slots* ps = (const slots*)csm;
+   if (!ps) return 0;
+   return cvCount(ps->mItems);
+}
+
+// Reserve itemCount items in the map.
+retcode smReserve(slotmap sm, uint64_t itemCount)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return fail;
+   if (itemCount > SLOTMAP_MAXSLOTS) return fail;
+
+   if (fail == cvReserve(ps->mItems, itemCount)) return fail;
+   if (fail == cvReserve(ps->mBack, itemCount)) return fail;
+   return cvReserve(ps->mSlots, itemCount);
+}
+
+// Removes all items. Every handle given so far becomes stale.
+void smClear(slotmap sm)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return;
+
+   uint32_t* pBack = (uint32_t*)cvData(ps->mBack);
+   uint64_t count = cvCount(ps->mItems);
+   for (uint64_t n = 0; n < count; ++n) slotRelease(ps, pBack[n]);
+
+   cvClear(ps->mItems);
+   cvClear(ps->mBack);
+}
+
+// Frees memory past the last item. Slots are kept as handles refer to them.
+void smShrink(slotmap sm)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return;
+
+   cvShrink(ps->mItems);
+   cvShrink(ps->mBack);
+}
+
+//
+// Items.
+//
+
+// Adds a copy of item (or a blank item if null) and returns its handle.
+smhandle smInsert(slotmap sm, ccvitem item)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return SM_NOHANDLE;
+
+   // Room for the item first so nothing needs undoing after a slot is taken.
+   uint64_t index = cvCount(ps->mItems);
+   if (fail == cvReserve(ps->mItems, index + 1)) return SM_NOHANDLE;
+   if (fail == cvReserve(ps->mBack, index + 1)) return SM_NOHANDLE;
+
+   // Reuse a free slot or add one.
+   uint32_t slot = ps->mFree;
+   if (slot != SLOTMAP_NOSLOT) {
+      ps->mFree = slotAt(ps, slot)->mIndex;
+   } else {
+      if (cvCount(ps->mSlots) >= SLOTMAP_MAXSLOTS) return SM_NOHANDLE;
+      slot = (uint32_t)cvCount(ps->mSlots);
+      if (!cvEmplaceBack(ps->mSlots, nul)) return SM_NOHANDLE;
+   }
+
+   // Add the item.
+   if (item) {
+      cvPushBack(ps->mItems, (cvitem)item);
+   } else {
+      cvEmplaceBack(ps->mItems, nul);
+   }
+   cvPushBack(ps->mBack, &slot);
+
+   smslot* pSlot = slotAt(ps, slot);
+   pSlot->mIndex = (uint32_t)index;
+   pSlot->mGeneration++;
+   return ((smhandle)pSlot->mGeneration << 32) | slot;
+}
+
+// Returns the item of handle or null if the handle is stale.
+void* smGet(slotmap sm, smhandle handle)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return null;
+
+   uint64_t index = slotFind(ps, handle);
+   if (index == SM_NOHANDLE) return null;
+   return cvAt(ps->mItems, index);
+}
+
+// Returns true if handle refers to an item.
+bool smContains(cslotmap csm, smhandle handle)
+{
+   const slots* ps = (const slots*)csm;
+   if (!ps) return false;
+   return (slotFind(ps, handle) != SM_NOHANDLE);
+}
+
+// Erases the item of handle, copying it to pItem if given. The last item
+// moves into its place.
+retcode smErase(slotmap sm, smhandle handle, cvitem pItem)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) return fail;
+
+   uint64_t index = slotFind(ps, handle);
+   if (index == SM_NOHANDLE) return fail;
+   if (pItem) memcpy(pItem, cvAt(ps->mItems, index), ps->mItemSize);
+
+   // Move the last item into the gap and point its slot at it.
+   uint64_t last = cvCount(ps->mItems) - 1;
+   if (index != last) {
+      uint32_t* pBack = (uint32_t*)cvData(ps->mBack);
+      memcpy(cvAt(ps->mItems, index), cvAt(ps->mItems, last), ps->mItemSize);
+      pBack[index] = pBack[last];
+      slotAt(ps, pBack[index])->mIndex = (uint32_t)index;
+   }
+   cvPopBack(ps->mItems);
+   cvPopBack(ps->mBack);
+
+   slotRelease(ps, (uint32_t)handle);
+   return success;
+}
+
+//
+// Dense access.
+//
+
+// Returns a span over all items.
+cvspan smItems(slotmap sm)
+{
+   slots* ps = (slots*)sm;
+   if (!ps) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+   return cvSpan(ps->mItems);
+}
+
+// Returns the handle of item index (SM_NOHANDLE if there is no such item).
+smhandle smHandleAt(cslotmap csm, uint64_t index)
+{
+   const slots* ps = (const slots*)csm;
+   if (!ps) return SM_NOHANDLE;
+   if (index >= cvCount(ps->mItems)) return SM_NOHANDLE;
+
+   uint32_t slot = ((const uint32_t*)cvData(ps->mBack))[index];
+   const smslot* pSlot = (const smslot*)cvData(ps->mSlots) + slot;
+   return ((smhandle)pSlot->mGeneration << 32) | slot;
+}
@@ -0,0 +1,180 @@
+/*
+Date: 17 Oct 2026 19:52:33.131650842
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_8E4B2D0F6A1C47935C7E3A9B0D2F6C18__
+Purpose: Tests for slotmap.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <slotmap.h>
+
+//
+// MACROS
+//
+
+// Handles kept by the random operations test.
+#define TEST_HANDLES                         2000
+
+//
+// TEST CASES
+//
+
+// Tests handles against a table of expected items with random inserts and
+// erases.
+bool testRandom(TFSuite pTest)
+{
+   tfzassert_ptr(pTest, smcreate(0), null, false);
+   slotmap sm = smcreate(sizeof(uint64_t));
+   if (false == tfzassert(pTest, sm != null, true, false)) {
+      return false;
+   }
+   tfzassert_ptr(pTest, smGet(sm, 0), null, false);
+   tfzassert_ptr(pTest, smGet(sm, SM_NOHANDLE), null, false);
+
+   // Random operations. Erased handles are kept to check they are stale.
+   static smhandle live[TEST_HANDLES], dead[TEST_HANDLES];
+   static uint64_t values[TEST_HANDLES];
+   uint64_t liveCount = 0, deadCount = 0, seed = 5;
+   bool ok = true;
+   for (uint32_t n = 0; n < 50000 && ok; ++n) {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      uint64_t pick = (seed >> 33) % (liveCount ? liveCount : 1);
+      if ((seed >> 62) < 2 && liveCount < TEST_HANDLES) {
+         values[liveCount] = seed;
+         live[liveCount] = smInsert(sm, &seed);
+         ok = (live[liveCount] != SM_NOHANDLE);
+         liveCount++;
+      } else if (liveCount > 0) {
+         uint64_t item = 0;
+         ok = (smErase(sm, live[pick], &item) == success) &&
+            (item == values[pick]);
+         dead[deadCount++ % TEST_HANDLES] = live[pick];
+         live[pick] = live[--liveCount];
+         values[pick] = values[liveCount];
+      }
+      ok = ok && (smGetCount(sm) == liveCount);
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // Live handles find their items; erased ones are stale.
+   ok = true;
+   for (uint64_t n = 0; n < liveCount; ++n) {
+      uint64_t* pItem = (uint64_t*)smGet(sm, live[n]);
+      if (!pItem || *pItem != values[n]) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+   ok = true;
+   for (uint64_t n = 0; n < TEST_HANDLES && n < deadCount; ++n) {
+      if (smContains(sm, dead[n])) ok = false;
+      if (smErase(sm, dead[n], null) != fail) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // The dense items and their handles agree.
+   cvspan items = smItems(sm);
+   uint64_t index = 0;
+   ok = true;
+   cvforeach(uint64_t, p, items) {
+      if (smGet(sm, smHandleAt(sm, index++)) != p) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, index == liveCount, true, false);
+   tfzassert(pTest, smHandleAt(sm, index) == SM_NOHANDLE, true, false);
+
+   // Success.
+   smdestroy(&sm);
+   return tfzassert_ptr(pTest, sm, null, false);
+}
+
+// Tests slot reuse, blank items and clearing.
+bool testReuse(TFSuite pTest)
+{
+   slotmap sm = smcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, sm != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, smReserve(sm, 100), success, false);
+
+   // A reused slot gets a new generation.
+   uint32_t value = 7;
+   smhandle a = smInsert(sm, &value);
+   smhandle b = smInsert(sm, null);
+   tfzassert_ui32(pTest, *(uint32_t*)smGet(sm, b), 0, false);
+   tfzassert(pTest, smErase(sm, a, null), success, false);
+   tfzassert_ui32(pTest, *(uint32_t*)smGet(sm, b), 0, false);
+   smhandle c = smInsert(sm, &value);
+   tfzassert(pTest, (uint32_t)c == (uint32_t)a, true, false);
+   tfzassert(pTest, c != a, true, false);
+   tfzassert_ptr(pTest, smGet(sm, a), null, false);
+   tfzassert_ui32(pTest, *(uint32_t*)smGet(sm, c), 7, false);
+
+   // Clearing makes every handle stale.
+   smClear(sm);
+   tfzassert(pTest, smGetCount(sm) == 0, true, false);
+   tfzassert(pTest, smContains(sm, b), false, false);
+   tfzassert(pTest, smContains(sm, c), false, false);
+   smhandle d = smInsert(sm, &value);
+   tfzassert(pTest, smContains(sm, d), true, false);
+   tfzassert(pTest, smGetCount(sm) == 1, true, false);
+   smShrink(sm);
+   tfzassert_ui32(pTest, *(uint32_t*)smGet(sm, d), 7, false);
+
+   // Success.
+   smdestroy(&sm);
+   return tfzassert_ptr(pTest, sm, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("slotmap tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testRandom(tfz);
+   testReuse(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
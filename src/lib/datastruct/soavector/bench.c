@@ -0,0 +1,191 @@
+/*
+Date: 17 Oct 2026 16:02:18.559806123
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_C4A07E2B91D35F86B0E4A2D7193C5F08__
+Purpose: Benchmarks for soavector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (field scans)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <soavector.h>
+
+//
+// TYPES
+//
+
+// A 64 byte record of which the scans only read one or two fields.
+typedef struct _record {
+   double mPrice;
+   uint32_t mQuantity;
+   uint32_t mId;
+   uint64_t mTimestamp;
+   char mName[40];
+} record;
+
+//
+// MACROS
+//
+
+// Largest power of ten benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 7
+// Each scan is repeated to total about this many rows.
+#define BENCH_SCAN_ROWS                      100000000
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+//
+// BENCHMARKS
+//
+
+// Fills an array of structs vector and a soa vector with count records and
+// times scans of one field (price sum) and two fields (price * quantity).
+void benchScan(uint32_t count)
+{
+   soafield fields[] = {
+      soafieldof(record, mPrice),
+      soafieldof(record, mQuantity),
+      soafieldof(record, mId),
+      soafieldof(record, mTimestamp),
+      soafieldof(record, mName)
+   };
+   cvector aos = cvcreate(sizeof(record));
+   soavector soa = soacreate(fields, 5, sizeof(record));
+   if (!aos || !soa) {
+      cvdestroy(&aos);
+      soadestroy(&soa);
+      return;
+   }
+
+   // Fill both.
+   record rec;
+   memset(&rec, 0, sizeof(rec));
+   for (uint32_t n = 0; n < count; ++n) {
+      rec.mPrice = (n % 1000) * 0.25;
+      rec.mQuantity = n % 100;
+      rec.mId = n;
+      rec.mTimestamp = n * 1000ull;
+      cvPushBack(aos, makecvitem(rec));
+      soaPushRow(soa, &rec);
+   }
+
+   uint32_t rounds = BENCH_SCAN_ROWS / count;
+   if (rounds == 0) rounds = 1;
+   double sums[4] = { 0 };
+
+   // One field. Four partial sums so the scan is bound by memory rather than
+   // by the latency of each add (count is a multiple of four).
+   double start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      const record* pRecs = (const record*)cvData(aos);
+      double part[4] = { 0 };
+      for (uint32_t n = 0; n < count; n += 4) {
+         part[0] += pRecs[n].mPrice;
+         part[1] += pRecs[n + 1].mPrice;
+         part[2] += pRecs[n + 2].mPrice;
+         part[3] += pRecs[n + 3].mPrice;
+      }
+      sums[0] += (part[0] + part[1]) + (part[2] + part[3]);
+   }
+   double aosOne = benchNow() - start;
+
+   start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      const double* pPrices = (const double*)soaColumn(soa, 0).mpBegin;
+      double part[4] = { 0 };
+      for (uint32_t n = 0; n < count; n += 4) {
+         part[0] += pPrices[n];
+         part[1] += pPrices[n + 1];
+         part[2] += pPrices[n + 2];
+         part[3] += pPrices[n + 3];
+      }
+      sums[1] += (part[0] + part[1]) + (part[2] + part[3]);
+   }
+   double soaOne = benchNow() - start;
+
+   // Two fields.
+   start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      cvforeach(record, p, cvSpan(aos)) {
+         sums[2] += p->mPrice * p->mQuantity;
+      }
+   }
+   double aosTwo = benchNow() - start;
+
+   start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      const double* pPrices = (const double*)soaColumn(soa, 0).mpBegin;
+      const uint32_t* pQuantities = (const uint32_t*)soaColumn(soa, 1).mpBegin;
+      for (uint32_t n = 0; n < count; ++n) {
+         sums[3] += pPrices[n] * pQuantities[n];
+      }
+   }
+   double soaTwo = benchNow() - start;
+
+   double rows = (double)count * rounds;
+   printf("%12" PRIu32 " %10.1f %10.1f %10.1f %10.1f %s\n", count,
+      rows / aosOne / 1e6, rows / soaOne / 1e6,
+      rows / aosTwo / 1e6, rows / soaTwo / 1e6,
+      (sums[0] == sums[1] && sums[2] == sums[3] ? "" : "(mismatch!)")
+   );
+
+   cvdestroy(&aos);
+   soadestroy(&soa);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 8) maxExp = 8;
+
+   // Field scans (million rows per second).
+   printf("%12s %10s %10s %10s %10s\n", "rows",
+      "aos 1f", "soa 1f", "aos 2f", "soa 2f");
+   uint32_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchScan(count);
+   }
+
+   return 0;
+}
@@ -0,0 +1,314 @@
+/*
+Date: 17 Oct 2026 16:02:18.517730096
+File: soavector.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SOAVECTOR_C_58E1B3D7A0F94C26D8B5E7103A6F2C49__
+Purpose: Implements a struct of arrays (columnar) vector. Rows are described
+         by a schema of fields given at creation and each field is stored in
+         a column of its own (a vector), so scans over one field only touch
+         that field's memory.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <soavector.h>
+
+//
+// STRUCTS
+//
+
+// Each column is a vector with the field size as item size, so growth is
+// left to vector.c. All columns hold mRowCount items.
+typedef struct _soavec {
+   uint32_t mFieldCount;                           // fields per row
+   uint32_t mRowSize;                              // row size as given
+   uint64_t mRowCount;                             // number of rows
+   soafield* mpFields;                             // schema (follows struct)
+   cvector* mpColumns;                             // one vector per field
+} soavec;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new soa vector with the schema given. Initially the vector will be
+// empty. No column memory is allocated unless necessary.
+soavector soacreate(const soafield* pFields, uint32_t fieldCount,
+   uint32_t rowSize)
+{
+   if (!pFields || fieldCount == 0) return nul;
+
+   // Every field must lie within the row.
+   for (uint32_t f = 0; f < fieldCount; ++f) {
+      if (pFields[f].mSize == 0) return nul;
+      if (pFields[f].mOffset > rowSize) return nul;
+      if (pFields[f].mSize > rowSize - pFields[f].mOffset) return nul;
+   }
+
+   // Vector, schema and columns in one allocation.
+   size_t size = sizeof(soavec) + (sizeof(soafield) * fieldCount) +
+      (sizeof(cvector) * fieldCount);
+   soavec* psv = (soavec*)malloc(size);
+   if (!psv) return nul;
+   memset(psv, 0, size);
+
+   psv->mFieldCount = fieldCount;
+   psv->mRowSize = rowSize;
+   psv->mpFields = (soafield*)(psv + 1);
+   psv->mpColumns = (cvector*)(psv->mpFields + fieldCount);
+   memcpy(psv->mpFields, pFields, sizeof(soafield) * fieldCount);
+
+   // Create the columns.
+   for (uint32_t f = 0; f < fieldCount; ++f) {
+      psv->mpColumns[f] = cvcreate(pFields[f].mSize);
+      if (!psv->mpColumns[f]) {
+         soavector sv = (soavector)psv;
+         soadestroy(&sv);
+         return nul;
+      }
+   }
+
+   // Done.
+   return (soavector)psv;
+}
+
+// Destroy existing soa vector.
+void soadestroy(soavector* psv)
+{
+   if (nul == psv) return;
+   if (nul == (*psv)) return;
+
+   // Free columns first.
+   soavec* sv = (soavec*)*psv;
+   for (uint32_t f = 0; f < sv->mFieldCount; ++f) {
+      cvdestroy(&sv->mpColumns[f]);
+   }
+
+   free(*psv);
+   *psv = 0;
+}
+
+//
+// Private API - Columns.
+//
+
+// Copies the fields of pRow into row index of the columns.
+void soaScatter(soavec* psv, uint64_t index, const void* pRow)
+{
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      const soafield* pField = &psv->mpFields[f];
+      memcpy(cvAt(psv->mpColumns[f], index), pRow + pField->mOffset,
+         pField->mSize
+      );
+   }
+}
+
+//
+// Item management.
+//
+
+// Returns the number of rows in the vector.
+uint64_t soaGetCount(csoavector csv)
+{
+   const soavec* psv = (const soavec*)csv;
+   return (psv ? psv->mRowCount : 0);
+}
+
+// Returns the number of fields per row.
+uint32_t soaGetFieldCount(csoavector csv)
+{
+   const soavec* psv = (const soavec*)csv;
+   return (psv ? psv->mFieldCount : 0);
+}
+
+// Returns the row size given at creation.
+uint32_t soaGetRowSize(csoavector csv)
+{
+   const soavec* psv = (const soavec*)csv;
+   return (psv ? psv->mRowSize : 0);
+}
+
+// Sets the growth policy of every column (see cvSetGrowthPolicy).
+retcode soaSetGrowthPolicy(soavector sv, cvgrowth policy, uint32_t param)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv) return fail;
+
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      if (fail == cvSetGrowthPolicy(psv->mpColumns[f], policy, param))
+         return fail;
+   }
+   return success;
+}
+
+// Reserve rowCount rows in every column.
+retcode soaReserve(soavector sv, uint64_t rowCount)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv) return fail;
+
+   retcode rc = success;
+   for (uint32_t f = 0; f < psv->mFieldCount && rc == success; ++f) {
+      rc = cvReserve(psv->mpColumns[f], rowCount);
+   }
+   return rc;
+}
+
+// Adds a row after the last row. pRow holds each field at its offset.
+retcode soaPushRow(soavector sv, const void* pRow)
+{
+   return soaPushRows(sv, pRow, 1);
+}
+
+// Adds count rows (stored contiguously at pRows, rowSize apart) after the last
+// row. Either all rows are added or none.
+retcode soaPushRows(soavector sv, const void* pRows, uint64_t count)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv || !pRows || count == 0) return fail;
+
+   // Grow every column, undoing on failure.
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      if (!cvEmplaceBackN(psv->mpColumns[f], count)) {
+         while (f-- > 0) {
+            cvEraseRange(psv->mpColumns[f], psv->mRowCount, count);
+         }
+         return fail;
+      }
+   }
+
+   // Copy one column at a time.
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      const soafield* pField = &psv->mpFields[f];
+      void* pDst = cvAt(psv->mpColumns[f], psv->mRowCount);
+      const void* pSrc = pRows + pField->mOffset;
+      for (uint64_t r = 0; r < count; ++r) {
+         memcpy(pDst, pSrc, pField->mSize);
+         pDst += pField->mSize;
+         pSrc += psv->mRowSize;
+      }
+   }
+   psv->mRowCount += count;
+
+   // Done.
+   return success;
+}
+
+// Reads row index into pRow (each field at its offset; other bytes of pRow
+// are left untouched).
+retcode soaGetRow(csoavector csv, uint64_t index, void* pRow)
+{
+   const soavec* psv = (const soavec*)csv;
+   if (!psv || !pRow) return fail;
+   if (index >= psv->mRowCount) return fail;
+
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      const soafield* pField = &psv->mpFields[f];
+      memcpy(pRow + pField->mOffset, cvAt(psv->mpColumns[f], index),
+         pField->mSize
+      );
+   }
+   return success;
+}
+
+// Overwrites row index with pRow.
+retcode soaSetRow(soavector sv, uint64_t index, const void* pRow)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv || !pRow) return fail;
+   if (index >= psv->mRowCount) return fail;
+
+   soaScatter(psv, index, pRow);
+   return success;
+}
+
+// Removes (blanks) last row.
+void soaPopBack(soavector sv)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv || psv->mRowCount == 0) return;
+
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      cvPopBack(psv->mpColumns[f]);
+   }
+   psv->mRowCount--;
+}
+
+// Removes all rows. Columns keep their memory until soaShrink() is called.
+void soaClear(soavector sv)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv) return;
+
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      cvClear(psv->mpColumns[f]);
+   }
+   psv->mRowCount = 0;
+}
+
+// Frees column memory not needed for the rows held.
+void soaShrink(soavector sv)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv) return;
+
+   for (uint32_t f = 0; f < psv->mFieldCount; ++f) {
+      cvShrink(psv->mpColumns[f]);
+   }
+}
+
+//
+// Field access.
+//
+
+// Returns field of row index or null.
+void* soaGetField(soavector sv, uint64_t index, uint32_t field)
+{
+   soavec* psv = (soavec*)sv;
+   if (!psv) return nul;
+   if (index >= psv->mRowCount || field >= psv->mFieldCount) return nul;
+
+   return cvAt(psv->mpColumns[field], index);
+}
+
+// Returns a span over all values of field.
+cvspan soaColumn(csoavector csv, uint32_t field)
+{
+   const soavec* psv = (const soavec*)csv;
+   if (!psv || field >= psv->mFieldCount) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+
+   return cvSpan(psv->mpColumns[field]);
+}
@@ -0,0 +1,185 @@
+/*
+Date: 17 Oct 2026 16:02:18.544203871
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_7E2B9D04C1A58F36E0D7B2A94C6F1E85__
+Purpose: Tests for soavector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <soavector.h>
+
+//
+// TYPES
+//
+
+// A row pushed into the soa vector tests.
+typedef struct _trade {
+   double mPrice;
+   uint32_t mQuantity;
+   uint16_t mVenue;
+   uint8_t mSide;
+} trade;
+
+//
+// TEST CASES
+//
+
+// Tests creation and destruction of a soa vector.
+bool testCreate(TFSuite pTest)
+{
+   soafield fields[] = {
+      soafieldof(trade, mPrice),
+      soafieldof(trade, mQuantity),
+      soafieldof(trade, mVenue),
+      soafieldof(trade, mSide)
+   };
+
+   // Bad schemas.
+   tfzassert_ptr(pTest, soacreate(null, 4, sizeof(trade)), null, false);
+   tfzassert_ptr(pTest, soacreate(fields, 0, sizeof(trade)), null, false);
+   tfzassert_ptr(pTest, soacreate(fields, 4, 8), null, false);
+   soafield empty = { 0, 0 };
+   tfzassert_ptr(pTest, soacreate(&empty, 1, sizeof(trade)), null, false);
+
+   // Create the vector.
+   soavector sv = soacreate(fields, 4, sizeof(trade));
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+   tfzassert_ui32(pTest, soaGetFieldCount(sv), 4, false);
+   tfzassert_ui32(pTest, soaGetRowSize(sv), sizeof(trade), false);
+   tfzassert(pTest, soaGetCount(sv) == 0, true, false);
+
+   // Destroy the vector.
+   soadestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+// Tests pushing and reading rows and scanning columns.
+bool testRows(TFSuite pTest)
+{
+   soafield fields[] = {
+      soafieldof(trade, mPrice),
+      soafieldof(trade, mQuantity),
+      soafieldof(trade, mVenue),
+      soafieldof(trade, mSide)
+   };
+   soavector sv = soacreate(fields, 4, sizeof(trade));
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+
+   // Rows one at a time and in bulk.
+   trade rows[100];
+   memset(rows, 0, sizeof(rows));
+   for (uint32_t n = 0; n < 100; ++n) {
+      rows[n].mPrice = n * 0.5;
+      rows[n].mQuantity = n * 10;
+      rows[n].mVenue = (uint16_t)(n % 7);
+      rows[n].mSide = (uint8_t)(n & 1);
+   }
+   for (uint32_t n = 0; n < 30; ++n) {
+      tfzassert(pTest, soaPushRow(sv, &rows[n]), success, false);
+   }
+   tfzassert(pTest, soaPushRows(sv, &rows[30], 70), success, false);
+   tfzassert(pTest, soaGetCount(sv) == 100, true, false);
+
+   // Whole rows read back.
+   trade row;
+   memset(&row, 0, sizeof(row));
+   tfzassert(pTest, soaGetRow(sv, 42, &row), success, false);
+   tfzassert_buf(pTest, &row, sizeof(row), &rows[42], sizeof(row), false);
+   tfzassert(pTest, soaGetRow(sv, 100, &row), fail, false);
+
+   // Columns are contiguous.
+   cvspan prices = soaColumn(sv, 0);
+   tfzassert_ui32(pTest, prices.mStride, sizeof(double), false);
+   tfzassert(pTest, cvSpanCount(prices) == 100, true, false);
+   double total = 0;
+   cvforeach(double, p, prices) {
+      total += *p;
+   }
+   tfzassert(pTest, total == 2475.0, true, false);
+   cvspan quantities = soaColumn(sv, 1);
+   tfzassert_ui32(pTest, ((uint32_t*)quantities.mpBegin)[99], 990, false);
+   tfzassert(pTest, soaColumn(sv, 4).mpBegin == null, true, false);
+
+   // Field access and row updates.
+   tfzassert_ui32(pTest, *(uint16_t*)soaGetField(sv, 13, 2), 6, false);
+   tfzassert_ptr(pTest, soaGetField(sv, 100, 0), null, false);
+   tfzassert_ptr(pTest, soaGetField(sv, 0, 4), null, false);
+   row.mQuantity = 7;
+   tfzassert(pTest, soaSetRow(sv, 0, &row), success, false);
+   tfzassert_ui32(pTest, *(uint32_t*)soaGetField(sv, 0, 1), 7, false);
+
+   // Pop, clear and shrink.
+   soaPopBack(sv);
+   tfzassert(pTest, soaGetCount(sv) == 99, true, false);
+   tfzassert(pTest, cvSpanCount(soaColumn(sv, 3)) == 99, true, false);
+   soaClear(sv);
+   soaShrink(sv);
+   tfzassert(pTest, soaGetCount(sv) == 0, true, false);
+   tfzassert(pTest, soaReserve(sv, 1000), success, false);
+   tfzassert(pTest, soaPushRow(sv, &rows[5]), success, false);
+   tfzassert(pTest, soaGetRow(sv, 0, &row), success, false);
+   tfzassert_buf(pTest, &row, sizeof(row), &rows[5], sizeof(row), false);
+
+   // Success.
+   soadestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("soavector tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testCreate(tfz);
+   testRows(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
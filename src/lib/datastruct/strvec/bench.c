@@ -0,0 +1,194 @@
+/*
+Date: 17 Oct 2026 20:24:18.782051398
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_9C5E1A3F7B0D42686B4F0D8A2E6C3B51__
+Purpose: Benchmarks for strvec.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (access, footprint)
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <commons.h>
+#include <vector.h>
+#include <strvec.h>
+
+//
+// MACROS
+//
+
+// Largest power of ten of strings benchmarked unless given on the command
+// line.
+#define BENCH_DEFAULT_MAXEXP                 6
+// Fixed slot size of the vector compared against.
+#define BENCH_SLOTSIZE                       256
+// Random reads timed per size (and on the walked list, which is O(n) each).
+#define BENCH_GETS                           4000000
+#define BENCH_LIST_GETS                      2000
+// Distinct strings when deduplicating.
+#define BENCH_DISTINCT                       1000
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+// Next pseudo random number.
+uint64_t benchRandom(uint64_t* pSeed)
+{
+   *pSeed ^= *pSeed << 13;
+   *pSeed ^= *pSeed >> 7;
+   *pSeed ^= *pSeed << 17;
+   return *pSeed;
+}
+
+// Writes string id (4 to 63 characters) to pDest and returns its length.
+uint32_t benchString(char* pDest, uint64_t id)
+{
+   uint32_t length = (uint32_t)snprintf(pDest, 64, "%" PRIu64 ":", id);
+   uint32_t target = 4 + (uint32_t)((id * 2654435761u) % 60);
+   for (; length < target; ++length) pDest[length] = 'a' + (length % 26);
+   pDest[length] = 0;
+   return length;
+}
+
+//
+// BENCHMARKS
+//
+
+// Fills a string vector, a vector of fixed slots and a list of size prefixed
+// records walked from its head (the layout and lookup of contmemlist), then
+// times random reads of each and reports the bytes each one needs.
+void benchStrings(uint64_t count)
+{
+   strvec sv = stcreate();
+   strvec dedup = stcreatex(stfdedup);
+   cvector slots = cvcreate(BENCH_SLOTSIZE);
+   uint8_t* pList = (uint8_t*)malloc(count * (sizeof(uint32_t) + 64));
+   if (!sv || !dedup || !slots || !pList) {
+      stdestroy(&sv);
+      stdestroy(&dedup);
+      cvdestroy(&slots);
+      free(pList);
+      return;
+   }
+
+   // Fill.
+   char str[BENCH_SLOTSIZE];
+   uint64_t listBytes = 0;
+   for (uint64_t n = 0; n < count; ++n) {
+      memset(str, 0, sizeof(str));
+      uint32_t length = benchString(str, n);
+      stPush(sv, str, length);
+      cvPushBack(slots, str);
+      memcpy(pList + listBytes, &length, sizeof(uint32_t));
+      memcpy(pList + listBytes + sizeof(uint32_t), str, length);
+      listBytes += sizeof(uint32_t) + length;
+
+      length = benchString(str, n % BENCH_DISTINCT);
+      stPush(dedup, str, length);
+   }
+
+   // Random reads: first byte and length of each string.
+   uint64_t sums[3] = { 0 }, seed = 88172645463325252ull;
+   double start = benchNow();
+   for (uint64_t n = 0; n < BENCH_GETS; ++n) {
+      stview view = stGet(sv, benchRandom(&seed) % count);
+      sums[0] += view.mLength + (uint8_t)view.mpData[0];
+   }
+   double stRate = BENCH_GETS / (benchNow() - start) / 1e6;
+
+   seed = 88172645463325252ull;
+   start = benchNow();
+   for (uint64_t n = 0; n < BENCH_GETS; ++n) {
+      const char* p = (const char*)cvGetAt(slots, benchRandom(&seed) % count);
+      sums[1] += strlen(p) + (uint8_t)p[0];
+   }
+   double slotRate = BENCH_GETS / (benchNow() - start) / 1e6;
+
+   seed = 88172645463325252ull;
+   start = benchNow();
+   for (uint64_t n = 0; n < BENCH_LIST_GETS; ++n) {
+      uint64_t index = benchRandom(&seed) % count;
+      uint8_t* p = pList;
+      uint32_t length;
+      for (;;) {
+         memcpy(&length, p, sizeof(uint32_t));
+         if (index-- == 0) break;
+         p += sizeof(uint32_t) + length;
+      }
+      sums[2] += length + p[sizeof(uint32_t)];
+   }
+   double listRate = BENCH_LIST_GETS / (benchNow() - start) / 1e6;
+
+   // Bytes needed per string.
+   uint64_t stBytes = stGetBytes(sv) + cvSpanCount(stOffsets(sv)) *
+      sizeof(uint64_t);
+   uint64_t dedupBytes = stGetBytes(dedup) + cvSpanCount(stOffsets(dedup)) *
+      sizeof(uint64_t) + cvSpanCount(stCodes(dedup)) * sizeof(uint32_t);
+   printf("%10" PRIu64 " %10.2f %10.2f %10.4f %8.1f %8.1f %8.1f %8.1f %"
+      PRIu64 " %s\n",
+      count, stRate, slotRate, listRate, (double)stBytes / count,
+      (double)BENCH_SLOTSIZE, (double)listBytes / count,
+      (double)dedupBytes / count, sums[2] & 1,
+      (sums[0] == sums[1] ? "" : "(mismatch!)")
+   );
+
+   stdestroy(&sv);
+   stdestroy(&dedup);
+   cvdestroy(&slots);
+   free(pList);
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 7) maxExp = 7;
+
+   // Million random reads per second, then bytes per string: the string
+   // vector, fixed slots, the size prefixed list and the string vector
+   // deduplicating strings drawn from 1000 distinct ones (the last column
+   // keeps the list sums alive).
+   printf("%10s %10s %10s %10s %8s %8s %8s %8s\n", "strings", "strvec",
+      "slots", "list", "strvec B", "slots B", "list B", "dedup B");
+   uint64_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) benchStrings(count);
+
+   return 0;
+}
@@ -0,0 +1,394 @@
+/*
+Date: 17 Oct 2026 20:24:18.751384207
+File: strvec.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __STRVEC_C_5A2D8F1C0E6B43977D3F1A9C5E0B2D64__
+Purpose: Implements a vector of variable length strings stored back to back
+         in one byte blob with a vector of offsets into it. With
+         deduplication a hash map finds strings already in the blob.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+#include <string.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <hashmap.h>
+#include <strvec.h>
+
+//
+// MACROS
+//
+
+// Longest string and most distinct strings with stfdedup.
+#define STRVEC_MAXLENGTH                     ((uint64_t)UINT32_MAX)
+#define STRVEC_MAXCODES                      ((uint64_t)UINT32_MAX)
+
+//
+// STRUCTS
+//
+
+// mOffsets always holds one more entry than there are strings in mBlob (the
+// first is 0). With stfdedup, mCodes holds the string of each push and mDict
+// maps a string hash to the string in the blob with that hash (colliding
+// strings are kept under the next free key, see stringsIntern).
+typedef struct _strs {
+   uint32_t mFlags;                                // stflags
+   cvector mBlob;                                  // string bytes
+   cvector mOffsets;                               // uint64_t per string + 1
+   cvector mCodes;                                 // uint32_t per push
+   hashmap mDict;                                  // hash -> uint32_t string
+} strs;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new string vector. Initially the vector will be empty.
+strvec stcreate()
+{
+   return stcreatex(stfnone);
+}
+
+// Create a new string vector with stflags.
+strvec stcreatex(uint32_t flags)
+{
+   strs* ps = (strs*)malloc(sizeof(strs));
+   if (!ps) return nul;
+   memset(ps, 0, sizeof(strs));
+   ps->mFlags = flags;
+
+   // Create the vectors. Blob bytes are always copied over; never scrub.
+   uint64_t zero = 0;
+   bool ok = (nul != (ps->mBlob = cvcreatex(1, cvfnoscrub))) &&
+      (nul != (ps->mOffsets = cvcreate(sizeof(uint64_t)))) &&
+      (nul != cvPushBack(ps->mOffsets, &zero));
+   if (ok && (flags & stfdedup)) {
+      ok = (nul != (ps->mCodes = cvcreate(sizeof(uint32_t)))) &&
+         (nul != (ps->mDict = hmcreate(sizeof(uint64_t), sizeof(uint32_t))));
+   }
+   if (!ok) {
+      strvec sv = (strvec)ps;
+      stdestroy(&sv);
+      return nul;
+   }
+
+   // Done.
+   return (strvec)ps;
+}
+
+// Destroy existing string vector.
+void stdestroy(strvec* psv)
+{
+   if (nul == psv) return;
+   if (nul == (*psv)) return;
+
+   strs* s = (strs*)*psv;
+   cvdestroy(&s->mBlob);
+   cvdestroy(&s->mOffsets);
+   cvdestroy(&s->mCodes);
+   hmdestroy(&s->mDict);
+
+   free(*psv);
+   *psv = 0;
+}
+
+//
+// Private API - Blob.
+//
+
+// Returns the number of strings in the blob.
+uint64_t stringsUnique(const strs* ps)
+{
+   return cvCount(ps->mOffsets) - 1;
+}
+
+// Returns string index of the blob.
+stview stringsAt(const strs* ps, uint64_t index)
+{
+   const uint64_t* pOffsets = (const uint64_t*)cvData(ps->mOffsets);
+   const char* pBlob = (const char*)cvData(ps->mBlob);
+
+   stview view;
+   view.mpData = (pBlob ? pBlob + pOffsets[index] : "");
+   view.mLength = pOffsets[index + 1] - pOffsets[index];
+   return view;
+}
+
+// Adds a string to the end of the blob.
+retcode stringsAppend(strs* ps, const char* pData, uint64_t length)
+{
+   uint64_t unique = stringsUnique(ps);
+   if (fail == cvReserve(ps->mOffsets, unique + 2)) return fail;
+
+   if (length > 0) {
+      void* pDest = cvEmplaceBackN(ps->mBlob, length);
+      if (!pDest) return fail;
+      memcpy(pDest, pData, length);
+   }
+
+   uint64_t offset = cvCount(ps->mBlob);
+   cvPushBack(ps->mOffsets, &offset);
+   return success;
+}
+
+// Adds a code for a string, adding the string to the blob if it is not there
+// already. Where two different strings share a hash, the second is kept
+// under the next free key (hash + 1 and so on) so lookups probe on until
+// they find the string or a free key.
+retcode stringsIntern(strs* ps, const char* pData, uint64_t length)
+{
+   uint64_t count = cvCount(ps->mCodes);
+   if (fail == cvReserve(ps->mCodes, count + 1)) return fail;
+
+   uint64_t key = hmHashBytes(pData, (uint32_t)length);
+   bool inserted = false;
+   uint32_t* pCode = nul;
+   for (;; ++key) {
+      pCode = (uint32_t*)hmEmplace(ps->mDict, &key, &inserted);
+      if (!pCode) return fail;
+      if (inserted) break;
+
+      stview view = stringsAt(ps, *pCode);
+      if (view.mLength == length &&
+         0 == memcmp(view.mpData, pData, length)) break;
+   }
+
+   uint32_t code = *pCode;
+   if (inserted) {
+      code = (uint32_t)stringsUnique(ps);
+      if (code >= STRVEC_MAXCODES ||
+         fail == stringsAppend(ps, pData, length)) {
+         hmErase(ps->mDict, &key);
+         return fail;
+      }
+      *pCode = code;
+   }
+
+   cvPushBack(ps->mCodes, &code);
+   return success;
+}
+
+//
+// Size management.
+//
+
+// Returns the number of strings pushed.
+uint64_t stGetCount(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps) return 0;
+   if (ps->mFlags & stfdedup) return cvCount(ps->mCodes);
+   return stringsUnique(ps);
+}
+
+// Returns the number of strings in the blob (stGetCount() without stfdedup).
+uint64_t stGetUniqueCount(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps) return 0;
+   return stringsUnique(ps);
+}
+
+// Returns the number of bytes in the blob.
+uint64_t stGetBytes(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps) return 0;
+   return cvCount(ps->mBlob);
+}
+
+// Reserve room for count strings (in total) of bytes (in total) bytes. With
+// stfdedup every string is assumed unique.
+retcode stReserve(strvec sv, uint64_t count, uint64_t bytes)
+{
+   strs* ps = (strs*)sv;
+   if (!ps) return fail;
+
+   if (fail == cvReserve(ps->mBlob, bytes)) return fail;
+   if (fail == cvReserve(ps->mOffsets, count + 1)) return fail;
+   if (ps->mFlags & stfdedup) {
+      if (fail == cvReserve(ps->mCodes, count)) return fail;
+      return hmReserve(ps->mDict, count);
+   }
+   return success;
+}
+
+// Removes all strings.
+void stClear(strvec sv)
+{
+   strs* ps = (strs*)sv;
+   if (!ps) return;
+
+   cvClear(ps->mBlob);
+   cvClear(ps->mOffsets);
+   cvClear(ps->mCodes);
+   hmClear(ps->mDict);
+
+   // The first offset is never removed so there is room for it.
+   uint64_t zero = 0;
+   cvPushBack(ps->mOffsets, &zero);
+}
+
+// Frees unused memory.
+void stShrink(strvec sv)
+{
+   strs* ps = (strs*)sv;
+   if (!ps) return;
+
+   cvShrink(ps->mBlob);
+   cvShrink(ps->mOffsets);
+   cvShrink(ps->mCodes);
+   hmShrink(ps->mDict);
+}
+
+//
+// Strings.
+//
+
+// Adds a copy of length bytes at pData.
+retcode stPush(strvec sv, const char* pData, uint64_t length)
+{
+   strs* ps = (strs*)sv;
+   if (!ps) return fail;
+   if (!pData && length > 0) return fail;
+   if (length > STRVEC_MAXLENGTH) return fail;
+   if (!pData) pData = "";
+
+   if (ps->mFlags & stfdedup) return stringsIntern(ps, pData, length);
+   return stringsAppend(ps, pData, length);
+}
+
+// Adds a copy of a nul terminated string (without the terminator).
+retcode stPushStr(strvec sv, const char* str)
+{
+   if (!str) return fail;
+   return stPush(sv, str, strlen(str));
+}
+
+// Adds count strings stored back to back in pData. Without stfdedup all the
+// bytes are copied in one go.
+retcode stPushN(strvec sv, const char* pData, const uint64_t* pLengths,
+   uint64_t count)
+{
+   strs* ps = (strs*)sv;
+   if (!ps || !pLengths) return fail;
+   if (count == 0) return success;
+
+   // Validate the lengths.
+   uint64_t total = 0;
+   for (uint64_t n = 0; n < count; ++n) {
+      if (pLengths[n] > STRVEC_MAXLENGTH) return fail;
+      total += pLengths[n];
+   }
+   if (!pData && total > 0) return fail;
+
+   // One string at a time when deduplicating.
+   if (ps->mFlags & stfdedup) {
+      if (fail == cvReserve(ps->mCodes, cvCount(ps->mCodes) + count)) {
+         return fail;
+      }
+      for (uint64_t n = 0; n < count; ++n) {
+         if (fail == stringsIntern(ps, pData, pLengths[n])) return fail;
+         pData += pLengths[n];
+      }
+      return success;
+   }
+
+   // Otherwise copy all bytes and then add the offsets.
+   uint64_t offset = cvCount(ps->mBlob);
+   if (fail == cvReserve(ps->mOffsets, cvCount(ps->mOffsets) + count)) {
+      return fail;
+   }
+   if (total > 0) {
+      void* pDest = cvEmplaceBackN(ps->mBlob, total);
+      if (!pDest) return fail;
+      memcpy(pDest, pData, total);
+   }
+
+   uint64_t* pOffsets = (uint64_t*)cvEmplaceBackN(ps->mOffsets, count);
+   for (uint64_t n = 0; n < count; ++n) {
+      offset += pLengths[n];
+      pOffsets[n] = offset;
+   }
+   return success;
+}
+
+// Returns a view of string index. The view is empty (mpData null) if there
+// is no such string.
+stview stGet(cstrvec csv, uint64_t index)
+{
+   stview view = { nul, 0 };
+   const strs* ps = (const strs*)csv;
+   if (!ps || index >= stGetCount(csv)) return view;
+
+   if (ps->mFlags & stfdedup) {
+      index = ((const uint32_t*)cvData(ps->mCodes))[index];
+   }
+   return stringsAt(ps, index);
+}
+
+//
+// Arrow layout.
+//
+
+// Returns a span over the offsets (stGetUniqueCount() + 1 uint64_t values).
+cvspan stOffsets(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+   return cvSpan(ps->mOffsets);
+}
+
+// Returns a span over the blob bytes.
+cvspan stBlob(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+   return cvSpan(ps->mBlob);
+}
+
+// Returns a span over the codes (empty without stfdedup).
+cvspan stCodes(cstrvec csv)
+{
+   const strs* ps = (const strs*)csv;
+   if (!ps || !ps->mCodes) {
+      cvspan empty = { nul, nul, 0 };
+      return empty;
+   }
+   return cvSpan(ps->mCodes);
+}
@@ -0,0 +1,211 @@
+/*
+Date: 17 Oct 2026 20:24:18.766920153
+File: test.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __TEST_C_2D7F0B4E9A3C46815E9D2C7A0F4B1E36__
+Purpose: Tests for strvec.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <commons.h>
+#include <testfaze.h>
+#include <vector.h>
+#include <strvec.h>
+
+//
+// MACROS
+//
+
+// Strings pushed by the tests.
+#define TEST_STRINGS                         3000
+
+//
+// HELPERS
+//
+
+// Writes string n of the tests to pDest (at least 64 bytes) and returns its
+// length. Lengths run from 0 to 40; with distinct false only 50 different
+// strings are made.
+uint64_t makeString(char* pDest, uint32_t n, bool distinct)
+{
+   uint32_t id = (distinct ? n : (n * 7) % 50);
+   uint32_t length = (uint32_t)snprintf(pDest, 64, "s%u-", id);
+   for (uint32_t r = id % 41; r > length; --r) pDest[length++] = 'a' + r % 26;
+   if (id == 0) length = 0;
+   return length;
+}
+
+// Returns true if view holds the length bytes at pData.
+bool viewIs(stview view, const char* pData, uint64_t length)
+{
+   if (!view.mpData || view.mLength != length) return false;
+   return (0 == memcmp(view.mpData, pData, length));
+}
+
+//
+// TEST CASES
+//
+
+// Tests pushing and reading strings one by one and in bulk.
+bool testPush(TFSuite pTest)
+{
+   strvec sv = stcreate();
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+   tfzassert_ptr(pTest, (void*)stGet(sv, 0).mpData, null, false);
+   tfzassert(pTest, cvSpanCount(stOffsets(sv)) == 1, true, false);
+
+   // One by one, then the same strings in bulk.
+   static char bulk[TEST_STRINGS * 64];
+   static uint64_t lengths[TEST_STRINGS];
+   uint64_t bytes = 0;
+   bool ok = true;
+   for (uint32_t n = 0; n < TEST_STRINGS; ++n) {
+      lengths[n] = makeString(&bulk[bytes], n, true);
+      ok = ok && (stPush(sv, &bulk[bytes], lengths[n]) == success);
+      bytes += lengths[n];
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, stPushN(sv, bulk, lengths, TEST_STRINGS), success, false);
+   tfzassert(pTest, stPushStr(sv, "last"), success, false);
+   tfzassert(pTest, stPush(sv, null, 1), fail, false);
+   tfzassert(pTest, stGetCount(sv) == TEST_STRINGS * 2 + 1, true, false);
+   tfzassert(pTest, stGetBytes(sv) == bytes * 2 + 4, true, false);
+
+   // Every string reads back in place.
+   ok = true;
+   for (uint32_t pass = 0; pass < 2; ++pass) {
+      uint64_t offset = 0;
+      for (uint32_t n = 0; n < TEST_STRINGS; ++n) {
+         stview view = stGet(sv, pass * TEST_STRINGS + n);
+         if (!viewIs(view, &bulk[offset], lengths[n])) ok = false;
+         offset += lengths[n];
+      }
+   }
+   tfzassert(pTest, ok, true, false);
+   tfzassert(pTest, viewIs(stGet(sv, TEST_STRINGS * 2), "last", 4), true,
+      false);
+
+   // Arrow layout: offsets from 0 to the blob size.
+   cvspan offsets = stOffsets(sv);
+   uint64_t* pOffsets = (uint64_t*)offsets.mpBegin;
+   tfzassert(pTest, cvSpanCount(offsets) == stGetCount(sv) + 1, true, false);
+   tfzassert(pTest, pOffsets[0] == 0, true, false);
+   tfzassert(pTest, pOffsets[stGetCount(sv)] == stGetBytes(sv), true, false);
+   tfzassert(pTest, cvSpanCount(stBlob(sv)) == stGetBytes(sv), true, false);
+   tfzassert(pTest, cvSpanCount(stCodes(sv)) == 0, true, false);
+
+   // Clearing keeps a first offset.
+   stClear(sv);
+   stShrink(sv);
+   tfzassert(pTest, stGetCount(sv) == 0, true, false);
+   tfzassert(pTest, stPushStr(sv, ""), success, false);
+   tfzassert(pTest, stGet(sv, 0).mLength == 0, true, false);
+   tfzassert(pTest, stGet(sv, 0).mpData != null, true, false);
+
+   // Success.
+   stdestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+// Tests that repeated strings are stored once with deduplication.
+bool testDedup(TFSuite pTest)
+{
+   strvec sv = stcreatex(stfdedup);
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, stReserve(sv, TEST_STRINGS, 1000), success, false);
+
+   // Half pushed one by one, half in bulk.
+   static char bulk[TEST_STRINGS * 64];
+   static uint64_t lengths[TEST_STRINGS];
+   char str[64];
+   uint64_t bytes = 0;
+   for (uint32_t n = 0; n < TEST_STRINGS / 2; ++n) {
+      stPush(sv, str, makeString(str, n, false));
+   }
+   for (uint32_t n = TEST_STRINGS / 2; n < TEST_STRINGS; ++n) {
+      lengths[n] = makeString(&bulk[bytes], n, false);
+      bytes += lengths[n];
+   }
+   tfzassert(pTest, stPushN(sv, bulk, &lengths[TEST_STRINGS / 2],
+      TEST_STRINGS - TEST_STRINGS / 2), success, false);
+   tfzassert(pTest, stGetCount(sv) == TEST_STRINGS, true, false);
+   tfzassert(pTest, stGetUniqueCount(sv) == 50, true, false);
+   tfzassert(pTest, cvSpanCount(stCodes(sv)) == TEST_STRINGS, true, false);
+
+   // Each string reads back; equal strings share their bytes.
+   bool ok = true;
+   for (uint32_t n = 0; n < TEST_STRINGS; ++n) {
+      stview view = stGet(sv, n);
+      if (!viewIs(view, str, makeString(str, n, false))) ok = false;
+      if (n >= 50 && view.mpData != stGet(sv, n - 50).mpData) ok = false;
+   }
+   tfzassert(pTest, ok, true, false);
+
+   // Clearing also forgets the dictionary.
+   stClear(sv);
+   tfzassert(pTest, stPushStr(sv, "again"), success, false);
+   tfzassert(pTest, stPushStr(sv, "again"), success, false);
+   tfzassert(pTest, stGetCount(sv) == 2, true, false);
+   tfzassert(pTest, stGetUniqueCount(sv) == 1, true, false);
+   tfzassert(pTest, stGetBytes(sv) == 5, true, false);
+
+   // Success.
+   stdestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+void runTests()
+{
+   // Test suite.
+   TFSuite tfz = tfzCreate("strvec tests");
+   if (!tfz) {
+      printf("alloc() fail!\n");
+      return;
+   }
+
+   // Individual tests.
+   testPush(tfz);
+   testDedup(tfz);
+
+   // Show results.
+   tfzShowResults(tfz);
+   tfzDestroy(&tfz);
+}
+
+int main(int argc, char** argv)
+{
+   runTests();
+
+   return 0;
+}
@@ -0,0 +1,564 @@
+/*
+Date: 17 Oct 2026 10:12:31.118402561
+File: bench.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __BENCH_C_8E0C2F4A7D1B6E93A5C04F17D2B8E6A1__
+Purpose: Benchmarks for vector.c.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development (growth policies)
+17 Oct 2026 Duncan Camilleri           Typed vs untyped push and scan
+17 Oct 2026 Duncan Camilleri           Scrub vs no-scrub refill cycles
+17 Oct 2026 Duncan Camilleri           Segmented vs contiguous push latency
+17 Oct 2026 Duncan Camilleri           Small buffer vector workload
+17 Oct 2026 Duncan Camilleri           Sorting and find
+17 Oct 2026 Duncan Camilleri           Parallel algorithm scaling
+17 Oct 2026 Duncan Camilleri           Concurrent append vs mutex push
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <memory.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <commons.h>
+#include <vector.h>
+#include <vectort.h>
+#include <segvector.h>
+#include <vectoralgo.h>
+#include <vectorpar.h>
+
+//
+// TYPES
+//
+
+CV_DECLARE(i32vec, int32_t)
+
+// Concurrent append producer.
+typedef struct _benchproducer {
+   cvector mVector;                                // mutex pushes (or null)
+   pthread_mutex_t* mpLock;
+   segvector mSegmented;                           // concurrent appends
+   uint32_t mCount;                                // items to add
+} benchproducer;
+
+//
+// MACROS
+//
+
+// Largest power of ten benchmarked unless given on the command line.
+#define BENCH_DEFAULT_MAXEXP                 8
+// Fixed chunk growth is quadratic; keep it to sizes that finish.
+#define BENCH_FIXED_MAXEXP                   6
+// Linear scans are repeated; keep them to sizes that finish.
+#define BENCH_FIND_MAXEXP                    7
+// Parallel runs use a single vector of 10^exp items.
+#define BENCH_PAR_MAXEXP                     8
+// Concurrent appends total 10^exp items at most.
+#define BENCH_APPEND_MAXEXP                  7
+#define BENCH_APPEND_MAXTHREADS              32
+
+//
+// HELPERS
+//
+
+// Returns a monotonic time stamp in seconds.
+double benchNow()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+//
+// BENCHMARKS
+//
+
+// Pushes count items into a vector using the growth policy given and reports
+// the number of data buffer allocations along with the push throughput.
+void benchGrowth(const char* const pName,
+   cvgrowth policy, uint32_t param, uint32_t count)
+{
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (!cv) return;
+   cvSetGrowthPolicy(cv, policy, param);
+
+   double start = benchNow();
+   for (uint32_t n = 0; n < count; ++n) {
+      if (!cvPushBack(cv, makecvitem(n))) {
+         printf("%-16s %12" PRIu32 " push failed\n", pName, count);
+         cvdestroy(&cv);
+         return;
+      }
+   }
+   double elapsed = benchNow() - start;
+
+   printf("%-16s %12" PRIu32 " %10" PRIu32 " %12.2f\n", pName, count,
+      cvGetAllocCount(cv), elapsed > 0 ? (count / elapsed) / 1e6 : 0.0
+   );
+   cvdestroy(&cv);
+}
+
+// Pushes and then sums count integers through the untyped api and through a
+// typed vector (vectort.h).
+void benchTyped(uint32_t count)
+{
+   cvector cv = cvcreate(sizeof(int32_t));
+   cvector tv = i32vec_create();
+   if (!cv || !tv) {
+      cvdestroy(&cv);
+      cvdestroy(&tv);
+      return;
+   }
+
+   // Untyped.
+   double start = benchNow();
+   for (int32_t n = 0; n < (int32_t)count; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   double pushUntyped = benchNow() - start;
+
+   int64_t sumUntyped = 0;
+   start = benchNow();
+   for (uint32_t n = 0; n < count; ++n) {
+      sumUntyped += *(int32_t*)cvGetAt(cv, n);
+   }
+   double scanUntyped = benchNow() - start;
+
+   // Typed.
+   start = benchNow();
+   for (int32_t n = 0; n < (int32_t)count; ++n) {
+      i32vec_push(tv, n);
+   }
+   double pushTyped = benchNow() - start;
+
+   int64_t sumTyped = 0;
+   start = benchNow();
+   int32_t* pData = i32vec_data(tv);
+   for (uint32_t n = 0; n < i32vec_count(tv); ++n) {
+      sumTyped += pData[n];
+   }
+   double scanTyped = benchNow() - start;
+
+   printf("%12" PRIu32 " %10.4f %10.4f %10.4f %10.4f %s\n", count,
+      pushUntyped, pushTyped, scanUntyped, scanTyped,
+      (sumUntyped == sumTyped ? "" : "(mismatch!)")
+   );
+   cvdestroy(&cv);
+   cvdestroy(&tv);
+}
+
+// Refills a vector of count integers a number of times, clearing it between
+// cycles, with the flags given (scrubbing or not).
+void benchRefill(const char* const pName, uint32_t flags, uint32_t count)
+{
+   const uint32_t cycles = 10;
+   cvector cv = cvcreatex(sizeof(uint32_t), flags);
+   if (!cv) return;
+
+   double start = benchNow();
+   for (uint32_t c = 0; c < cycles; ++c) {
+      uint32_t* pItems = (uint32_t*)cvEmplaceBackN(cv, count);
+      if (!pItems) break;
+      for (uint32_t n = 0; n < count; ++n) {
+         pItems[n] = n ^ c;
+      }
+      cvClear(cv);
+   }
+   double elapsed = benchNow() - start;
+
+   printf("%-16s %12" PRIu32 " %10.4f\n", pName, count, elapsed / cycles);
+   cvdestroy(&cv);
+}
+
+// Pushes count integers into a vector and into a segmented vector, reporting
+// the total time and the worst single push (growth spikes).
+void benchSegmented(uint32_t count)
+{
+   cvector cv = cvcreate(sizeof(uint32_t));
+   segvector sv = svcreate(sizeof(uint32_t), 0);
+   if (!cv || !sv) {
+      cvdestroy(&cv);
+      svdestroy(&sv);
+      return;
+   }
+
+   double worstVector = 0, worstSegmented = 0;
+   double start = benchNow();
+   for (uint32_t n = 0; n < count; ++n) {
+      double pushStart = benchNow();
+      cvPushBack(cv, makecvitem(n));
+      double pushTime = benchNow() - pushStart;
+      if (pushTime > worstVector) worstVector = pushTime;
+   }
+   double totalVector = benchNow() - start;
+
+   start = benchNow();
+   for (uint32_t n = 0; n < count; ++n) {
+      double pushStart = benchNow();
+      svPushBack(sv, &n);
+      double pushTime = benchNow() - pushStart;
+      if (pushTime > worstSegmented) worstSegmented = pushTime;
+   }
+   double totalSegmented = benchNow() - start;
+
+   printf("%12" PRIu32 " %10.4f %10.4f %12.1f %12.1f\n", count,
+      totalVector, totalSegmented, worstVector * 1e6, worstSegmented * 1e6
+   );
+   cvdestroy(&cv);
+   svdestroy(&sv);
+}
+
+// Creates count short vectors (0 to 11 items each), fills and sums them, with
+// and without small buffers of 8 items. Reports the allocations avoided.
+void benchSmallBuffer(uint32_t count)
+{
+   cvector* pVectors = (cvector*)malloc(sizeof(cvector) * count);
+   if (!pVectors) return;
+
+   for (int sbo = 0; sbo <= 1; ++sbo) {
+      cvResetAllocsAvoided();
+      uint64_t allocs = 0, sum = 0;
+      double start = benchNow();
+      for (uint32_t v = 0; v < count; ++v) {
+         pVectors[v] = sbo ? cvcreatesbo(sizeof(uint32_t), 8, cvfnone) :
+            cvcreate(sizeof(uint32_t));
+         if (!pVectors[v]) continue;
+         for (uint32_t n = 0; n < (v * 7) % 12; ++n) {
+            cvPushBack(pVectors[v], makecvitem(n));
+         }
+      }
+      for (uint32_t v = 0; v < count; ++v) {
+         if (!pVectors[v]) continue;
+         cvspan span = cvSpan(pVectors[v]);
+         cvforeach(uint32_t, p, span) {
+            sum += *p;
+         }
+         allocs += cvGetAllocCount(pVectors[v]);
+         cvdestroy(&pVectors[v]);
+      }
+      double elapsed = benchNow() - start;
+
+      printf("%-8s %12" PRIu32 " %10.4f %12" PRIu64 " %12" PRIu64 "\n",
+         sbo ? "sbo 8" : "regular", count, elapsed, allocs + count,
+         cvGetAllocsAvoided()
+      );
+   }
+
+   free(pVectors);
+}
+
+// Compares two int32_t items.
+int8_t benchCmpInt32(void* a, void* b)
+{
+   int32_t x = *(int32_t*)a;
+   int32_t y = *(int32_t*)b;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// Fills a vector with count pseudo random int32_t items.
+void benchFillRandom(cvector v, uint32_t count)
+{
+   cvClear(v);
+   uint32_t seed = 2463534242;
+   for (uint32_t n = 0; n < count; ++n) {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      i32vec_push(v, (int32_t)seed);
+   }
+}
+
+// Sorts count random items with each sort and reports the time taken.
+void benchSort(uint32_t count)
+{
+   cvector cv = i32vec_create();
+   if (!cv) return;
+
+   benchFillRandom(cv, count);
+   double start = benchNow();
+   cvSort(cv, benchCmpInt32);
+   double introTime = benchNow() - start;
+
+   benchFillRandom(cv, count);
+   start = benchNow();
+   cvStableSort(cv, benchCmpInt32);
+   double stableTime = benchNow() - start;
+
+   benchFillRandom(cv, count);
+   start = benchNow();
+   cvRadixSort(cv, true);
+   double radixTime = benchNow() - start;
+
+   printf("%12" PRIu32 " %10.4f %10.4f %10.4f\n",
+      count, introTime, stableTime, radixTime
+   );
+   i32vec_destroy(&cv);
+}
+
+// Looks up a missing item in count items with cvFind and with a comparator
+// driven scan and reports the scan throughput.
+void benchFind(uint32_t count)
+{
+   cvector cv = i32vec_create();
+   if (!cv) return;
+   for (uint32_t n = 0; n < count; ++n) {
+      i32vec_push(cv, (int32_t)n);
+   }
+
+   // Scan a total of about 10^8 items each way.
+   uint32_t rounds = 100000000 / count;
+   int32_t key = -1;
+   uint64_t found = 0;
+
+   double start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      found += (cvFind(cv, &key) == CV_NPOS);
+   }
+   double findTime = benchNow() - start;
+
+   start = benchNow();
+   for (uint32_t r = 0; r < rounds; ++r) {
+      uint64_t n = 0;
+      while (n < count && benchCmpInt32(i32vec_at(cv, n), &key) != 0) ++n;
+      found += (n == count);
+   }
+   double scanTime = benchNow() - start;
+
+   double items = (double)count * rounds;
+   printf("%12" PRIu32 " %12.1f %12.1f %8" PRIu64 "\n", count,
+      items / findTime / 1e6, items / scanTime / 1e6, found / 2
+   );
+   i32vec_destroy(&cv);
+}
+
+// Squares an int32_t item in place (wrapping).
+void benchParSquare(void* pItem, uint64_t index, void* pCtx)
+{
+   uint32_t x = *(uint32_t*)pItem;
+   *(uint32_t*)pItem = x * x + (uint32_t)index;
+}
+
+// Adds an int32_t item to an int64_t sum.
+void benchParSumItem(void* pAcc, const void* pItem, void* pCtx)
+{
+   *(int64_t*)pAcc += *(const int32_t*)pItem;
+}
+
+// Adds an int64_t chunk sum to an int64_t sum.
+void benchParSumChunk(void* pAcc, const void* pItem, void* pCtx)
+{
+   *(int64_t*)pAcc += *(const int64_t*)pItem;
+}
+
+// Runs for each, reduce and sort over count items with the thread count given
+// and reports the time taken by each.
+void benchParallel(uint32_t threads, uint32_t count)
+{
+   cvector cv = i32vec_create();
+   if (!cv) return;
+   cvParSetThreads(threads);
+
+   benchFillRandom(cv, count);
+   double start = benchNow();
+   cvParallelForEach(cv, benchParSquare, null);
+   double forEachTime = benchNow() - start;
+
+   int64_t sum = 0;
+   start = benchNow();
+   cvParallelReduce(cv, &sum, sizeof(sum),
+      benchParSumItem, benchParSumChunk, null);
+   double reduceTime = benchNow() - start;
+
+   benchFillRandom(cv, count);
+   start = benchNow();
+   cvParallelSort(cv, benchCmpInt32);
+   double sortTime = benchNow() - start;
+
+   printf("%8" PRIu32 " %12" PRIu32 " %10.4f %10.4f %10.4f\n",
+      threads, count, forEachTime, reduceTime, sortTime
+   );
+   i32vec_destroy(&cv);
+}
+
+// Pushes items into a shared vector under a mutex or appends them to a
+// concurrent segmented vector.
+void* benchProducer(void* pArg)
+{
+   benchproducer* pProducer = (benchproducer*)pArg;
+   for (uint32_t n = 0; n < pProducer->mCount; ++n) {
+      if (pProducer->mVector) {
+         pthread_mutex_lock(pProducer->mpLock);
+         cvPushBack(pProducer->mVector, makecvitem(n));
+         pthread_mutex_unlock(pProducer->mpLock);
+      } else {
+         svAppend(pProducer->mSegmented, &n);
+      }
+   }
+   return null;
+}
+
+// Runs threads producers adding count items in total, either through a
+// mutex around cvPushBack or with svAppend, and returns the time taken.
+double benchAppendRun(uint32_t threads, uint32_t count, bool concurrent)
+{
+   pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+   cvector cv = nul;
+   segvector sv = nul;
+   if (concurrent) {
+      sv = svcreatex(sizeof(uint32_t), 0, svfconcurrent, count);
+   } else {
+      cv = cvcreate(sizeof(uint32_t));
+   }
+   if (!cv && !sv) return 0;
+
+   pthread_t tids[BENCH_APPEND_MAXTHREADS];
+   benchproducer producers[BENCH_APPEND_MAXTHREADS];
+   double start = benchNow();
+   for (uint32_t t = 0; t < threads; ++t) {
+      producers[t].mVector = cv;
+      producers[t].mpLock = &lock;
+      producers[t].mSegmented = sv;
+      producers[t].mCount = count / threads;
+      pthread_create(&tids[t], null, benchProducer, &producers[t]);
+   }
+   for (uint32_t t = 0; t < threads; ++t) {
+      pthread_join(tids[t], null);
+   }
+   double elapsed = benchNow() - start;
+
+   cvdestroy(&cv);
+   svdestroy(&sv);
+   return elapsed;
+}
+
+// Compares mutex wrapped pushes with concurrent appends.
+void benchAppend(uint32_t threads, uint32_t count)
+{
+   double mutexTime = benchAppendRun(threads, count, false);
+   double appendTime = benchAppendRun(threads, count, true);
+
+   printf("%8" PRIu32 " %12" PRIu32 " %12.1f %12.1f\n", threads, count,
+      count / mutexTime / 1e6, count / appendTime / 1e6
+   );
+}
+
+int main(int argc, char** argv)
+{
+   int maxExp = BENCH_DEFAULT_MAXEXP;
+   if (argc > 1) maxExp = atoi(argv[1]);
+   if (maxExp < 3) maxExp = 3;
+   if (maxExp > 9) maxExp = 9;
+
+   // Growth policies.
+   printf("%-16s %12s %10s %12s\n", "policy", "items", "allocs", "Mpush/s");
+   uint32_t count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchGrowth("geometric 2x", cvgrowgeometric, 200, count);
+      benchGrowth("geometric 1.5x", cvgrowgeometric, 150, count);
+      benchGrowth("page rounded", cvgrowpage, 0, count);
+      if (exp <= BENCH_FIXED_MAXEXP) {
+         benchGrowth("fixed 8", cvgrowfixed, 8, count);
+      }
+   }
+
+   // Typed vectors.
+   printf("\n%12s %10s %10s %10s %10s\n", "items",
+      "push(s)", "push T(s)", "scan(s)", "scan T(s)");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchTyped(count);
+   }
+
+   // Scrubbing.
+   printf("\n%-16s %12s %10s\n", "refill", "items", "cycle(s)");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchRefill("scrub", cvfnone, count);
+      benchRefill("no-scrub", cvfnoscrub, count);
+   }
+
+   // Segmented vectors.
+   printf("\n%12s %10s %10s %12s %12s\n", "items",
+      "cv(s)", "sv(s)", "cv max(us)", "sv max(us)");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchSegmented(count);
+   }
+
+   // Small buffer vectors.
+   printf("\n%-8s %12s %10s %12s %12s\n", "vectors", "count", "time(s)",
+      "mallocs", "avoided");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp && exp <= 7; ++exp, count *= 10) {
+      benchSmallBuffer(count);
+   }
+
+   // Sorting.
+   printf("\n%12s %10s %10s %10s\n", "items",
+      "sort(s)", "stable(s)", "radix(s)");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp; ++exp, count *= 10) {
+      benchSort(count);
+   }
+
+   // Linear find.
+   printf("\n%12s %12s %12s %8s\n", "items", "find Mi/s", "scan Mi/s",
+      "rounds");
+   count = 1000;
+   for (int exp = 3; exp <= maxExp && exp <= BENCH_FIND_MAXEXP;
+      ++exp, count *= 10) {
+      benchFind(count);
+   }
+
+   // Parallel scaling from 1 thread to one per cpu.
+   long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+   if (cpus < 1) cpus = 1;
+   count = 1;
+   for (int exp = 0; exp < maxExp && exp < BENCH_PAR_MAXEXP; ++exp) {
+      count *= 10;
+   }
+   printf("\n%8s %12s %10s %10s %10s\n", "threads", "items",
+      "each(s)", "reduce(s)", "sort(s)");
+   for (uint32_t threads = 1; threads < (uint32_t)cpus; threads *= 2) {
+      benchParallel(threads, count);
+   }
+   benchParallel((uint32_t)cpus, count);
+   cvParShutdown();
+
+   // Concurrent appends.
+   count = 1;
+   for (int exp = 0; exp < maxExp && exp < BENCH_APPEND_MAXEXP; ++exp) {
+      count *= 10;
+   }
+   printf("\n%8s %12s %12s %12s\n", "threads", "items",
+      "mutex Mi/s", "append Mi/s");
+   for (uint32_t threads = 1; threads <= BENCH_APPEND_MAXTHREADS;
+      threads *= 2) {
+      benchAppend(threads, count);
+   }
+
+   return 0;
+}
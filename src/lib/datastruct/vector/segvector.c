@@ -0,0 +1,506 @@
+/*
+Date: 17 Oct 2026 12:40:11.887104533
+File: segvector.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __SEGVECTOR_C_6D2B8F0A4E17C93B5A0E6D24F8C1B7E3__
+Purpose: Implements a segmented vector api. Items are stored in fixed size
+         chunks listed in a small directory. Appending never moves existing
+         items, so item pointers stay valid until the item is removed, and
+         growth costs one chunk allocation rather than a copy of all items.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+17 Oct 2026 Duncan Camilleri           Concurrent append mode (svfconcurrent)
+17 Oct 2026 Duncan Camilleri           svAppendCommit() reports lost items
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <segvector.h>
+
+//
+// MACROS
+//
+#define SEGVECTOR_DEFAULT_CHUNKITEMS         1024
+#define SEGVECTOR_MAX_CHUNKSHIFT             30
+
+//
+// STRUCTS
+//
+
+// The directory is a plain vector of chunk pointers; chunks never move, only
+// the directory does when it grows. Concurrent vectors fill the directory
+// with null pointers up front and chunks are swapped in atomically, so the
+// directory never moves either. Their chunks end with one ready flag per item
+// and mItemCount is the published count: all items before it are ready.
+typedef struct _segvec {
+   uint32_t mItemSize;                             // size per item
+   uint32_t mChunkShift;                           // log2(items per chunk)
+   uint64_t mChunkMask;                            // items per chunk - 1
+   uint64_t mItemCount;                            // number of items
+   cvector mDirectory;                             // chunk pointers
+   uint32_t mFlags;                                // svflags
+   uint64_t mLostFrom;                             // concurrent: out of memory
+   uint64_t mMaxItems;                             // concurrent: item limit
+   uint64_t mReserved;                             // concurrent: next index
+} segvec;
+
+//
+// CREATION/DESTRUCTION.
+//
+
+// Create a new segmented vector. Initially the vector will be empty. No chunk
+// will be allocated unless necessary.
+segvector svcreate(uint32_t itemSize, uint32_t chunkItems)
+{
+   return svcreatex(itemSize, chunkItems, svfnone, 0);
+}
+
+// Create a new segmented vector with flags. maxItems is the item limit of
+// svfconcurrent vectors and is ignored otherwise.
+segvector svcreatex(uint32_t itemSize, uint32_t chunkItems, uint32_t flags,
+   uint64_t maxItems)
+{
+   if (itemSize == 0) return nul;
+   if ((flags & svfconcurrent) && maxItems == 0) return nul;
+   if (chunkItems == 0) chunkItems = SEGVECTOR_DEFAULT_CHUNKITEMS;
+
+   // Items per chunk is a power of two so that indexing is shift and mask.
+   uint32_t shift = 0;
+   while (((uint64_t)1 << shift) < chunkItems) {
+      if (++shift > SEGVECTOR_MAX_CHUNKSHIFT) return nul;
+   }
+
+   // Allocate vector for now.
+   segvec* psv = (segvec*)malloc(sizeof(segvec));
+   if (!psv) return nul;
+   memset(psv, 0, sizeof(segvec));
+
+   psv->mDirectory = cvcreate(sizeof(void*));
+   if (!psv->mDirectory) {
+      free(psv);
+      return nul;
+   }
+
+   // Initialize.
+   psv->mItemSize = itemSize;
+   psv->mChunkShift = shift;
+   psv->mChunkMask = ((uint64_t)1 << shift) - 1;
+   psv->mItemCount = 0;
+   psv->mFlags = flags;
+
+   // Concurrent vectors get every directory entry now.
+   if (flags & svfconcurrent) {
+      uint64_t chunks = (maxItems >> shift) +
+         ((maxItems & psv->mChunkMask) != 0);
+      psv->mMaxItems = maxItems;
+      psv->mLostFrom = UINT64_MAX;
+      if (!cvEmplaceBackN(psv->mDirectory, chunks)) {
+         cvdestroy(&psv->mDirectory);
+         free(psv);
+         return nul;
+      }
+   }
+
+   // Done.
+   return (segvector)psv;
+}
+
+// Destroy existing segmented vector.
+void svdestroy(segvector* psv)
+{
+   if (nul == psv) return;
+   if (nul == (*psv)) return;
+
+   // Free chunks first.
+   segvec* sv = (segvec*)*psv;
+   uint64_t chunks = cvCount(sv->mDirectory);
+   for (uint64_t c = 0; c < chunks; ++c) {
+      free(*(void**)cvAt(sv->mDirectory, c));
+   }
+   cvdestroy(&sv->mDirectory);
+
+   free(*psv);
+   *psv = 0;
+}
+
+//
+// Private API - Memory allocation.
+//
+
+// Returns the address of the item at index. Never pass an index beyond the
+// allocated chunks.
+void* segItem(const segvec* psv, uint64_t index)
+{
+   void* pChunk = *(void**)cvAt(psv->mDirectory, index >> psv->mChunkShift);
+   return pChunk + ((size_t)(index & psv->mChunkMask) * psv->mItemSize);
+}
+
+// Returns the number of published items.
+uint64_t segCount(const segvec* psv)
+{
+   return __atomic_load_n(&psv->mItemCount, __ATOMIC_ACQUIRE);
+}
+
+// Returns the ready flag of item index in a concurrent vector chunk.
+uint8_t* segReadyFlag(const segvec* psv, void* pChunk, uint64_t index)
+{
+   return (uint8_t*)pChunk + ((size_t)psv->mItemSize << psv->mChunkShift) +
+      (index & psv->mChunkMask);
+}
+
+// Returns chunk number chunk of a concurrent vector, adding it if missing.
+// Threads racing to add the same chunk all allocate one; losers free theirs.
+void* segConcurrentChunk(segvec* psv, uint64_t chunk)
+{
+   void** ppSlot = (void**)cvAt(psv->mDirectory, chunk);
+   void* pChunk = __atomic_load_n(ppSlot, __ATOMIC_ACQUIRE);
+   if (pChunk) return pChunk;
+
+   // Items followed by their ready flags.
+   void* pNew = calloc(1, ((size_t)psv->mItemSize + 1) << psv->mChunkShift);
+   if (!pNew) return nul;
+   if (__atomic_compare_exchange_n(ppSlot, &pChunk, pNew, false,
+      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      return pNew;
+   }
+
+   free(pNew);
+   return pChunk;
+}
+
+// Adds chunks until itemCount items can be held. Chunks are blank.
+retcode segExtend(segvec* psv, uint64_t itemCount)
+{
+   if (psv->mFlags & svfconcurrent) {
+      if (itemCount > psv->mMaxItems) return fail;
+      uint64_t chunks = (itemCount + psv->mChunkMask) >> psv->mChunkShift;
+      for (uint64_t c = 0; c < chunks; ++c) {
+         if (!segConcurrentChunk(psv, c)) return fail;
+      }
+      return success;
+   }
+
+   uint64_t chunks = (itemCount + psv->mChunkMask) >> psv->mChunkShift;
+   if (chunks <= cvCount(psv->mDirectory)) return success;
+
+   // Grow the directory once.
+   if (fail == cvReserve(psv->mDirectory, chunks)) return fail;
+
+   // Add the chunks.
+   size_t chunkSize = (size_t)psv->mItemSize << psv->mChunkShift;
+   while (cvCount(psv->mDirectory) < chunks) {
+      void* pChunk = calloc(1, chunkSize);
+      if (!pChunk) return fail;
+      cvPushBack(psv->mDirectory, makecvitem(pChunk));
+   }
+
+   // Done.
+   return success;
+}
+
+//
+// Item management.
+//
+
+// Returns the number of valid items in the vector.
+uint64_t svGetCount(csegvector csv)
+{
+   const segvec* psv = (const segvec*)csv;
+   return (psv ? segCount(psv) : 0);
+}
+
+// Returns the total number of items the allocated chunks can hold.
+uint64_t svGetSize(csegvector csv)
+{
+   const segvec* psv = (const segvec*)csv;
+   if (!psv) return 0;
+
+   // Concurrent vectors have null entries for chunks not added yet.
+   uint64_t chunks = cvCount(psv->mDirectory);
+   if (psv->mFlags & svfconcurrent) {
+      uint64_t allocated = 0;
+      for (uint64_t c = 0; c < chunks; ++c) {
+         if (__atomic_load_n((void**)cvAt(psv->mDirectory, c),
+            __ATOMIC_ACQUIRE)) {
+            allocated++;
+         }
+      }
+      chunks = allocated;
+   }
+   return chunks << psv->mChunkShift;
+}
+
+// Returns the number of items held in every chunk.
+uint32_t svGetChunkItems(csegvector csv)
+{
+   const segvec* psv = (const segvec*)csv;
+   return (psv ? (uint32_t)(psv->mChunkMask + 1) : 0);
+}
+
+// Reserve itemCount items in the vector, allocating whole chunks.
+retcode svReserve(segvector sv, uint64_t itemCount)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv) return fail;
+
+   return segExtend(psv, itemCount);
+}
+
+// Creates a blank item at end and returns its location. Will return null if it
+// fails! The location stays valid until the item is popped.
+void* svEmplaceBack(segvector sv)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv) return null;
+
+   // Publish a blank item.
+   if (psv->mFlags & svfconcurrent) {
+      uint64_t index = 0;
+      void* dest = svAppendReserve(sv, &index);
+      if (!dest || fail == svAppendCommit(sv, index)) return null;
+      return dest;
+   }
+
+   // Allocate a chunk if need be.
+   if (fail == segExtend(psv, psv->mItemCount + 1))
+      return null;
+
+   return segItem(psv, psv->mItemCount++);
+}
+
+// Adds an item after the last item added. Returns a pointer to the item which
+// stays valid until the item is popped.
+void* svPushBack(segvector sv, const void* item)
+{
+   if (!item) return null;
+   if (sv && (((segvec*)sv)->mFlags & svfconcurrent)) return svAppend(sv, item);
+
+   void* dest = svEmplaceBack(sv);
+   if (!dest) return null;
+
+   memcpy(dest, item, ((segvec*)sv)->mItemSize);
+   return dest;
+}
+
+// Removes (blanks) last item.
+void svPopBack(segvector sv)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv || psv->mItemCount == 0) return;
+
+   psv->mItemCount--;
+   psv->mReserved = psv->mItemCount;
+   void* pItem = segItem(psv, psv->mItemCount);
+   memset(pItem, 0, psv->mItemSize);
+   if (psv->mFlags & svfconcurrent) {
+      void* pChunk = *(void**)cvAt(psv->mDirectory,
+         psv->mItemCount >> psv->mChunkShift);
+      *segReadyFlag(psv, pChunk, psv->mItemCount) = 0;
+   }
+}
+
+// Removes all items from the vector. Items will be blanked out; chunks are
+// kept for reuse until svShrink() is called.
+void svClear(segvector sv)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv) return;
+
+   // Blank each used chunk.
+   uint64_t chunks = (psv->mItemCount + psv->mChunkMask) >> psv->mChunkShift;
+   for (uint64_t c = 0; c < chunks; ++c) {
+      uint32_t count = 0;
+      void* pChunk = svGetChunk(sv, c, &count);
+      memset(pChunk, 0, (size_t)count * psv->mItemSize);
+      if (psv->mFlags & svfconcurrent) {
+         memset(segReadyFlag(psv, pChunk, 0), 0, count);
+      }
+   }
+   psv->mItemCount = 0;
+   psv->mReserved = 0;
+}
+
+// Frees chunks that hold no items.
+void svShrink(segvector sv)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv) return;
+
+   uint64_t chunks = (psv->mItemCount + psv->mChunkMask) >> psv->mChunkShift;
+
+   // The directory of concurrent vectors stays the same size.
+   if (psv->mFlags & svfconcurrent) {
+      for (uint64_t c = chunks; c < cvCount(psv->mDirectory); ++c) {
+         void** ppSlot = (void**)cvAt(psv->mDirectory, c);
+         free(*ppSlot);
+         *ppSlot = nul;
+      }
+      return;
+   }
+
+   while (cvCount(psv->mDirectory) > chunks) {
+      uint64_t last = cvCount(psv->mDirectory) - 1;
+      free(*(void**)cvAt(psv->mDirectory, last));
+      cvPopBack(psv->mDirectory);
+   }
+   cvShrink(psv->mDirectory);
+}
+
+// Get item at index. If no item exists, nul is returned.
+void* svGetAt(segvector sv, uint64_t index)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv) return nul;
+   if (index >= segCount(psv)) return nul;
+
+   return segItem(psv, index);
+}
+
+// Sets the item at index and returns it back.
+void* svSetAt(segvector sv, uint64_t index, const void* item)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv || !item) return nul;
+   if (index >= segCount(psv)) return nul;
+
+   void* dest = segItem(psv, index);
+   memcpy(dest, item, psv->mItemSize);
+   return dest;
+}
+
+// Returns chunk number chunk and the number of valid items in it (pCount).
+// Returns null if the chunk holds no items.
+void* svGetChunk(segvector sv, uint64_t chunk, uint32_t* pCount)
+{
+   segvec* psv = (segvec*)sv;
+   if (pCount) *pCount = 0;
+   if (!psv) return nul;
+
+   uint64_t itemCount = segCount(psv);
+   uint64_t first = chunk << psv->mChunkShift;
+   if (first >= itemCount) return nul;
+
+   if (pCount) {
+      uint64_t count = itemCount - first;
+      if (count > psv->mChunkMask + 1) count = psv->mChunkMask + 1;
+      *pCount = (uint32_t)count;
+   }
+   return *(void**)cvAt(psv->mDirectory, chunk);
+}
+
+//
+// Concurrent append.
+//
+
+// Claims the next index and returns the item to write (blank) or null if the
+// vector is full. The item must be published through svAppendCommit().
+void* svAppendReserve(segvector sv, uint64_t* pIndex)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv || !pIndex || !(psv->mFlags & svfconcurrent)) return null;
+
+   uint64_t index = __atomic_fetch_add(&psv->mReserved, 1, __ATOMIC_RELAXED);
+   if (index >= psv->mMaxItems) return null;
+
+   // Without its chunk the index can never be published, and neither can any
+   // after it; keep the lowest such index and refuse appends beyond it.
+   void* pChunk = segConcurrentChunk(psv, index >> psv->mChunkShift);
+   if (!pChunk) {
+      uint64_t lost = __atomic_load_n(&psv->mLostFrom, __ATOMIC_SEQ_CST);
+      while (index < lost) {
+         // On failure lost is reloaded.
+         if (__atomic_compare_exchange_n(&psv->mLostFrom, &lost, index, false,
+            __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            break;
+         }
+      }
+      return null;
+   }
+   if (index >= __atomic_load_n(&psv->mLostFrom, __ATOMIC_SEQ_CST))
+      return null;
+
+   *pIndex = index;
+   return pChunk + ((size_t)(index & psv->mChunkMask) * psv->mItemSize);
+}
+
+// Marks the item at index ready and publishes every ready item that follows
+// the published ones. Committing never waits: an item reserved but not yet
+// committed holds back the items after it, and whichever thread commits it
+// publishes them. Flag stores and count loads are sequentially consistent so
+// one of two racing committers always sees the other's item. Returns fail if
+// the item can never be published because a chunk before it failed to
+// allocate.
+retcode svAppendCommit(segvector sv, uint64_t index)
+{
+   segvec* psv = (segvec*)sv;
+   if (!psv || !(psv->mFlags & svfconcurrent)) return fail;
+   if (index >= psv->mMaxItems) return fail;
+
+   void* pChunk = __atomic_load_n((void**)cvAt(psv->mDirectory,
+      index >> psv->mChunkShift), __ATOMIC_ACQUIRE);
+   __atomic_store_n(segReadyFlag(psv, pChunk, index), 1, __ATOMIC_SEQ_CST);
+
+   // Move the published count past ready items.
+   uint64_t count = __atomic_load_n(&psv->mItemCount, __ATOMIC_SEQ_CST);
+   while (count < psv->mMaxItems) {
+      pChunk = __atomic_load_n((void**)cvAt(psv->mDirectory,
+         count >> psv->mChunkShift), __ATOMIC_ACQUIRE);
+      if (!pChunk) break;
+      if (!__atomic_load_n(segReadyFlag(psv, pChunk, count), __ATOMIC_SEQ_CST))
+         break;
+
+      // On failure count is reloaded.
+      if (__atomic_compare_exchange_n(&psv->mItemCount, &count, count + 1,
+         false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+         count++;
+      }
+   }
+
+   // Lost behind a failed chunk?
+   if (index >= __atomic_load_n(&psv->mLostFrom, __ATOMIC_SEQ_CST))
+      return fail;
+   return success;
+}
+
+// Appends a copy of item and publishes it. Returns the item or null if the
+// vector is full or the item was lost.
+void* svAppend(segvector sv, const void* item)
+{
+   if (!item) return null;
+
+   uint64_t index = 0;
+   void* dest = svAppendReserve(sv, &index);
+   if (!dest) return null;
+
+   memcpy(dest, item, ((segvec*)sv)->mItemSize);
+   if (fail == svAppendCommit(sv, index)) return null;
+   return dest;
+}
@@ -29,14 +29,51 @@ Version control
 30 Mar 2023 Duncan Camilleri           Initial development
 31 Mar 2023 Duncan Camilleri           Added cvEmplaceBack tests
 31 Mar 2023 Duncan Camilleri           testBufferGrowth() cleaned up
+17 Oct 2026 Duncan Camilleri           Growth policy tests
+17 Oct 2026 Duncan Camilleri           Bulk append and range insert tests
+17 Oct 2026 Duncan Camilleri           Inline accessor and span tests
+17 Oct 2026 Duncan Camilleri           Typed vector (vectort.h) tests
+17 Oct 2026 Duncan Camilleri           No-scrub and cvEmplaceBackN tests
+17 Oct 2026 Duncan Camilleri           Large vector tests
+17 Oct 2026 Duncan Camilleri           Segmented vector tests
+17 Oct 2026 Duncan Camilleri           Small buffer vector tests
+17 Oct 2026 Duncan Camilleri           Sorting and searching tests
+17 Oct 2026 Duncan Camilleri           Parallel algorithm tests
+17 Oct 2026 Duncan Camilleri           Concurrent append tests
+17 Oct 2026 Duncan Camilleri           Insert, erase and remove tests
 */
 
 #include <stdio.h>
 #include <inttypes.h>
 #include <memory.h>
+#include <pthread.h>
 #include <commons.h>
 #include <testfaze.h>
 #include <vector.h>
+#include <vectort.h>
+#include <segvector.h>
+#include <vectoralgo.h>
+#include <vectorpar.h>
+
+//
+// TYPES
+//
+
+// A struct item for typed vectors.
+typedef struct _point {
+   double mX;
+   double mY;
+} point;
+
+CV_DECLARE(i32vec, int32_t)
+CV_DECLARE(dblvec, double)
+CV_DECLARE(ptvec, point)
+
+// A concurrent append producer.
+typedef struct _producer {
+   segvector mVector;
+   uint64_t mThread;
+} producer;
 
 //
 // MACROS
@@ -45,6 +82,10 @@ Version control
 // Borrowed alloc units from vector.c.
 #define VECTOR_DEFAULT_ALLOCUNITS            8
 
+// Concurrent append threads and items per thread.
+#define TEST_PRODUCERS                       4
+#define TEST_PRODUCER_ITEMS                  10000
+
 //
 // TEST CASES
 //
@@ -128,6 +169,9 @@ bool testShrink(TFSuite pTest)
       return false;
    }
 
+   // Shrinking rounds to whole allocation units with a fixed growth policy.
+   cvSetGrowthPolicy(cv, cvgrowfixed, VECTOR_DEFAULT_ALLOCUNITS);
+
    // Add items to the vector - ensure there is space.
    for (int n = 0; n < 20; ++n) {
       cvPushBack(cv, makecvitem(n));
@@ -185,6 +229,883 @@ bool testShrink(TFSuite pTest)
    return true;
 }
 
+// Tests each growth policy grows the vector as expected.
+bool testGrowthPolicy(TFSuite pTest)
+{
+   // Create the vector.
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+
+   // Invalid growth factors are refused.
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowgeometric, 100), fail, false);
+   tfzassert(pTest, cvSetGrowthPolicy(cv, (cvgrowth)99, 0), fail, false);
+
+   // Default policy is geometric and doubles capacity on overflow; 1000 items
+   // need at most a handful of allocations.
+   for (uint32_t n = 0; n < 1000; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert_ui32(pTest, cvGetCount(cv), 1000, false);
+   tfzassert_ui32(pTest, cvGetSize(cv), 1024, false);
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 8, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 999), 999, false);
+
+   // Reservations are exact for a geometric vector.
+   cvReserve(cv, 1500);
+   tfzassert_ui32(pTest, cvGetSize(cv), 1500, false);
+
+   // Shrinking a geometric vector fits it to its items.
+   cvShrink(cv);
+   tfzassert_ui32(pTest, cvGetSize(cv), 1000, false);
+   cvdestroy(&cv);
+
+   // A 1.5x factor.
+   cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowgeometric, 150), success,
+      false);
+   for (uint32_t n = 0; n < 13; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert_ui32(pTest, cvGetSize(cv), 18, false);
+   cvdestroy(&cv);
+
+   // Page rounded vectors always hold whole pages.
+   cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowpage, 4096), success, false);
+   uint32_t first = 0;
+   cvPushBack(cv, makecvitem(first));
+   tfzassert_ui32(pTest, cvGetSize(cv), 1024, false);
+   for (uint32_t n = 1; n <= 1024; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert_ui32(pTest, cvGetSize(cv), 2048, false);
+   cvdestroy(&cv);
+
+   // Fixed chunks.
+   cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowfixed, 100), success, false);
+   for (uint32_t n = 0; n < 250; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert_ui32(pTest, cvGetSize(cv), 300, false);
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 3, false);
+
+   // Success.
+   cvdestroy(&cv);
+   return true;
+}
+
+// Tests bulk appends and range inserts.
+bool testBulk(TFSuite pTest)
+{
+   uint32_t items[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+   // Create the vector.
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+
+   // Invalid parameters.
+   tfzassert_ptr(pTest, cvPushBackN(cv, null, 3), null, false);
+   tfzassert_ptr(pTest, cvPushBackN(cv, items, 0), null, false);
+   tfzassert_ptr(pTest, cvInsertRange(cv, 1, items, 3), null, false);
+
+   // Push back 10 items in one go; a single allocation is expected.
+   uint32_t* pFirst = (uint32_t*)cvPushBackN(cv, items, 10);
+   tfzassert(pTest, pFirst != null, true, false);
+   tfzassert_ui32(pTest, cvGetCount(cv), 10, false);
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 1, false);
+   tfzassert_buf(pTest, cvGetAt(cv, 0), 40, items, 40, false);
+
+   // Insert 3 items in the middle: 0 1 [7 8 9] 2 3 ...
+   uint32_t* pIns = (uint32_t*)cvInsertRange(cv, 2, &items[7], 3);
+   tfzassert(pTest, pIns != null, true, false);
+   tfzassert_ui32(pTest, cvGetCount(cv), 13, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 1), 1, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 2), 7, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 4), 9, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 5), 2, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 12), 9, false);
+
+   // Insert at the very end appends.
+   cvInsertRange(cv, 13, items, 1);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 13), 0, false);
+
+   // Append a vector to another and to itself.
+   cvector other = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, other != null, true, false)) {
+      cvdestroy(&cv);
+      return false;
+   }
+   tfzassert(pTest, cvAppendVector(other, cv), success, false);
+   tfzassert_ui32(pTest, cvGetCount(other), 14, false);
+   tfzassert(pTest, cvAppendVector(other, other), success, false);
+   tfzassert_ui32(pTest, cvGetCount(other), 28, false);
+   tfzassert_buf(pTest, cvGetAt(other, 14), 14 * sizeof(uint32_t),
+      cvGetAt(cv, 0), 14 * sizeof(uint32_t), false);
+
+   // Mismatching item sizes are refused.
+   cvector bytes = cvcreate(sizeof(uint8_t));
+   tfzassert(pTest, cvAppendVector(bytes, cv), fail, false);
+
+   // Success.
+   cvdestroy(&bytes);
+   cvdestroy(&other);
+   cvdestroy(&cv);
+   return true;
+}
+
+// Tests the inline accessors, spans and iteration macros.
+bool testSpan(TFSuite pTest)
+{
+   // Create the vector.
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+
+   // Empty vectors give empty spans.
+   cvspan span = cvSpan(cv);
+   tfzassert_ui32(pTest, cvSpanCount(span), 0, false);
+   uint32_t visits = 0;
+   cvforeach(uint32_t, p, span) {
+      visits++;
+   }
+   tfzassert_ui32(pTest, visits, 0, false);
+
+   // Fill up.
+   for (uint32_t n = 0; n < 100; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+
+   // Inline accessors agree with the checked api.
+   tfzassert_ui32(pTest, cvCount(cv), cvGetCount(cv), false);
+   tfzassert_ui32(pTest, cvStride(cv), sizeof(uint32_t), false);
+   tfzassert_ptr(pTest, cvData(cv), cvGetAt(cv, 0), false);
+   tfzassert_ptr(pTest, cvAt(cv, 42), cvGetAt(cv, 42), false);
+
+   // Typed and raw iteration.
+   span = cvSpan(cv);
+   tfzassert_ui32(pTest, cvSpanCount(span), 100, false);
+   uint32_t sum = 0;
+   cvforeach(uint32_t, p, span) {
+      sum += *p;
+   }
+   tfzassert_ui32(pTest, sum, 4950, false);
+
+   sum = 0;
+   cvforeachraw(p, span) {
+      sum += *(uint32_t*)p;
+   }
+   tfzassert_ui32(pTest, sum, 4950, false);
+
+   // Success.
+   cvdestroy(&cv);
+   return true;
+}
+
+// Tests the typed vectors generated by CV_DECLARE.
+bool testTyped(TFSuite pTest)
+{
+   // Integers.
+   cvector iv = i32vec_create();
+   if (false == tfzassert(pTest, iv != null, true, false)) {
+      return false;
+   }
+   for (int32_t n = 0; n < 1000; ++n) {
+      i32vec_push(iv, n - 500);
+   }
+   tfzassert_ui32(pTest, i32vec_count(iv), 1000, false);
+   tfzassert(pTest, i32vec_get(iv, 0) == -500, true, false);
+   tfzassert(pTest, *i32vec_at(iv, 999) == 499, true, false);
+   tfzassert_ptr(pTest, i32vec_at(iv, 10), cvGetAt(iv, 10), false);
+   i32vec_set(iv, 1, 77);
+   tfzassert(pTest, *(int32_t*)cvGetAt(iv, 1) == 77, true, false);
+   tfzassert(pTest, i32vec_pop(iv) == 499, true, false);
+   tfzassert_ui32(pTest, cvGetCount(iv), 999, false);
+
+   int64_t sum = 0;
+   int32_t* pData = i32vec_data(iv);
+   for (uint32_t n = 0; n < i32vec_count(iv); ++n) {
+      sum += pData[n];
+   }
+   // -500..499 sums to -500; item 1 went from -499 to 77 and 499 was popped.
+   tfzassert(pTest, sum == -500 + 499 + 77 - 499, true, false);
+   i32vec_destroy(&iv);
+   tfzassert_ptr(pTest, iv, null, false);
+
+   // Doubles.
+   cvector dv = dblvec_create();
+   if (false == tfzassert(pTest, dv != null, true, false)) {
+      return false;
+   }
+   dblvec_reserve(dv, 64);
+   tfzassert_ui32(pTest, cvGetSize(dv), 64, false);
+   for (uint32_t n = 0; n < 64; ++n) {
+      dblvec_push(dv, n * 0.5);
+   }
+   tfzassert_ui32(pTest, cvGetAllocCount(dv), 1, false);
+   tfzassert(pTest, dblvec_get(dv, 63) == 31.5, true, false);
+   dblvec_destroy(&dv);
+
+   // Structures.
+   cvector pv = ptvec_create();
+   if (false == tfzassert(pTest, pv != null, true, false)) {
+      return false;
+   }
+   point pt = { 1.0, 2.0 };
+   ptvec_push(pv, pt);
+   pt.mX = 3.0;
+   ptvec_push(pv, pt);
+   tfzassert_ui32(pTest, cvStride(pv), sizeof(point), false);
+   tfzassert(pTest, ptvec_get(pv, 1).mX == 3.0, true, false);
+   tfzassert(pTest, ptvec_at(pv, 0)->mY == 2.0, true, false);
+   ptvec_destroy(&pv);
+
+   // Success.
+   return true;
+}
+
+// Tests vectors created with cvfnoscrub and cvEmplaceBackN.
+bool testNoScrub(TFSuite pTest)
+{
+   // A default vector blanks popped items.
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   uint32_t item = 0xABCD;
+   uint32_t* pItem = (uint32_t*)cvPushBack(cv, makecvitem(item));
+   cvPopBack(cv);
+   tfzassert_ui32(pTest, *pItem, 0, false);
+   cvdestroy(&cv);
+
+   // A no-scrub vector only adjusts counts.
+   cv = cvcreatex(sizeof(uint32_t), cvfnoscrub);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   pItem = (uint32_t*)cvPushBack(cv, makecvitem(item));
+   cvPopBack(cv);
+   tfzassert_ui32(pTest, cvGetCount(cv), 0, false);
+   tfzassert_ui32(pTest, *pItem, 0xABCD, false);
+
+   // Emplace a batch of items and fill them.
+   tfzassert_ptr(pTest, cvEmplaceBackN(cv, 0), null, false);
+   uint32_t* pItems = (uint32_t*)cvEmplaceBackN(cv, 100);
+   if (false == tfzassert(pTest, pItems != null, true, false)) {
+      cvdestroy(&cv);
+      return false;
+   }
+   for (uint32_t n = 0; n < 100; ++n) {
+      pItems[n] = n;
+   }
+   tfzassert_ui32(pTest, cvGetCount(cv), 100, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 99), 99, false);
+
+   // Clearing keeps the data in place.
+   cvClear(cv);
+   tfzassert_ui32(pTest, cvGetCount(cv), 0, false);
+   tfzassert_ui32(pTest, pItems[50], 50, false);
+
+   // Success.
+   cvdestroy(&cv);
+   return true;
+}
+
+// Tests mmap backed large vectors.
+bool testLarge(TFSuite pTest)
+{
+   // Create the vector.
+   cvector cv = cvcreatex(sizeof(uint64_t), cvflarge | cvfhugepage);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+
+   // Large vectors grow in whole pages and data is kept through remaps.
+   for (uint64_t n = 0; n < 1000000; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert(pTest, cvGetCount(cv) == 1000000, true, false);
+   tfzassert(pTest, (cvGetSize(cv) * sizeof(uint64_t)) % 4096 == 0, true,
+      false);
+   tfzassert(pTest, *(uint64_t*)cvGetAt(cv, 0) == 0, true, false);
+   tfzassert(pTest, *(uint64_t*)cvGetAt(cv, 999999) == 999999, true, false);
+
+   // Shrinking gives pages back; growing back starts off blank.
+   uint64_t total = cvGetSize(cv);
+   for (uint32_t n = 0; n < 999000; ++n) {
+      cvPopBack(cv);
+   }
+   cvShrink(cv);
+   tfzassert(pTest, cvGetSize(cv) < total, true, false);
+   tfzassert(pTest, *(uint64_t*)cvGetAt(cv, 999) == 999, true, false);
+   uint64_t* pItems = (uint64_t*)cvEmplaceBackN(cv, 500000);
+   tfzassert(pTest, pItems != null, true, false);
+   tfzassert(pTest, pItems[499999] == 0, true, false);
+
+   // Empty vectors release everything.
+   cvClear(cv);
+   cvShrink(cv);
+   tfzassert(pTest, cvGetSize(cv) == 0, true, false);
+   cvdestroy(&cv);
+
+   // Huge pages alone make a large vector (the first push maps a page).
+   cv = cvcreatex(sizeof(uint64_t), cvfhugepage);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   uint64_t item = 7;
+   cvPushBack(cv, makecvitem(item));
+   tfzassert(pTest, (cvGetSize(cv) * sizeof(uint64_t)) % 4096 == 0, true,
+      false);
+   tfzassert(pTest, cvGetSize(cv) > 8, true, false);
+   tfzassert(pTest, *(uint64_t*)cvGetAt(cv, 0) == 7, true, false);
+
+   // Page rounding on a large vector must keep whole system pages.
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowpage, 100) == fail, true,
+      false);
+   tfzassert(pTest, cvSetGrowthPolicy(cv, cvgrowpage, 8192) == success, true,
+      false);
+   cvdestroy(&cv);
+
+   // Counts beyond 32 bits. Address space is reserved without being touched
+   // so this only runs where the system allows such a mapping.
+   cv = cvcreatex(sizeof(uint8_t), cvflarge | cvfnoscrub);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   const uint64_t huge = 5ULL * 1024 * 1024 * 1024;
+   if (success == cvReserve(cv, huge)) {
+      tfzassert(pTest, cvEmplaceBackN(cv, huge) != null, true, false);
+      tfzassert(pTest, cvGetCount(cv) == huge, true, false);
+      uint8_t last = 0x5A;
+      cvSetAt(cv, huge - 1, makecvitem(last));
+      tfzassert_ui8(pTest, *(uint8_t*)cvGetAt(cv, huge - 1), 0x5A, false);
+      tfzassert_ptr(pTest, cvGetAt(cv, huge), null, false);
+   }
+
+   // Success.
+   cvdestroy(&cv);
+   return true;
+}
+
+// Tests segmented vectors keep items in place as they grow.
+bool testSegmented(TFSuite pTest)
+{
+   // Invalid parameters.
+   tfzassert_ptr(pTest, svcreate(0, 0), null, false);
+
+   // Chunk sizes are rounded up to a power of two.
+   segvector sv = svcreate(sizeof(uint32_t), 100);
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+   tfzassert_ui32(pTest, svGetChunkItems(sv), 128, false);
+
+   // Pointers handed out must remain valid while the vector grows.
+   uint32_t first = 0;
+   uint32_t* pFirst = (uint32_t*)svPushBack(sv, &first);
+   uint32_t* pMiddle = 0;
+   for (uint32_t n = 1; n < 10000; ++n) {
+      uint32_t* pItem = (uint32_t*)svPushBack(sv, &n);
+      if (n == 5000) pMiddle = pItem;
+   }
+   tfzassert(pTest, svGetCount(sv) == 10000, true, false);
+   tfzassert(pTest, svGetSize(sv) == 10112, true, false);
+   tfzassert_ptr(pTest, svGetAt(sv, 0), pFirst, false);
+   tfzassert_ptr(pTest, svGetAt(sv, 5000), pMiddle, false);
+   tfzassert_ui32(pTest, *pMiddle, 5000, false);
+   tfzassert_ptr(pTest, svGetAt(sv, 10000), null, false);
+
+   // Set and chunk access.
+   uint32_t value = 77;
+   svSetAt(sv, 129, &value);
+   uint32_t count = 0;
+   uint32_t* pChunk = (uint32_t*)svGetChunk(sv, 1, &count);
+   tfzassert_ui32(pTest, count, 128, false);
+   tfzassert_ui32(pTest, pChunk[1], 77, false);
+   pChunk = (uint32_t*)svGetChunk(sv, 78, &count);
+   tfzassert_ui32(pTest, count, 10000 - (78 * 128), false);
+   tfzassert_ptr(pTest, svGetChunk(sv, 79, &count), null, false);
+
+   // Pop, shrink and clear.
+   for (uint32_t n = 0; n < 9000; ++n) {
+      svPopBack(sv);
+   }
+   svShrink(sv);
+   tfzassert(pTest, svGetSize(sv) == 1024, true, false);
+   tfzassert_ptr(pTest, svGetAt(sv, 0), pFirst, false);
+   svClear(sv);
+   tfzassert(pTest, svGetCount(sv) == 0, true, false);
+   tfzassert_ui32(pTest, *pFirst, 0, false);
+
+   // Reservations allocate whole chunks.
+   tfzassert(pTest, svReserve(sv, 129), success, false);
+   tfzassert(pTest, svGetSize(sv) == 1024, true, false);
+
+   // Success.
+   svdestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+// Tests small buffer vectors.
+bool testSmallBuffer(TFSuite pTest)
+{
+   // Large vectors cannot be small.
+   tfzassert_ptr(pTest, cvcreatesbo(sizeof(uint32_t), 8, cvflarge), null,
+      false);
+
+   // Create the vector.
+   cvResetAllocsAvoided();
+   cvector cv = cvcreatesbo(sizeof(uint32_t), 8, cvfnone);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+
+   // Items up to the inline count need no allocations.
+   tfzassert(pTest, cvGetSize(cv) == 8, true, false);
+   for (uint32_t n = 0; n < 8; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 0, false);
+   tfzassert(pTest, cvGetAllocsAvoided() == 1, true, false);
+
+   // Spilling to the heap keeps the items.
+   uint32_t item = 8;
+   cvPushBack(cv, makecvitem(item));
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 1, false);
+   tfzassert(pTest, cvGetSize(cv) == 16, true, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 7), 7, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 8), 8, false);
+
+   // Shrinking moves the items back inline when they fit.
+   cvPopBack(cv);
+   cvPopBack(cv);
+   cvShrink(cv);
+   tfzassert(pTest, cvGetSize(cv) == 8, true, false);
+   tfzassert(pTest, cvGetCount(cv) == 7, true, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvGetAt(cv, 6), 6, false);
+   cvClear(cv);
+   cvShrink(cv);
+   tfzassert(pTest, cvGetSize(cv) == 8, true, false);
+   cvdestroy(&cv);
+
+   // With a 1.5x factor, 32 inline items avoid the allocations for 8, 12,
+   // 18 and 27 items.
+   cvResetAllocsAvoided();
+   cv = cvcreatesbo(sizeof(uint32_t), 32, cvfnone);
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   cvSetGrowthPolicy(cv, cvgrowgeometric, 150);
+   for (uint32_t n = 0; n < 32; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+   tfzassert(pTest, cvGetAllocsAvoided() == 4, true, false);
+   tfzassert_ui32(pTest, cvGetAllocCount(cv), 0, false);
+
+   // Success.
+   cvdestroy(&cv);
+   return true;
+}
+
+// Compares two int32_t items.
+int8_t cmpInt32(void* a, void* b)
+{
+   int32_t x = *(int32_t*)a;
+   int32_t y = *(int32_t*)b;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// Compares points by x only (y records the insertion order).
+int8_t cmpPointX(void* a, void* b)
+{
+   double x = ((point*)a)->mX;
+   double y = ((point*)b)->mX;
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// Tests sorting and searching.
+bool testAlgo(TFSuite pTest)
+{
+   // Pseudo random items (with duplicates) sorted by introsort.
+   cvector cv = i32vec_create();
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   uint32_t seed = 12345;
+   for (uint32_t n = 0; n < 5000; ++n) {
+      seed = (seed * 1103515245) + 12345;
+      i32vec_push(cv, (int32_t)(seed >> 8) % 1000 - 500);
+   }
+   tfzassert(pTest, cvSort(cv, cmpInt32), success, false);
+   bool sorted = true;
+   for (uint64_t n = 1; n < i32vec_count(cv); ++n) {
+      if (i32vec_get(cv, n - 1) > i32vec_get(cv, n)) sorted = false;
+   }
+   tfzassert(pTest, sorted, true, false);
+
+   // Searching the sorted items.
+   int32_t key = i32vec_get(cv, 2500);
+   uint64_t index = cvLowerBound(cv, &key, cmpInt32);
+   tfzassert(pTest, i32vec_get(cv, index) == key, true, false);
+   tfzassert(pTest, index == 0 || i32vec_get(cv, index - 1) < key, true, false);
+   tfzassert(pTest, i32vec_get(cv, cvBinarySearch(cv, &key, cmpInt32)) == key,
+      true, false);
+   key = 1000;
+   tfzassert(pTest, cvLowerBound(cv, &key, cmpInt32) == 5000, true, false);
+   tfzassert(pTest, cvBinarySearch(cv, &key, cmpInt32) == CV_NPOS, true, false);
+   tfzassert(pTest, cvBinarySearch(cv, null, cmpInt32) == CV_NPOS, true,
+      false);
+   tfzassert(pTest, cvBinarySearch(cv, &key, null) == CV_NPOS, true, false);
+
+   // Linear find (4 bytes) past the vectorized blocks.
+   key = i32vec_get(cv, 4999);
+   tfzassert(pTest, cvFind(cv, &key) == cvLowerBound(cv, &key, cmpInt32),
+      true, false);
+   key = 1000;
+   tfzassert(pTest, cvFind(cv, &key) == CV_NPOS, true, false);
+   i32vec_set(cv, 4998, 1000);
+   tfzassert(pTest, cvFind(cv, &key) == 4998, true, false);
+   i32vec_destroy(&cv);
+
+   // Signed and unsigned radix sorts on 4 and 8 byte items.
+   int32_t signedItems[] = { 5, -1, 0x7FFFFFFF, -0x7FFFFFFF - 1, 0, -300, 7 };
+   int32_t signedSorted[] = { -0x7FFFFFFF - 1, -300, -1, 0, 5, 7, 0x7FFFFFFF };
+   cv = cvcreate(sizeof(int32_t));
+   cvPushBackN(cv, signedItems, 7);
+   tfzassert(pTest, cvRadixSort(cv, true), success, false);
+   tfzassert_buf(pTest, cvData(cv), sizeof(signedSorted),
+      signedSorted, sizeof(signedSorted), false);
+   cvdestroy(&cv);
+
+   uint64_t wideItems[] = { 1ull << 40, 3, 0xFFFFFFFFFFFFFFFFull, 3, 0 };
+   uint64_t wideSorted[] = { 0, 3, 3, 1ull << 40, 0xFFFFFFFFFFFFFFFFull };
+   cv = cvcreate(sizeof(uint64_t));
+   cvPushBackN(cv, wideItems, 5);
+   tfzassert(pTest, cvRadixSort(cv, false), success, false);
+   tfzassert_buf(pTest, cvData(cv), sizeof(wideSorted),
+      wideSorted, sizeof(wideSorted), false);
+
+   // Linear find (8 bytes).
+   uint64_t wide = 1ull << 40;
+   tfzassert(pTest, cvFind(cv, &wide) == 3, true, false);
+   wide = 2;
+   tfzassert(pTest, cvFind(cv, &wide) == CV_NPOS, true, false);
+   cvdestroy(&cv);
+
+   // Radix sorts need integer sized items.
+   cv = cvcreate(3);
+   tfzassert(pTest, cvRadixSort(cv, false), fail, false);
+   cvdestroy(&cv);
+
+   // Stable sort keeps equal items in insertion order.
+   cv = ptvec_create();
+   for (int32_t n = 0; n < 200; ++n) {
+      point pt = { (n * 7) % 5, n };
+      ptvec_push(cv, pt);
+   }
+   tfzassert(pTest, cvStableSort(cv, cmpPointX), success, false);
+   bool stable = true;
+   for (uint64_t n = 1; n < ptvec_count(cv); ++n) {
+      point a = ptvec_get(cv, n - 1);
+      point b = ptvec_get(cv, n);
+      if (a.mX > b.mX || (a.mX == b.mX && a.mY > b.mY)) stable = false;
+   }
+   tfzassert(pTest, stable, true, false);
+
+   // Find over items of other sizes.
+   point pt = ptvec_get(cv, 150);
+   tfzassert(pTest, cvFind(cv, &pt) == 150, true, false);
+
+   // Success.
+   ptvec_destroy(&cv);
+   return tfzassert_ptr(pTest, cv, null, false);
+}
+
+// Doubles an int32_t item in place.
+void parDouble(void* pItem, uint64_t index, void* pCtx)
+{
+   *(int32_t*)pItem *= 2;
+}
+
+// Converts an int32_t item to a double plus the offset in pCtx.
+void parToDouble(void* pDst, const void* pSrc, void* pCtx)
+{
+   *(double*)pDst = (double)*(const int32_t*)pSrc + *(double*)pCtx;
+}
+
+// Adds an int32_t item to an int64_t sum.
+void parSumItem(void* pAcc, const void* pItem, void* pCtx)
+{
+   *(int64_t*)pAcc += *(const int32_t*)pItem;
+}
+
+// Adds an int64_t chunk sum to an int64_t sum.
+void parSumChunk(void* pAcc, const void* pItem, void* pCtx)
+{
+   *(int64_t*)pAcc += *(const int64_t*)pItem;
+}
+
+// Tests the parallel algorithms. Small chunks force many chunks per thread.
+bool testParallel(TFSuite pTest)
+{
+   tfzassert(pTest, cvParSetThreads(4), success, false);
+   tfzassert_ui32(pTest, cvParGetThreads(), 4, false);
+   cvParSetChunkSize(1024);
+
+   // Items 0..n-1.
+   const uint32_t count = 100000;
+   cvector cv = i32vec_create();
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   for (uint32_t n = 0; n < count; ++n) {
+      i32vec_push(cv, (int32_t)n);
+   }
+
+   // Every item is visited once.
+   tfzassert(pTest, cvParallelForEach(cv, parDouble, null), success, false);
+   bool doubled = true;
+   for (uint32_t n = 0; n < count; ++n) {
+      if (i32vec_get(cv, n) != (int32_t)n * 2) doubled = false;
+   }
+   tfzassert(pTest, doubled, true, false);
+
+   // Transform into a vector of another item size.
+   cvector out = dblvec_create();
+   double offset = 0.5;
+   tfzassert(pTest, cvParallelTransform(cv, out, parToDouble, &offset),
+      success, false);
+   tfzassert(pTest, dblvec_count(out) == count, true, false);
+   tfzassert(pTest, dblvec_get(out, count - 1) == (count - 1) * 2 + 0.5,
+      true, false);
+   dblvec_destroy(&out);
+
+   // Sum of 2n for n < count.
+   int64_t sum = 0;
+   tfzassert(pTest, cvParallelReduce(cv, &sum, sizeof(sum),
+      parSumItem, parSumChunk, null), success, false);
+   tfzassert(pTest, sum == (int64_t)count * (count - 1), true, false);
+
+   // Parallel sort matches the serial stable sort.
+   uint32_t seed = 99;
+   for (uint32_t n = 0; n < count; ++n) {
+      seed = (seed * 1103515245) + 12345;
+      i32vec_set(cv, n, (int32_t)(seed >> 4));
+   }
+   cvector copy = i32vec_create();
+   cvAppendVector(copy, cv);
+   tfzassert(pTest, cvParallelSort(cv, cmpInt32), success, false);
+   cvStableSort(copy, cmpInt32);
+   tfzassert_buf(pTest, cvData(cv), count * sizeof(int32_t),
+      cvData(copy), count * sizeof(int32_t), false);
+   i32vec_destroy(&copy);
+
+   // Equal items keep their order.
+   cvector points = ptvec_create();
+   for (int32_t n = 0; n < 50000; ++n) {
+      point pt = { (n * 13) % 7, n };
+      ptvec_push(points, pt);
+   }
+   tfzassert(pTest, cvParallelSort(points, cmpPointX), success, false);
+   bool stable = true;
+   for (uint64_t n = 1; n < ptvec_count(points); ++n) {
+      point a = ptvec_get(points, n - 1);
+      point b = ptvec_get(points, n);
+      if (a.mX > b.mX || (a.mX == b.mX && a.mY > b.mY)) stable = false;
+   }
+   tfzassert(pTest, stable, true, false);
+   ptvec_destroy(&points);
+
+   // Success.
+   cvParSetChunkSize(0);
+   cvParSetThreads(0);
+   cvParShutdown();
+   i32vec_destroy(&cv);
+   return tfzassert_ptr(pTest, cv, null, false);
+}
+
+// Producer for testConcurrent(). Appends (thread << 32 | n) for n > 0.
+void* testProducer(void* pArg)
+{
+   producer* pProducer = (producer*)pArg;
+   for (uint64_t n = 1; n <= TEST_PRODUCER_ITEMS; ++n) {
+      uint64_t item = (pProducer->mThread << 32) | n;
+      svAppend(pProducer->mVector, &item);
+   }
+   return null;
+}
+
+// Tests concurrent appends while the published items are being read.
+bool testConcurrent(TFSuite pTest)
+{
+   const uint64_t total = TEST_PRODUCERS * TEST_PRODUCER_ITEMS;
+
+   // Concurrent vectors need a limit.
+   tfzassert_ptr(pTest, svcreatex(8, 64, svfconcurrent, 0), null, false);
+   segvector sv = svcreatex(sizeof(uint64_t), 64, svfconcurrent, total);
+   if (false == tfzassert(pTest, sv != null, true, false)) {
+      return false;
+   }
+   tfzassert(pTest, svGetSize(sv) == 0, true, false);
+
+   // Start the producers.
+   pthread_t threads[TEST_PRODUCERS];
+   producer producers[TEST_PRODUCERS];
+   for (uint64_t t = 0; t < TEST_PRODUCERS; ++t) {
+      producers[t].mVector = sv;
+      producers[t].mThread = t;
+      pthread_create(&threads[t], null, testProducer, &producers[t]);
+   }
+
+   // Published items are always written.
+   bool written = true;
+   uint64_t count = 0;
+   while (count < total) {
+      count = svGetCount(sv);
+      for (uint64_t n = 0; n < count; ++n) {
+         if ((*(uint64_t*)svGetAt(sv, n) & 0xFFFFFFFF) == 0) written = false;
+      }
+   }
+   for (uint64_t t = 0; t < TEST_PRODUCERS; ++t) {
+      pthread_join(threads[t], null);
+   }
+   tfzassert(pTest, written, true, false);
+
+   // Every item is there once, in order for each producer.
+   uint64_t last[TEST_PRODUCERS] = { 0 };
+   bool ordered = true;
+   for (uint64_t n = 0; n < total; ++n) {
+      uint64_t item = *(uint64_t*)svGetAt(sv, n);
+      uint64_t t = item >> 32;
+      if (t >= TEST_PRODUCERS || (item & 0xFFFFFFFF) != last[t] + 1) {
+         ordered = false;
+         break;
+      }
+      last[t]++;
+   }
+   tfzassert(pTest, ordered, true, false);
+   tfzassert(pTest, svGetSize(sv) == total, true, false);
+
+   // The vector is full.
+   uint64_t item = 1;
+   tfzassert_ptr(pTest, svAppend(sv, &item), null, false);
+   tfzassert(pTest, svGetCount(sv) == total, true, false);
+   tfzassert(pTest, svAppendCommit(sv, total) == fail, true, false);
+
+   // Clearing allows appends again; shrink keeps the directory.
+   svClear(sv);
+   svShrink(sv);
+   tfzassert(pTest, svGetSize(sv) == 0, true, false);
+   tfzassert(pTest, svPushBack(sv, &item) != null, true, false);
+   tfzassert(pTest, svEmplaceBack(sv) != null, true, false);
+   tfzassert(pTest, svGetCount(sv) == 2, true, false);
+   tfzassert(pTest, *(uint64_t*)svGetAt(sv, 0) == 1, true, false);
+
+   // Reserved items are published on commit.
+   uint64_t index = 0;
+   tfzassert(pTest, svAppendReserve(sv, &index) != null, true, false);
+   tfzassert(pTest, svAppendCommit(sv, index) == success, true, false);
+   tfzassert(pTest, svGetCount(sv) == 3, true, false);
+
+   // Success.
+   svdestroy(&sv);
+   return tfzassert_ptr(pTest, sv, null, false);
+}
+
+// True for odd uint32_t items.
+bool isOdd(void* a, void* pCtx)
+{
+   return (*(uint32_t*)a & 1);
+}
+
+// True for uint32_t items equal to the uint32_t at pCtx.
+bool isEqual(void* a, void* pCtx)
+{
+   return (*(uint32_t*)a == *(uint32_t*)pCtx);
+}
+
+// Tests middle inserts, erases, swap removes and predicate removes.
+bool testErase(TFSuite pTest)
+{
+   cvector cv = cvcreate(sizeof(uint32_t));
+   if (false == tfzassert(pTest, cv != null, true, false)) {
+      return false;
+   }
+   for (uint32_t n = 0; n < 10; ++n) {
+      cvPushBack(cv, makecvitem(n));
+   }
+
+   // Insert in the middle and at the end.
+   uint32_t item = 100;
+   tfzassert(pTest, cvInsertAt(cv, 3, makecvitem(item)) != null, true, false);
+   tfzassert(pTest, cvInsertAt(cv, 11, makecvitem(item)) != null, true, false);
+   tfzassert_ptr(pTest, cvInsertAt(cv, 13, makecvitem(item)), null, false);
+   uint32_t inserted[] = { 0, 1, 2, 100, 3, 4, 5, 6, 7, 8, 9, 100 };
+   tfzassert_buf(pTest, cvData(cv), sizeof(inserted),
+      inserted, sizeof(inserted), false);
+
+   // Erase them again; the vacated items are blanked.
+   tfzassert(pTest, cvEraseAt(cv, 11), success, false);
+   tfzassert(pTest, cvEraseAt(cv, 3), success, false);
+   tfzassert(pTest, cvEraseAt(cv, 10), fail, false);
+   tfzassert(pTest, cvGetCount(cv) == 10, true, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvAt(cv, 3), 3, false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvAt(cv, 10), 0, false);
+
+   // Erase a range.
+   tfzassert(pTest, cvEraseRange(cv, 2, 9), fail, false);
+   tfzassert(pTest, cvEraseRange(cv, 10, 0), success, false);
+   tfzassert(pTest, cvEraseRange(cv, 2, 3), success, false);
+   uint32_t erased[] = { 0, 1, 5, 6, 7, 8, 9 };
+   tfzassert_buf(pTest, cvData(cv), sizeof(erased),
+      erased, sizeof(erased), false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvAt(cv, 7), 0, false);
+
+   // Swap remove moves the last item into the gap.
+   tfzassert(pTest, cvSwapRemove(cv, 1), success, false);
+   tfzassert(pTest, cvSwapRemove(cv, 5), success, false);
+   tfzassert(pTest, cvSwapRemove(cv, 5), fail, false);
+   uint32_t swapped[] = { 0, 9, 5, 6, 7 };
+   tfzassert_buf(pTest, cvData(cv), sizeof(swapped),
+      swapped, sizeof(swapped), false);
+
+   // Remove odd items, then a missing item.
+   tfzassert(pTest, cvRemoveIf(cv, isOdd, null) == 3, true, false);
+   uint32_t even[] = { 0, 6 };
+   tfzassert_buf(pTest, cvData(cv), sizeof(even), even, sizeof(even), false);
+   tfzassert_ui32(pTest, *(uint32_t*)cvAt(cv, 2), 0, false);
+   item = 42;
+   tfzassert(pTest, cvRemoveIf(cv, isEqual, &item) == 0, true, false);
+   tfzassert(pTest, cvGetCount(cv) == 2, true, false);
+
+   // Remove everything.
+   item = 0;
+   tfzassert(pTest, cvRemoveIf(cv, isEqual, &item) == 1, true, false);
+   item = 6;
+   tfzassert(pTest, cvRemoveIf(cv, isEqual, &item) == 1, true, false);
+   tfzassert(pTest, cvGetCount(cv) == 0, true, false);
+   tfzassert(pTest, cvRemoveIf(cv, isOdd, null) == 0, true, false);
+
+   // Success.
+   cvdestroy(&cv);
+   return tfzassert_ptr(pTest, cv, null, false);
+}
+
 void runTests()
 {
    // Test suite.
@@ -198,6 +1119,18 @@ void runTests()
    testCreate(tfz);
    testBufferGrowth(tfz);
    testShrink(tfz);
+   testGrowthPolicy(tfz);
+   testBulk(tfz);
+   testSpan(tfz);
+   testTyped(tfz);
+   testNoScrub(tfz);
+   testLarge(tfz);
+   testSegmented(tfz);
+   testSmallBuffer(tfz);
+   testAlgo(tfz);
+   testParallel(tfz);
+   testConcurrent(tfz);
+   testErase(tfz);
 
    // Show results.
    tfzShowResults(tfz);
@@ -37,14 +37,26 @@ Version control
 31 Mar 2023 Duncan Camilleri           cvEmplaceBack() did not update item count
 31 Mar 2023 Duncan Camilleri           Fixed cvShrink realloc() misuse
 02 Apr 2023 Duncan Camilleri           Fixed cvEmplaceBack() returning bad addr
+17 Oct 2026 Duncan Camilleri           Growth policies (cvSetGrowthPolicy)
+17 Oct 2026 Duncan Camilleri           Bulk append and range insert
+17 Oct 2026 Duncan Camilleri           Public head (cvhead) for inline access
+17 Oct 2026 Duncan Camilleri           mTotalCount part of cvhead (vectort.h)
+17 Oct 2026 Duncan Camilleri           cvcreatex(), no-scrub, cvEmplaceBackN
+17 Oct 2026 Duncan Camilleri           64 bit counts, mmap backed large vectors
+17 Oct 2026 Duncan Camilleri           Small buffer vectors (cvcreatesbo)
+17 Oct 2026 Duncan Camilleri           Middle insert/erase, swap/pred. remove
 */
 
 //
 // INCLUDES
 //
+#define _GNU_SOURCE                                // mremap
 #include <inttypes.h>
+#include <stddef.h>
 #include <memory.h>
 #include <malloc.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include <commons.h>
 #include <vector.h>
@@ -53,20 +65,53 @@ Version control
 // MACROS
 //
 #define VECTOR_DEFAULT_ALLOCUNITS            8
+#define VECTOR_DEFAULT_GROWTHPCT             200
+#define VECTOR_DEFAULT_PAGESIZE              4096
 
 //
 // STRUCTS
 //
 
+// The first members are laid out as the public cvhead in vector.h so that the
+// inline accessors can reach them. Do not reorder!
 typedef struct _vector {
+   void* mpData;                                   // items
+   uint64_t mItemCount;                            // number of items
+   uint64_t mTotalCount;                           // all items (incl. blanks) 
    uint32_t mItemSize;                             // size per item - duh
-   uint32_t mItemCount;                            // number of items
-   uint32_t mTotalCount;                           // all items (incl. blanks) 
 
+   uint32_t mFlags;                                // cvflags given on creation
    uint32_t mItemsPerAlloc;                        // items to alloc each time
-   void* mpData;
+   cvgrowth mGrowth;                               // growth policy
+   uint32_t mGrowthPct;                            // geometric growth factor
+   uint32_t mPageSize;                             // page rounding size
+   uint32_t mAllocCount;                           // data (re)allocations
+   size_t mMapSize;                                // bytes mapped (cvflarge)
+   uint64_t mInlineCount;                          // items held inline (sbo)
+   uint64_t mShadowCount;                          // heap capacity (sbo)
 } vector;
 
+_Static_assert(offsetof(vector, mpData) == offsetof(cvhead, mpData),
+   "vector: mpData must match cvhead");
+_Static_assert(offsetof(vector, mItemSize) == offsetof(cvhead, mItemSize),
+   "vector: mItemSize must match cvhead");
+_Static_assert(offsetof(vector, mItemCount) == offsetof(cvhead, mItemCount),
+   "vector: mItemCount must match cvhead");
+_Static_assert(offsetof(vector, mTotalCount) == offsetof(cvhead, mTotalCount),
+   "vector: mTotalCount must match cvhead");
+
+//
+// GLOBALS
+//
+
+// Allocations avoided by small buffer vectors (process wide).
+static uint64_t gAllocsAvoided = 0;
+
+//
+// PROTOTYPES
+//
+void freeData(vector* pv);
+
 //
 // CREATION/DESTRUCTION.
 //
@@ -75,6 +120,16 @@ typedef struct _vector {
 // be allocated unless necessary.
 cvector cvcreate(uint32_t itemSize)
 {
+   return cvcreatex(itemSize, cvfnone);
+}
+
+// Create a new vector with creation flags (cvflags combined). Otherwise the
+// same as cvcreate().
+cvector cvcreatex(uint32_t itemSize, uint32_t flags)
+{
+   // Huge pages only apply to mapped data.
+   if (flags & cvfhugepage) flags |= cvflarge;
+
    // Allocate vector for now.
    vector* pv = (vector*)malloc(sizeof(vector));
    if (!pv) return nul;
@@ -84,13 +139,75 @@ cvector cvcreate(uint32_t itemSize)
    pv->mItemSize = itemSize;
    pv->mItemCount = 0;
    pv->mTotalCount = 0;
+   pv->mFlags = flags;
    pv->mItemsPerAlloc = VECTOR_DEFAULT_ALLOCUNITS;
+   pv->mGrowth = cvgrowgeometric;
+   pv->mGrowthPct = VECTOR_DEFAULT_GROWTHPCT;
+   pv->mPageSize = VECTOR_DEFAULT_PAGESIZE;
+   pv->mAllocCount = 0;
+   pv->mMapSize = 0;
+   pv->mInlineCount = 0;
+   pv->mShadowCount = 0;
    pv->mpData = nul;
 
+   // Large vectors are mapped in whole pages.
+   if (flags & cvflarge) {
+      long pageSize = sysconf(_SC_PAGESIZE);
+      if (pageSize > 0) pv->mPageSize = (uint32_t)pageSize;
+   }
+
    // Done.
    return (cvector)pv;
 }
 
+// Create a new small buffer vector. The first inlineCount items are stored
+// in the same allocation as the vector itself; the heap is only used once more
+// items are needed (and cvShrink moves items back inline when they fit).
+// Large vectors (cvflarge) cannot be small buffer vectors.
+cvector cvcreatesbo(uint32_t itemSize, uint32_t inlineCount, uint32_t flags)
+{
+   if (flags & (cvflarge | cvfhugepage)) return nul;
+   if (inlineCount == 0) return cvcreatex(itemSize, flags);
+
+   // Allocate vector and inline items together.
+   size_t inlineSize = (size_t)itemSize * inlineCount;
+   vector* pv = (vector*)malloc(sizeof(vector) + inlineSize);
+   if (!pv) return nul;
+   memset(pv, 0, sizeof(vector) + inlineSize);
+
+   // Initialize.
+   pv->mItemSize = itemSize;
+   pv->mItemCount = 0;
+   pv->mTotalCount = inlineCount;
+   pv->mFlags = flags;
+   pv->mItemsPerAlloc = VECTOR_DEFAULT_ALLOCUNITS;
+   pv->mGrowth = cvgrowgeometric;
+   pv->mGrowthPct = VECTOR_DEFAULT_GROWTHPCT;
+   pv->mPageSize = VECTOR_DEFAULT_PAGESIZE;
+   pv->mAllocCount = 0;
+   pv->mMapSize = 0;
+   pv->mInlineCount = inlineCount;
+   pv->mShadowCount = 0;
+   pv->mpData = (void*)(pv + 1);
+
+   // Done.
+   return (cvector)pv;
+}
+
+// Returns the number of data allocations small buffer vectors avoided so far
+// compared to regular vectors with the same growth policy. Only pushes made
+// through the checked api are accounted for.
+uint64_t cvGetAllocsAvoided()
+{
+   return __atomic_load_n(&gAllocsAvoided, __ATOMIC_RELAXED);
+}
+
+// Resets the count of allocations avoided.
+void cvResetAllocsAvoided()
+{
+   __atomic_store_n(&gAllocsAvoided, 0, __ATOMIC_RELAXED);
+}
+
 // Destroy existing vector.
 void cvdestroy(cvector* pv)
 {
@@ -100,8 +217,7 @@ void cvdestroy(cvector* pv)
    // Free data first.
    vector* v = (vector*)*pv;
    if (v->mpData) {
-      free(v->mpData);
-      v->mpData = nul;
+      freeData(v);
    }
 
    free(*pv);
@@ -112,20 +228,137 @@ void cvdestroy(cvector* pv)
 // Private API - Memory allocation.
 //
 
+// growthTarget returns the total number of items a vector holding fromCount
+// items should be able to hold so that at least needCount items fit. This is
+// where the growth policy of the vector is applied. When exact is true, the
+// capacity is only rounded as the policy requires (used by reservations and
+// shrinking); otherwise a geometric vector will grow by its growth factor to
+// keep pushes amortized.
+uint64_t growthTarget(const vector* pv,
+   uint64_t fromCount, uint64_t needCount, bool exact)
+{
+   uint64_t target = needCount;
+
+   if (pv->mGrowth == cvgrowfixed) {
+      // Round up to the next chunk of items per allocation.
+      target += (pv->mItemsPerAlloc - (needCount % pv->mItemsPerAlloc));
+   } else if (!exact) {
+      // Geometric growth (never less than the items per allocation).
+      uint64_t grown = ((fromCount / 100) * pv->mGrowthPct) +
+         (((fromCount % 100) * pv->mGrowthPct) / 100);
+      if (target < grown) target = grown;
+      if (target < pv->mItemsPerAlloc) target = pv->mItemsPerAlloc;
+   }
+
+   // Capacity is limited to what can be addressed.
+   if (pv->mItemSize > 0) {
+      uint64_t maxCount = (SIZE_MAX - pv->mPageSize) / pv->mItemSize;
+      if (target > maxCount) target = maxCount;
+   }
+
+   // Page rounding applies to the byte size of the buffer. Large vectors are
+   // always mapped in whole pages.
+   if ((pv->mGrowth == cvgrowpage || (pv->mFlags & cvflarge)) &&
+      pv->mItemSize > 0) {
+      uint64_t bytes = target * pv->mItemSize;
+      bytes += (pv->mPageSize - 1);
+      bytes -= (bytes % pv->mPageSize);
+      target = bytes / pv->mItemSize;
+   }
+
+   return target;
+}
+
+// mapData grows (or first maps) the data of a large vector to newSize bytes
+// (whole pages). Growth uses mremap() so data is never copied. Mapped memory
+// is always blank when first touched. A mapping that is large enough already
+// (after cvShrink) is reused as is.
+retcode mapData(vector* pv, size_t newSize)
+{
+   void* pBuf = nul;
+   if (newSize <= pv->mMapSize) {
+      return success;
+   } else if (!pv->mpData) {
+      pBuf = mmap(nul, newSize, PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0
+      );
+   } else {
+      pBuf = mremap(pv->mpData, pv->mMapSize, newSize, MREMAP_MAYMOVE);
+   }
+   if (MAP_FAILED == pBuf) return fail;
+
+#ifdef MADV_HUGEPAGE
+   // Transparent huge pages are only a hint.
+   if (pv->mFlags & cvfhugepage) {
+      madvise(pBuf, newSize, MADV_HUGEPAGE);
+   }
+#endif
+
+   pv->mpData = pBuf;
+   pv->mMapSize = newSize;
+   return success;
+}
+
+// isInline is true when the items of a small buffer vector are stored inline.
+bool isInline(const vector* pv)
+{
+   return (pv->mInlineCount > 0 && pv->mpData == (void*)(pv + 1));
+}
+
+// freeData releases all data of a vector. Inline items are left alone.
+void freeData(vector* pv)
+{
+   if (isInline(pv)) {
+      return;
+   } else if (pv->mFlags & cvflarge) {
+      munmap(pv->mpData, pv->mMapSize);
+      pv->mMapSize = 0;
+   } else {
+      free(pv->mpData);
+   }
+   pv->mpData = nul;
+}
+
 // extend is used by extendBuffer to extend by the number of items specified
-// the memory buffer allocated for data in the vector. This will be rounded to
-// the default number of allocation units of the vector.
-retcode extend(vector* pv, uint32_t byItemCount)
+// the memory buffer allocated for data in the vector. Rounding is the job of
+// the caller (see growthTarget). New items are blanked unless the vector was
+// created with cvfnoscrub. A first allocation is made with calloc() which
+// gets already blank memory from the system for large buffers.
+retcode extend(vector* pv, uint64_t byItemCount)
 {
-   uint32_t newSize = (pv->mTotalCount + byItemCount) * pv->mItemSize;
-   void* pBuf = realloc(pv->mpData, newSize);
-   if (!pBuf) return fail;
+   size_t newSize = (size_t)(pv->mTotalCount + byItemCount) * pv->mItemSize;
+   bool scrub = ((pv->mFlags & cvfnoscrub) == 0);
+   bool blank = false;
+
+   if (pv->mFlags & cvflarge) {
+      // Mapped memory is blank already.
+      if (fail == mapData(pv, newSize)) return fail;
+      blank = true;
+   } else if (isInline(pv)) {
+      // Spill inline items to the heap.
+      void* pBuf = malloc(newSize);
+      if (!pBuf) return fail;
+      memcpy(pBuf, pv->mpData, (size_t)pv->mTotalCount * pv->mItemSize);
+      pv->mpData = pBuf;
+   } else {
+      void* pBuf = nul;
+      if (!pv->mpData && scrub) {
+         pBuf = calloc(1, newSize);
+         blank = true;
+      } else {
+         pBuf = realloc(pv->mpData, newSize);
+      }
+      if (!pBuf) return fail;
+      pv->mpData = pBuf;
+   }
 
    // Clean up and update data.
-   pv->mpData = pBuf;
-   memset(pv->mpData + (pv->mItemSize * pv->mTotalCount),
-      0 , pv->mItemSize * byItemCount
-   );
+   pv->mAllocCount++;
+   if (scrub && !blank) {
+      memset(pv->mpData + ((size_t)pv->mItemSize * pv->mTotalCount),
+         0 , (size_t)pv->mItemSize * byItemCount
+      );
+   }
    pv->mTotalCount += byItemCount;
 
    // Done.
@@ -134,19 +367,31 @@ retcode extend(vector* pv, uint32_t byItemCount)
 
 // extendBuffer extends the buffer to ensure newItemCount items can be stored in
 // the vector when this is greater than 0. When it's 0, the buffer is
-// extended by mItemsPerAlloc items if there are no more free items available
-// (ie. mTotalCount == mItemCount). The buffer is always incremented in
-// mItemsPerAlloc chunks (using %).
+// extended to fit one more item if there are no more free items available
+// (ie. mTotalCount == mItemCount). The new size of the buffer is decided by
+// the growth policy of the vector (see growthTarget).
 // If the number of items requested is already a factor that's manageable by the
 // vector, nothing will be allocated and everything stays as is.
-retcode extendBuffer(vector* pv, uint32_t newItemCount)
+retcode extendBuffer(vector* pv, uint64_t newItemCount)
 {
-   // Add a new set of blank items to the end of the vector buffer.
+   // Make room for one more item at the end of the vector buffer.
    if (newItemCount == 0) {
       if (pv->mTotalCount > pv->mItemCount)
          return success;
 
-      return extend(pv, pv->mItemsPerAlloc);
+      newItemCount = pv->mItemCount + 1;
+   }
+
+   // Inline items of a small buffer vector. Account for the allocations a
+   // regular vector would have made.
+   if (isInline(pv) && newItemCount > pv->mShadowCount) {
+      while (newItemCount > pv->mShadowCount) {
+         uint64_t shadow =
+            growthTarget(pv, pv->mShadowCount, newItemCount, false);
+         if (shadow > pv->mInlineCount) break;
+         pv->mShadowCount = shadow;
+         __atomic_fetch_add(&gAllocsAvoided, 1, __ATOMIC_RELAXED);
+      }
    }
 
    // Specific item count specified. Do not do anything if the item count
@@ -156,8 +401,18 @@ retcode extendBuffer(vector* pv, uint32_t newItemCount)
    }
 
    // We need to allocate more items.
-   newItemCount += (pv->mItemsPerAlloc - (newItemCount % pv->mItemsPerAlloc));
-   return extend(pv, newItemCount - pv->mTotalCount);
+   uint64_t target = growthTarget(pv, pv->mTotalCount, newItemCount, false);
+   if (target < newItemCount) return fail;
+   return extend(pv, target - pv->mTotalCount);
+}
+
+// Blanks count items from index onwards unless the vector is cvfnoscrub.
+void blankItems(vector* pv, uint64_t index, uint64_t count)
+{
+   if (count == 0 || (pv->mFlags & cvfnoscrub)) return;
+   memset(pv->mpData + ((size_t)index * pv->mItemSize), 0,
+      (size_t)count * pv->mItemSize
+   );
 }
 
 //
@@ -165,7 +420,7 @@ retcode extendBuffer(vector* pv, uint32_t newItemCount)
 //
 
 // Returns the number of valid items in the vector.
-uint32_t cvGetCount(ccvector cv)
+uint64_t cvGetCount(ccvector cv)
 {
    // Access vector.
    const vector* pv = (const vector*)cv;
@@ -173,24 +428,83 @@ uint32_t cvGetCount(ccvector cv)
 }
 
 // Returns the total number of items in the vector (valid or invalid).
-uint32_t cvGetSize(ccvector cv)
+uint64_t cvGetSize(ccvector cv)
 {
    // Access vector.
    const vector* pv = (const vector*)cv;
    return (pv ? pv->mTotalCount : 0);
 }
 
+// Returns the number of times the vector data buffer has been (re)allocated.
+uint32_t cvGetAllocCount(ccvector cv)
+{
+   // Access vector.
+   const vector* pv = (const vector*)cv;
+   return (pv ? pv->mAllocCount : 0);
+}
+
+// Sets the growth policy of the vector. The meaning of param depends on the
+// policy chosen (0 always selects the default):
+//    cvgrowgeometric   : growth factor in percent (> 100, default 200)
+//    cvgrowfixed       : items per allocation (default 8)
+//    cvgrowpage        : page size in bytes (default is the system page size)
+// A page rounded vector grows geometrically by the default growth factor.
+// Large vectors (cvflarge) map and release whole pages so their page size
+// must be a multiple of the system page size. Memory already allocated is left
+// untouched.
+retcode cvSetGrowthPolicy(cvector v, cvgrowth policy, uint32_t param)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv) return fail;
+
+   switch (policy) {
+   case cvgrowgeometric:
+      if (param == 0) param = VECTOR_DEFAULT_GROWTHPCT;
+      if (param <= 100) return fail;
+      pv->mGrowthPct = param;
+      break;
+
+   case cvgrowfixed:
+      if (param == 0) param = VECTOR_DEFAULT_ALLOCUNITS;
+      pv->mItemsPerAlloc = param;
+      break;
+
+   case cvgrowpage: {
+      long pageSize = sysconf(_SC_PAGESIZE);
+      uint32_t sysPageSize =
+         (pageSize > 0 ? (uint32_t)pageSize : VECTOR_DEFAULT_PAGESIZE);
+      if (param == 0) param = sysPageSize;
+      if ((pv->mFlags & cvflarge) && (param % sysPageSize) != 0) return fail;
+      pv->mGrowthPct = VECTOR_DEFAULT_GROWTHPCT;
+      pv->mPageSize = param;
+      break;
+   }
+
+   default:
+      return fail;
+   }
+
+   pv->mGrowth = policy;
+   return success;
+}
+
 // Reserve itemCount items in the vector. This ensures that the vector can
 // hold that amount of items. If there is no space to store such items, it
-// is allocated ensuring rounding is as per vector's items per allocation
-// value.
-retcode cvReserve(cvector v, uint32_t itemCount)
+// is allocated ensuring rounding is as per vector's growth policy. Unlike
+// pushing, a reservation does not grow a geometric vector beyond itemCount.
+retcode cvReserve(cvector v, uint64_t itemCount)
 {
    // Access vector.
    vector* pv = (vector*)v;
    if (!pv) return fail;
 
-   return extendBuffer(pv, itemCount);
+   // Nothing to do if the vector can already hold the items.
+   if (itemCount <= pv->mTotalCount) return success;
+
+   uint64_t target = growthTarget(pv, pv->mTotalCount, itemCount, true);
+   if (target < itemCount) return fail;
+   return extend(pv, target - pv->mTotalCount);
 }
 
 // Creates item at end and returns location of item. Will return null if it
@@ -210,11 +524,31 @@ void* cvEmplaceBack(cvector v, uint32_t* pSize)
    if (pSize) *pSize = pv->mItemSize;
 
    // Return the empty item.
-   void* dest = (pv->mpData + (pv->mItemCount * pv->mItemSize));
+   void* dest = (pv->mpData + ((size_t)pv->mItemCount * pv->mItemSize));
    pv->mItemCount++;
    return dest;
 }
 
+// Creates count items at the end and returns the location of the first one.
+// Will return null if it fails or count is 0. Caller expected to fill all the
+// items; these are uninitialized when the vector was created with cvfnoscrub.
+void* cvEmplaceBackN(cvector v, uint64_t count)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv || count == 0) return null;
+   if (pv->mItemCount + count < count) return null;
+
+   // Allocate space if need be.
+   if (fail == extendBuffer(pv, pv->mItemCount + count))
+      return null;
+
+   // Return the first item.
+   void* dest = (pv->mpData + ((size_t)pv->mItemCount * pv->mItemSize));
+   pv->mItemCount += count;
+   return dest;
+}
+
 // Adds an item after the last item added. Returns a pointer to the item.
 void* cvPushBack(cvector v, cvitem item)
 {
@@ -229,7 +563,7 @@ void* cvPushBack(cvector v, cvitem item)
       return null;
 
    // Copy the item.
-   void* dest = (pv->mpData + (pv->mItemCount * pv->mItemSize));
+   void* dest = (pv->mpData + ((size_t)pv->mItemCount * pv->mItemSize));
    memcpy(dest, item, pv->mItemSize);
    pv->mItemCount++;
 
@@ -237,7 +571,182 @@ void* cvPushBack(cvector v, cvitem item)
    return dest;
 }
 
-// Removes (blanks) last item.
+// Adds count items (stored contiguously at items) after the last item. The
+// buffer is grown at most once and items are copied in one go. Returns a
+// pointer to the first item added or null on failure or when count is 0.
+// Note: items should not point inside the vector itself.
+void* cvPushBackN(cvector v, ccvitem items, uint64_t count)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv) return null;
+   // ...and items.
+   if (!items || count == 0) return null;
+   if (pv->mItemCount + count < count) return null;
+
+   // Allocate space if need be.
+   if (fail == extendBuffer(pv, pv->mItemCount + count))
+      return null;
+
+   // Copy the items.
+   void* dest = (pv->mpData + ((size_t)pv->mItemCount * pv->mItemSize));
+   memcpy(dest, items, (size_t)count * pv->mItemSize);
+   pv->mItemCount += count;
+
+   // Done.
+   return dest;
+}
+
+// Appends all the items of src to the end of dst. Both vectors must hold items
+// of the same size. Appending a vector to itself is allowed.
+retcode cvAppendVector(cvector dst, ccvector src)
+{
+   // Access vectors.
+   vector* pDst = (vector*)dst;
+   const vector* pSrc = (const vector*)src;
+   if (!pDst || !pSrc) return fail;
+   if (pDst->mItemSize != pSrc->mItemSize) return fail;
+
+   // Nothing to append?
+   uint64_t count = pSrc->mItemCount;
+   if (count == 0) return success;
+
+   // Allocate space if need be. Source data is only located after this as it
+   // moves if both vectors are the same one.
+   if (fail == extendBuffer(pDst, pDst->mItemCount + count))
+      return fail;
+
+   // Copy the items.
+   memcpy(pDst->mpData + ((size_t)pDst->mItemCount * pDst->mItemSize),
+      pSrc->mpData, (size_t)count * pSrc->mItemSize
+   );
+   pDst->mItemCount += count;
+
+   // Done.
+   return success;
+}
+
+// Inserts count items (stored contiguously at items) before the item at index.
+// An index equal to the item count appends. Items following index are moved
+// up with a single memmove. Returns a pointer to the first item inserted or
+// null on failure or when count is 0.
+// Note: items should not point inside the vector itself.
+void* cvInsertRange(cvector v, uint64_t index, ccvitem items, uint64_t count)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv) return null;
+   // ...and items.
+   if (!items || count == 0) return null;
+   if (index > pv->mItemCount) return null;
+   if (pv->mItemCount + count < count) return null;
+
+   // Allocate space if need be.
+   if (fail == extendBuffer(pv, pv->mItemCount + count))
+      return null;
+
+   // Open a gap and copy the items into it.
+   void* dest = (pv->mpData + ((size_t)index * pv->mItemSize));
+   memmove(dest + ((size_t)count * pv->mItemSize), dest,
+      (size_t)(pv->mItemCount - index) * pv->mItemSize
+   );
+   memcpy(dest, items, (size_t)count * pv->mItemSize);
+   pv->mItemCount += count;
+
+   // Done.
+   return dest;
+}
+
+// Inserts item before the item at index. An index equal to the item count
+// appends. Returns a pointer to the item inserted or null on failure.
+void* cvInsertAt(cvector v, uint64_t index, cvitem item)
+{
+   return cvInsertRange(v, index, item, 1);
+}
+
+// Removes count items starting at index keeping the order of the items that
+// follow, which are moved down with a single memmove. The vacated items at the
+// end are blanked (unless cvfnoscrub).
+retcode cvEraseRange(cvector v, uint64_t index, uint64_t count)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv) return fail;
+   if (index > pv->mItemCount || count > pv->mItemCount - index) return fail;
+   if (count == 0) return success;
+
+   // Close the gap.
+   void* dest = pv->mpData + ((size_t)index * pv->mItemSize);
+   memmove(dest, dest + ((size_t)count * pv->mItemSize),
+      (size_t)(pv->mItemCount - index - count) * pv->mItemSize
+   );
+   pv->mItemCount -= count;
+   blankItems(pv, pv->mItemCount, count);
+
+   // Done.
+   return success;
+}
+
+// Removes the item at index keeping the order of the items that follow.
+retcode cvEraseAt(cvector v, uint64_t index)
+{
+   return cvEraseRange(v, index, 1);
+}
+
+// Removes the item at index in constant time by moving the last item into its
+// place. The order of items is not preserved.
+retcode cvSwapRemove(cvector v, uint64_t index)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv) return fail;
+   if (index >= pv->mItemCount) return fail;
+
+   // Move the last item down.
+   uint64_t last = pv->mItemCount - 1;
+   if (index != last) {
+      memcpy(pv->mpData + ((size_t)index * pv->mItemSize),
+         pv->mpData + ((size_t)last * pv->mItemSize), pv->mItemSize
+      );
+   }
+   pv->mItemCount--;
+   blankItems(pv, last, 1);
+
+   // Done.
+   return success;
+}
+
+// Removes every item for which pred returns true, keeping the order of the
+// remaining items. Items are compacted in a single pass and the vacated items
+// at the end are blanked (unless cvfnoscrub). Returns the number removed.
+uint64_t cvRemoveIf(cvector v, predicate pred, void* pCtx)
+{
+   // Access vector.
+   vector* pv = (vector*)v;
+   if (!pv || !pred) return 0;
+
+   // Items before the first removed one stay where they are.
+   uint32_t size = pv->mItemSize;
+   uint64_t count = pv->mItemCount;
+   uint64_t kept = 0;
+   while (kept < count && !pred(pv->mpData + ((size_t)kept * size), pCtx)) {
+      kept++;
+   }
+
+   // Move each remaining item that is kept down.
+   for (uint64_t n = kept + 1; n < count; ++n) {
+      void* pItem = pv->mpData + ((size_t)n * size);
+      if (pred(pItem, pCtx)) continue;
+      memcpy(pv->mpData + ((size_t)kept * size), pItem, size);
+      kept++;
+   }
+
+   pv->mItemCount = kept;
+   blankItems(pv, kept, count - kept);
+   return count - kept;
+}
+
+// Removes (blanks) last item. The item is not blanked with cvfnoscrub.
 void cvPopBack(cvector v)
 {
    // Access vector.
@@ -249,11 +758,15 @@ void cvPopBack(cvector v)
 
    // Clear last item buffer.
    pv->mItemCount--;
-   memset(pv->mpData + (pv->mItemSize * pv->mItemCount), 0 , pv->mItemSize);
+   if (pv->mFlags & cvfnoscrub) return;
+   memset(pv->mpData + ((size_t)pv->mItemSize * pv->mItemCount),
+      0 , pv->mItemSize
+   );
 }
 
-// Removes all items from the vector. Items will be blanked out. To completely
-// free up the vector, cvShrink() can be called after.
+// Removes all items from the vector. Items will be blanked out unless the
+// vector was created with cvfnoscrub. To completely free up the vector,
+// cvShrink() can be called after.
 void cvClear(cvector v)
 {
    // Access vector.
@@ -261,12 +774,15 @@ void cvClear(cvector v)
    if (!pv) return;
 
    // Just clear all the buffer.
-   memset(pv->mpData, 0, pv->mItemSize * pv->mItemCount);
+   if (pv->mpData && (pv->mFlags & cvfnoscrub) == 0) {
+      memset(pv->mpData, 0, (size_t)pv->mItemSize * pv->mItemCount);
+   }
    pv->mItemCount = 0;
 }
 
-// Removes trailing blank items from the vector. Note, that empty items in the
-// middle will not be removed. This is to preserve indexes and speed.
+// Frees memory past the last item, down to what the growth policy would
+// allocate for the items held. Items themselves are never removed; use
+// cvEraseRange() or cvRemoveIf() to remove items in the middle.
 void cvShrink(cvector v)
 {
    // Access vector.
@@ -274,37 +790,63 @@ void cvShrink(cvector v)
    if (!pv) return;
    if (!pv->mpData) return;
 
+   // Small buffer vectors move their items back inline when they fit.
+   if (pv->mInlineCount > 0 && pv->mItemCount <= pv->mInlineCount) {
+      if (isInline(pv)) return;
+
+      void* pInline = (void*)(pv + 1);
+      size_t liveSize = (size_t)pv->mItemCount * pv->mItemSize;
+      memcpy(pInline, pv->mpData, liveSize);
+      if ((pv->mFlags & cvfnoscrub) == 0) {
+         memset(pInline + liveSize, 0,
+            (size_t)(pv->mInlineCount - pv->mItemCount) * pv->mItemSize
+         );
+      }
+      free(pv->mpData);
+      pv->mpData = pInline;
+      pv->mTotalCount = pv->mInlineCount;
+      pv->mShadowCount = pv->mItemCount;
+      return;
+   }
+
    // If we don't have enough memory allocated, there is nothing to shrink.
    // Note, in this case shrink will not allocate any memory. Just shrink.
-   uint32_t newTotal = 0;
+   uint64_t newTotal = 0;
    if (pv->mItemCount > 0) {
-      newTotal = (pv->mItemCount + (pv->mItemsPerAlloc -
-         (pv->mItemCount % pv->mItemsPerAlloc))
-      );
+      newTotal = growthTarget(pv, pv->mTotalCount, pv->mItemCount, true);
    }
 
    if (pv->mTotalCount <= newTotal)
       return;
 
    // Reallocate.
-   if (newTotal > 0) {
-      void* pBuf = realloc(pv->mpData, newTotal * pv->mItemSize);
+   if (newTotal > 0 && (pv->mFlags & cvflarge)) {
+      // Large vectors keep their mapping (so they may grow back in place) but
+      // give the pages past the last item back to the system.
+      size_t keep = (size_t)newTotal * pv->mItemSize;
+      keep += (pv->mPageSize - 1);
+      keep -= (keep % pv->mPageSize);
+      if (keep < pv->mMapSize) {
+         madvise(pv->mpData + keep, pv->mMapSize - keep, MADV_DONTNEED);
+      }
+   } else if (newTotal > 0) {
+      void* pBuf = realloc(pv->mpData, (size_t)newTotal * pv->mItemSize);
       if (!pBuf) return;
 
       // Set buffer.
       pv->mpData = pBuf;
+      pv->mAllocCount++;
    } else {
-      free(pv->mpData);
-      pv->mpData = nul;
+      freeData(pv);
    }
 
    // Since we are only shrinking, there is no memory to clear. Item count is
-   // untouched but we freed unused memory up to and rounded by items per alloc.
+   // untouched but we freed unused memory up to and rounded by growth policy.
    pv->mTotalCount = newTotal;
 }
 
 // Get item at index. If no item exists, nul is returned.
-void* cvGetAt(cvector v, uint32_t index)
+void* cvGetAt(cvector v, uint64_t index)
 {
    // Access vector.
    vector* pv = (vector*)v;
@@ -315,13 +857,13 @@ void* cvGetAt(cvector v, uint32_t index)
    if (index >= pv->mItemCount) return nul;
 
    // Return item.
-   return (void*)(pv->mpData + (pv->mItemSize * index));
+   return (void*)(pv->mpData + ((size_t)pv->mItemSize * index));
 }
 
 // Sets the item at index and returns it back. To pass an item of the specified
 // itemSize, use makecvitem(item). To access an item from a cvitem, use
 // makeitem(cvitem). 
-void* cvSetAt(cvector v, uint32_t index, cvitem item)
+void* cvSetAt(cvector v, uint64_t index, cvitem item)
 {
    // Access vector.
    vector* pv = (vector*)v;
@@ -332,7 +874,7 @@ void* cvSetAt(cvector v, uint32_t index, cvitem item)
    if (index >= pv->mItemCount) return nul;
 
    // Copy item.
-   void* vItem = (pv->mpData + (pv->mItemSize * index));
+   void* vItem = (pv->mpData + ((size_t)pv->mItemSize * index));
    memcpy(vItem, item, pv->mItemSize);
    return vItem;
 }
@@ -0,0 +1,581 @@
+/*
+Date: 17 Oct 2026 14:05:52.618207740
+File: vectoralgo.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __VECTORALGO_C_94C0E2A7B3D15F68E2A0C49B7D3E1F05__
+Purpose: Sorting and searching over vectors.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+#include <immintrin.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+
+//
+// MACROS
+//
+
+// Ranges this small are insertion sorted.
+#define VECTORALGO_INSERTION_ITEMS           16
+// Largest item copied through a stack buffer (larger items are allocated).
+#define VECTORALGO_STACK_ITEMSIZE            256
+
+// Item at index in a buffer of items of size bytes.
+#define algoitem(_p, _i, _size)              ((_p) + ((size_t)(_i) * (_size)))
+
+//
+// TYPES
+//
+
+// Linear find over items of 4 or 8 bytes.
+typedef uint64_t (*finder)(const void* pData, uint64_t count, const void* item);
+
+//
+// Private API - Sorting.
+//
+
+// Swaps items a and b of size bytes through pTmp.
+void algoSwap(void* a, void* b, void* pTmp, uint32_t size)
+{
+   memcpy(pTmp, a, size);
+   memcpy(a, b, size);
+   memcpy(b, pTmp, size);
+}
+
+// Insertion sorts count items at pData. Equal items keep their order.
+void algoInsertionSort(void* pData, uint64_t count, uint32_t size,
+   comparator cmp, void* pTmp)
+{
+   for (uint64_t i = 1; i < count; ++i) {
+      // Find where item i goes.
+      uint64_t j = i;
+      while (j > 0 &&
+         cmp(algoitem(pData, j - 1, size), algoitem(pData, i, size)) > 0) {
+         --j;
+      }
+      if (j == i) continue;
+
+      // Move it there.
+      memcpy(pTmp, algoitem(pData, i, size), size);
+      memmove(algoitem(pData, j + 1, size), algoitem(pData, j, size),
+         (size_t)(i - j) * size
+      );
+      memcpy(algoitem(pData, j, size), pTmp, size);
+   }
+}
+
+// Sifts item root down the heap of count items at pData.
+void algoSiftDown(void* pData, uint64_t root, uint64_t count, uint32_t size,
+   comparator cmp, void* pTmp)
+{
+   for (;;) {
+      uint64_t child = (root * 2) + 1;
+      if (child >= count) return;
+      if (child + 1 < count && cmp(algoitem(pData, child, size),
+         algoitem(pData, child + 1, size)) < 0) {
+         child++;
+      }
+      if (cmp(algoitem(pData, root, size), algoitem(pData, child, size)) >= 0)
+         return;
+
+      algoSwap(algoitem(pData, root, size), algoitem(pData, child, size),
+         pTmp, size
+      );
+      root = child;
+   }
+}
+
+// Heap sorts count items at pData (introsort fallback).
+void algoHeapSort(void* pData, uint64_t count, uint32_t size,
+   comparator cmp, void* pTmp)
+{
+   for (uint64_t n = count / 2; n > 0; --n) {
+      algoSiftDown(pData, n - 1, count, size, cmp, pTmp);
+   }
+   for (uint64_t n = count - 1; n > 0; --n) {
+      algoSwap(pData, algoitem(pData, n, size), pTmp, size);
+      algoSiftDown(pData, 0, n, size, cmp, pTmp);
+   }
+}
+
+// Introsort of count items at pData. pTmp and pPivot hold one item each.
+// Recursion is on the smaller partition only; depth falls back to heap sort.
+void algoIntroSort(void* pData, uint64_t count, uint32_t size,
+   comparator cmp, void* pTmp, void* pPivot, uint32_t depth)
+{
+   while (count > VECTORALGO_INSERTION_ITEMS) {
+      if (depth-- == 0) {
+         algoHeapSort(pData, count, size, cmp, pTmp);
+         return;
+      }
+
+      // Median of three to the middle.
+      void* pLo = pData;
+      void* pMid = algoitem(pData, count / 2, size);
+      void* pHi = algoitem(pData, count - 1, size);
+      if (cmp(pMid, pLo) < 0) algoSwap(pMid, pLo, pTmp, size);
+      if (cmp(pHi, pMid) < 0) {
+         algoSwap(pHi, pMid, pTmp, size);
+         if (cmp(pMid, pLo) < 0) algoSwap(pMid, pLo, pTmp, size);
+      }
+      memcpy(pPivot, pMid, size);
+
+      // Hoare partition.
+      int64_t i = -1;
+      int64_t j = (int64_t)count;
+      for (;;) {
+         do { ++i; } while (cmp(algoitem(pData, i, size), pPivot) < 0);
+         do { --j; } while (cmp(algoitem(pData, j, size), pPivot) > 0);
+         if (i >= j) break;
+         algoSwap(algoitem(pData, i, size), algoitem(pData, j, size),
+            pTmp, size
+         );
+      }
+
+      // Items [0, j] and [j + 1, count).
+      uint64_t left = (uint64_t)j + 1;
+      uint64_t right = count - left;
+      if (left < right) {
+         algoIntroSort(pData, left, size, cmp, pTmp, pPivot, depth);
+         pData = algoitem(pData, left, size);
+         count = right;
+      } else {
+         algoIntroSort(algoitem(pData, left, size), right, size,
+            cmp, pTmp, pPivot, depth
+         );
+         count = left;
+      }
+   }
+
+   algoInsertionSort(pData, count, size, cmp, pTmp);
+}
+
+// Merges sorted items pA (na items) and pB (nb items) into pOut. Items from
+// pA go first when equal.
+void algoMerge(void* pA, uint64_t na, void* pB, uint64_t nb, void* pOut,
+   uint32_t size, comparator cmp)
+{
+   uint64_t l = 0, r = 0;
+   while (l < na && r < nb) {
+      if (cmp(algoitem(pB, r, size), algoitem(pA, l, size)) < 0) {
+         memcpy(pOut, algoitem(pB, r++, size), size);
+      } else {
+         memcpy(pOut, algoitem(pA, l++, size), size);
+      }
+      pOut += size;
+   }
+   memcpy(pOut, algoitem(pA, l, size), (size_t)(na - l) * size);
+   pOut += (na - l) * size;
+   memcpy(pOut, algoitem(pB, r, size), (size_t)(nb - r) * size);
+}
+
+// Stable sorts count items at pData using pBuf (room for count items). Runs
+// are insertion sorted and then merged bottom up between pData and pBuf. The
+// result is left in pData.
+void algoMergeSort(void* pData, void* pBuf, uint64_t count, uint32_t size,
+   comparator cmp)
+{
+   // Sort small runs.
+   for (uint64_t lo = 0; lo < count; lo += VECTORALGO_INSERTION_ITEMS) {
+      uint64_t n = count - lo;
+      if (n > VECTORALGO_INSERTION_ITEMS) n = VECTORALGO_INSERTION_ITEMS;
+      algoInsertionSort(algoitem(pData, lo, size), n, size, cmp, pBuf);
+   }
+
+   // Merge runs of doubling width.
+   void* pSrc = pData;
+   void* pDst = pBuf;
+   for (uint64_t width = VECTORALGO_INSERTION_ITEMS; width < count;
+      width *= 2) {
+      for (uint64_t lo = 0; lo < count; lo += width * 2) {
+         uint64_t mid = (lo + width < count ? lo + width : count);
+         uint64_t hi = (lo + (width * 2) < count ? lo + (width * 2) : count);
+         algoMerge(algoitem(pSrc, lo, size), mid - lo,
+            algoitem(pSrc, mid, size), hi - mid,
+            algoitem(pDst, lo, size), size, cmp
+         );
+      }
+
+      void* pSwap = pSrc;
+      pSrc = pDst;
+      pDst = pSwap;
+   }
+
+   // Result must end up in pData.
+   if (pSrc != pData) {
+      memcpy(pData, pSrc, (size_t)count * size);
+   }
+}
+
+//
+// Private API - Searching.
+//
+
+// Scalar find over 4 byte items.
+uint64_t algoFind32(const void* pData, uint64_t count, const void* item)
+{
+   const uint32_t* pItems = (const uint32_t*)pData;
+   uint32_t key = 0;
+   memcpy(&key, item, sizeof(key));
+   for (uint64_t n = 0; n < count; ++n) {
+      if (pItems[n] == key) return n;
+   }
+   return CV_NPOS;
+}
+
+// Scalar find over 8 byte items.
+uint64_t algoFind64(const void* pData, uint64_t count, const void* item)
+{
+   const uint64_t* pItems = (const uint64_t*)pData;
+   uint64_t key = 0;
+   memcpy(&key, item, sizeof(key));
+   for (uint64_t n = 0; n < count; ++n) {
+      if (pItems[n] == key) return n;
+   }
+   return CV_NPOS;
+}
+
+// SSE2 find over 4 byte items.
+uint64_t algoFind32Sse2(const void* pData, uint64_t count, const void* item)
+{
+   const uint32_t* pItems = (const uint32_t*)pData;
+   uint32_t key = 0;
+   memcpy(&key, item, sizeof(key));
+
+   __m128i keys = _mm_set1_epi32((int)key);
+   uint64_t n = 0;
+   for (; n + 4 <= count; n += 4) {
+      __m128i items = _mm_loadu_si128((const __m128i*)(pItems + n));
+      int mask = _mm_movemask_ps(
+         _mm_castsi128_ps(_mm_cmpeq_epi32(items, keys)));
+      if (mask) return n + __builtin_ctz(mask);
+   }
+
+   uint64_t rest = algoFind32(pItems + n, count - n, item);
+   return (rest == CV_NPOS ? CV_NPOS : n + rest);
+}
+
+// SSE2 find over 8 byte items. SSE2 has no 64 bit compare so both 32 bit
+// halves are compared and must match.
+uint64_t algoFind64Sse2(const void* pData, uint64_t count, const void* item)
+{
+   const uint64_t* pItems = (const uint64_t*)pData;
+   uint64_t key = 0;
+   memcpy(&key, item, sizeof(key));
+
+   __m128i keys = _mm_set1_epi64x((long long)key);
+   uint64_t n = 0;
+   for (; n + 2 <= count; n += 2) {
+      __m128i items = _mm_loadu_si128((const __m128i*)(pItems + n));
+      __m128i eq = _mm_cmpeq_epi32(items, keys);
+      eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+      int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+      if (mask) return n + __builtin_ctz(mask);
+   }
+
+   uint64_t rest = algoFind64(pItems + n, count - n, item);
+   return (rest == CV_NPOS ? CV_NPOS : n + rest);
+}
+
+// AVX2 find over 4 byte items.
+__attribute__((target("avx2")))
+uint64_t algoFind32Avx2(const void* pData, uint64_t count, const void* item)
+{
+   const uint32_t* pItems = (const uint32_t*)pData;
+   uint32_t key = 0;
+   memcpy(&key, item, sizeof(key));
+
+   __m256i keys = _mm256_set1_epi32((int)key);
+   uint64_t n = 0;
+   for (; n + 16 <= count; n += 16) {
+      __m256i a = _mm256_loadu_si256((const __m256i*)(pItems + n));
+      __m256i b = _mm256_loadu_si256((const __m256i*)(pItems + n + 8));
+      uint32_t maskA = (uint32_t)_mm256_movemask_ps(
+         _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, keys)));
+      uint32_t maskB = (uint32_t)_mm256_movemask_ps(
+         _mm256_castsi256_ps(_mm256_cmpeq_epi32(b, keys)));
+      uint32_t mask = maskA | (maskB << 8);
+      if (mask) return n + __builtin_ctz(mask);
+   }
+
+   uint64_t rest = algoFind32Sse2(pItems + n, count - n, item);
+   return (rest == CV_NPOS ? CV_NPOS : n + rest);
+}
+
+// AVX2 find over 8 byte items.
+__attribute__((target("avx2")))
+uint64_t algoFind64Avx2(const void* pData, uint64_t count, const void* item)
+{
+   const uint64_t* pItems = (const uint64_t*)pData;
+   uint64_t key = 0;
+   memcpy(&key, item, sizeof(key));
+
+   __m256i keys = _mm256_set1_epi64x((long long)key);
+   uint64_t n = 0;
+   for (; n + 8 <= count; n += 8) {
+      __m256i a = _mm256_loadu_si256((const __m256i*)(pItems + n));
+      __m256i b = _mm256_loadu_si256((const __m256i*)(pItems + n + 4));
+      uint32_t maskA = (uint32_t)_mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpeq_epi64(a, keys)));
+      uint32_t maskB = (uint32_t)_mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpeq_epi64(b, keys)));
+      uint32_t mask = maskA | (maskB << 4);
+      if (mask) return n + __builtin_ctz(mask);
+   }
+
+   uint64_t rest = algoFind64Sse2(pItems + n, count - n, item);
+   return (rest == CV_NPOS ? CV_NPOS : n + rest);
+}
+
+// Returns the find functions for 4 and 8 byte items best suited to this cpu.
+// The choice is made once.
+void algoFinders(finder* pFind32, finder* pFind64)
+{
+   static finder find32 = nul;
+   static finder find64 = nul;
+
+   if (!__atomic_load_n(&find32, __ATOMIC_ACQUIRE)) {
+      __builtin_cpu_init();
+      finder f64 = algoFind64Sse2;
+      finder f32 = algoFind32Sse2;
+      if (__builtin_cpu_supports("avx2")) {
+         f64 = algoFind64Avx2;
+         f32 = algoFind32Avx2;
+      }
+      __atomic_store_n(&find64, f64, __ATOMIC_RELAXED);
+      __atomic_store_n(&find32, f32, __ATOMIC_RELEASE);
+   }
+
+   *pFind32 = __atomic_load_n(&find32, __ATOMIC_ACQUIRE);
+   *pFind64 = __atomic_load_n(&find64, __ATOMIC_RELAXED);
+}
+
+//
+// SORTING
+//
+
+// Sorts all items of the vector with cmp (introsort, not stable).
+retcode cvSort(cvector v, comparator cmp)
+{
+   if (!v || !cmp) return fail;
+
+   uint64_t count = cvCount(v);
+   uint32_t size = cvStride(v);
+   if (count < 2) return success;
+
+   // Two item buffers (swaps and the pivot).
+   uint8_t stackTmp[VECTORALGO_STACK_ITEMSIZE * 2];
+   void* pTmp = stackTmp;
+   if (size > VECTORALGO_STACK_ITEMSIZE) {
+      pTmp = malloc((size_t)size * 2);
+      if (!pTmp) return fail;
+   }
+
+   // Depth limit of 2 * log2(count).
+   uint32_t depth = 0;
+   for (uint64_t n = count; n > 1; n >>= 1) depth += 2;
+
+   algoIntroSort(cvData(v), count, size, cmp, pTmp, pTmp + size, depth);
+
+   if (pTmp != (void*)stackTmp) free(pTmp);
+   return success;
+}
+
+// Sorts all items of the vector with cmp keeping equal items in order.
+retcode cvStableSort(cvector v, comparator cmp)
+{
+   if (!v || !cmp) return fail;
+
+   uint64_t count = cvCount(v);
+   uint32_t size = cvStride(v);
+   if (count < 2) return success;
+
+   void* pBuf = malloc((size_t)count * size);
+   if (!pBuf) return fail;
+
+   algoMergeSort(cvData(v), pBuf, count, size, cmp);
+
+   free(pBuf);
+   return success;
+}
+
+// Sorts 4 or 8 byte integer items with a least significant byte first radix
+// sort. All byte histograms are taken in one pass and passes where every item
+// shares the same byte are skipped. The sign bit is flipped for signed items.
+retcode cvRadixSort(cvector v, bool isSigned)
+{
+   if (!v) return fail;
+
+   uint64_t count = cvCount(v);
+   uint32_t size = cvStride(v);
+   if (size != sizeof(uint32_t) && size != sizeof(uint64_t)) return fail;
+   if (count < 2) return success;
+
+   void* pBuf = malloc((size_t)count * size);
+   if (!pBuf) return fail;
+
+   // Histograms of each byte.
+   uint64_t (*pHist)[256] = calloc(size, sizeof(*pHist));
+   if (!pHist) {
+      free(pBuf);
+      return fail;
+   }
+
+   uint64_t signFlip = 0;
+   if (isSigned) signFlip = (uint64_t)0x80 << ((size - 1) * 8);
+
+   void* pSrc = cvData(v);
+   for (uint64_t n = 0; n < count; ++n) {
+      uint64_t key = (size == sizeof(uint32_t) ?
+         ((uint32_t*)pSrc)[n] : ((uint64_t*)pSrc)[n]) ^ signFlip;
+      for (uint32_t b = 0; b < size; ++b) {
+         pHist[b][(key >> (b * 8)) & 0xFF]++;
+      }
+   }
+
+   // One pass per byte.
+   void* pDst = pBuf;
+   for (uint32_t b = 0; b < size; ++b) {
+      uint64_t* pCounts = pHist[b];
+
+      // Skip bytes all items share.
+      uint64_t key0 = (size == sizeof(uint32_t) ?
+         ((uint32_t*)pSrc)[0] : ((uint64_t*)pSrc)[0]) ^ signFlip;
+      if (pCounts[(key0 >> (b * 8)) & 0xFF] == count) continue;
+
+      // Bucket offsets.
+      uint64_t offset = 0;
+      for (uint32_t d = 0; d < 256; ++d) {
+         uint64_t c = pCounts[d];
+         pCounts[d] = offset;
+         offset += c;
+      }
+
+      // Scatter.
+      if (size == sizeof(uint32_t)) {
+         const uint32_t* pIn = (const uint32_t*)pSrc;
+         uint32_t* pOut = (uint32_t*)pDst;
+         for (uint64_t n = 0; n < count; ++n) {
+            uint32_t digit = ((pIn[n] ^ (uint32_t)signFlip) >> (b * 8)) & 0xFF;
+            pOut[pCounts[digit]++] = pIn[n];
+         }
+      } else {
+         const uint64_t* pIn = (const uint64_t*)pSrc;
+         uint64_t* pOut = (uint64_t*)pDst;
+         for (uint64_t n = 0; n < count; ++n) {
+            uint32_t digit = ((pIn[n] ^ signFlip) >> (b * 8)) & 0xFF;
+            pOut[pCounts[digit]++] = pIn[n];
+         }
+      }
+
+      void* pSwap = pSrc;
+      pSrc = pDst;
+      pDst = pSwap;
+   }
+
+   // Result must end up in the vector.
+   if (pSrc != cvData(v)) {
+      memcpy(cvData(v), pSrc, (size_t)count * size);
+   }
+
+   free(pHist);
+   free(pBuf);
+   return success;
+}
+
+//
+// SEARCHING
+//
+
+// Returns the index of the first item not less than key in a vector sorted by
+// cmp or the item count if all items are less than key.
+uint64_t cvLowerBound(cvector v, const void* key, comparator cmp)
+{
+   if (!v || !key || !cmp) return 0;
+
+   void* pData = cvData(v);
+   uint32_t size = cvStride(v);
+   uint64_t lo = 0;
+   uint64_t count = cvCount(v);
+   while (count > 0) {
+      uint64_t half = count / 2;
+      if (cmp(algoitem(pData, lo + half, size), (void*)key) < 0) {
+         lo += half + 1;
+         count -= half + 1;
+      } else {
+         count = half;
+      }
+   }
+
+   return lo;
+}
+
+// Returns the index of an item equal to key in a vector sorted by cmp or
+// CV_NPOS if there is none.
+uint64_t cvBinarySearch(cvector v, const void* key, comparator cmp)
+{
+   if (!v || !key || !cmp) return CV_NPOS;
+
+   uint64_t index = cvLowerBound(v, key, cmp);
+   if (index >= cvCount(v)) return CV_NPOS;
+   if (cmp(cvAt(v, index), (void*)key) != 0) return CV_NPOS;
+
+   return index;
+}
+
+// Returns the index of the first item equal to item or CV_NPOS.
+uint64_t cvFind(cvector v, const void* item)
+{
+   if (!v || !item) return CV_NPOS;
+
+   uint64_t count = cvCount(v);
+   uint32_t size = cvStride(v);
+   if (count == 0) return CV_NPOS;
+
+   // Vectorized 4 and 8 byte items.
+   finder find32 = nul, find64 = nul;
+   if (size == sizeof(uint32_t) || size == sizeof(uint64_t)) {
+      algoFinders(&find32, &find64);
+      return (size == sizeof(uint32_t) ? find32 : find64)(
+         cvData(v), count, item
+      );
+   }
+
+   // Any other size.
+   void* pData = cvData(v);
+   for (uint64_t n = 0; n < count; ++n) {
+      if (0 == memcmp(algoitem(pData, n, size), item, size)) return n;
+   }
+
+   return CV_NPOS;
+}
@@ -0,0 +1,597 @@
+/*
+Date: 17 Oct 2026 15:20:37.171938204
+File: vectorpar.c
+
+Copyright Notice
+This document is protected by the GNU General Public License v3.0.
+
+This allows for commercial use, modification, distribution, patent and private
+use of this software only when the GNU General Public License v3.0 and this
+copyright notice are both attached in their original form.
+
+For developer and author protection, the GPL clearly explains that there is no
+warranty for this free software and that any source code alterations are to be
+shown clearly to identify the original author as well as any subsequent changes
+made and by who.
+
+For any questions or ideas, please contact:
+github:  https://github(dot)com/dnc77
+email:   dnc77(at)hotmail(dot)com
+web:     http://www(dot)dnc77(dot)com
+
+Copyright (C) 2023 Duncan Camilleri, All rights reserved.
+End of Copyright Notice
+
+Sign:    __VECTORPAR_C_C61A9F3E08B47D25E93F1A6D0B72C584__
+Purpose: Parallel algorithms over vectors. Work is split into chunks of about
+         cvParSetChunkSize() bytes which are handed out to an internal pool of
+         worker threads; the calling thread works on chunks as well. The pool
+         is started on first use and runs one algorithm at a time.
+
+Version control
+17 Oct 2026 Duncan Camilleri           Initial development
+*/
+
+//
+// INCLUDES
+//
+#include <inttypes.h>
+#include <memory.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <commons.h>
+#include <vector.h>
+#include <vectoralgo.h>
+#include <vectorpar.h>
+
+//
+// MACROS
+//
+#define VECTORPAR_DEFAULT_CHUNKSIZE          65536
+#define VECTORPAR_MAX_THREADS                256
+// Sorts of fewer items per thread are not worth splitting.
+#define VECTORPAR_MIN_SORTITEMS              4096
+
+// Item at index in a buffer of items of size bytes.
+#define paritem(_p, _i, _size)               ((_p) + ((size_t)(_i) * (_size)))
+
+//
+// TYPES
+//
+
+// Runs chunk number chunk of the job.
+typedef void (*partask)(void* pJob, uint64_t chunk);
+
+//
+// STRUCTS
+//
+
+// Worker pool. Workers sleep on mWake until mGeneration changes, then take
+// chunks of the job until none are left.
+typedef struct _parpool {
+   pthread_mutex_t mRunLock;                       // one job at a time
+   pthread_mutex_t mLock;                          // guards the fields below
+   pthread_cond_t mWake;                           // a job or stop is posted
+   pthread_cond_t mDone;                           // the last worker finished
+   pthread_t* mpThreads;                           // worker threads
+   uint32_t mThreads;                              // running workers
+   uint32_t mRequested;                            // threads set (0 = cpus)
+   uint32_t mChunkSize;                            // chunk size in bytes
+   bool mStarted;                                  // workers are running
+   bool mStop;                                     // workers must exit
+   uint64_t mGeneration;                           // job number
+   uint32_t mActive;                               // workers still in the job
+   partask mTask;                                  // current job
+   void* mpJob;
+   uint64_t mChunks;                               // chunks in the job
+   uint64_t mNextChunk;                            // next chunk to take
+} parpool;
+
+// Chunked item job (for each, transform and reduce).
+typedef struct _parjob {
+   void* mpSrc;                                    // source items
+   void* mpDst;                                    // destination items
+   uint64_t mCount;                                // source item count
+   uint64_t mChunkItems;                           // items per chunk
+   uint32_t mSrcSize;                              // source item size
+   uint32_t mDstSize;                              // destination item size
+   void* mpFn;                                     // user function
+   cvparfold mFold;                                // reduce: item fold
+   void* mpCtx;                                    // user context
+} parjob;
+
+// Sort job.
+typedef struct _parsort {
+   void* mpSrc;                                    // items for this round
+   void* mpDst;                                    // round output
+   uint64_t mCount;                                // item count
+   uint64_t mParts;                                // sorted parts (power of 2)
+   uint64_t mWidth;                                // parts per merge input
+   uint64_t mSegments;                             // segments per merge
+   uint32_t mSize;                                 // item size
+   comparator mCmp;
+} parsort;
+
+//
+// GLOBALS
+//
+static parpool gPool = {
+   .mRunLock = PTHREAD_MUTEX_INITIALIZER,
+   .mLock = PTHREAD_MUTEX_INITIALIZER,
+   .mWake = PTHREAD_COND_INITIALIZER,
+   .mDone = PTHREAD_COND_INITIALIZER,
+   .mChunkSize = VECTORPAR_DEFAULT_CHUNKSIZE
+};
+
+// Set while a thread runs chunks so that nested calls run serially.
+static __thread bool tInJob = false;
+
+// From vectoralgo.c.
+void algoMerge(void* pA, uint64_t na, void* pB, uint64_t nb, void* pOut,
+   uint32_t size, comparator cmp);
+void algoMergeSort(void* pData, void* pBuf, uint64_t count, uint32_t size,
+   comparator cmp);
+
+//
+// Private API - Worker pool.
+//
+
+// Takes and runs chunks of the current job until none are left.
+void parWork(partask task, void* pJob, uint64_t chunks)
+{
+   tInJob = true;
+   for (;;) {
+      uint64_t chunk =
+         __atomic_fetch_add(&gPool.mNextChunk, 1, __ATOMIC_RELAXED);
+      if (chunk >= chunks) break;
+      task(pJob, chunk);
+   }
+   tInJob = false;
+}
+
+// Worker thread.
+void* parWorker(void* pArg)
+{
+   uint64_t seen = 0;
+
+   pthread_mutex_lock(&gPool.mLock);
+   for (;;) {
+      while (!gPool.mStop && gPool.mGeneration == seen) {
+         pthread_cond_wait(&gPool.mWake, &gPool.mLock);
+      }
+      if (gPool.mStop) break;
+
+      // Take the job.
+      seen = gPool.mGeneration;
+      partask task = gPool.mTask;
+      void* pJob = gPool.mpJob;
+      uint64_t chunks = gPool.mChunks;
+      pthread_mutex_unlock(&gPool.mLock);
+
+      parWork(task, pJob, chunks);
+
+      pthread_mutex_lock(&gPool.mLock);
+      if (--gPool.mActive == 0) pthread_cond_signal(&gPool.mDone);
+   }
+   pthread_mutex_unlock(&gPool.mLock);
+
+   return null;
+}
+
+// Returns the total number of threads to use (including the caller).
+uint32_t parThreadCount()
+{
+   uint32_t threads = gPool.mRequested;
+   if (threads == 0) {
+      long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+      threads = (cpus > 0 ? (uint32_t)cpus : 1);
+   }
+   return (threads > VECTORPAR_MAX_THREADS ? VECTORPAR_MAX_THREADS : threads);
+}
+
+// Starts the workers. Call with mRunLock held. Runs with fewer workers if
+// some fail to start.
+void parStart()
+{
+   if (gPool.mStarted) return;
+
+   uint32_t workers = parThreadCount() - 1;
+   gPool.mThreads = 0;
+   gPool.mStop = false;
+   gPool.mGeneration = 0;
+   gPool.mpThreads = nul;
+   if (workers > 0) {
+      gPool.mpThreads = (pthread_t*)malloc(sizeof(pthread_t) * workers);
+   }
+
+   if (gPool.mpThreads) {
+      while (gPool.mThreads < workers) {
+         if (0 != pthread_create(&gPool.mpThreads[gPool.mThreads], nul,
+            parWorker, nul)) {
+            break;
+         }
+         gPool.mThreads++;
+      }
+   }
+   gPool.mStarted = true;
+}
+
+// Stops and joins the workers. Call with mRunLock held.
+void parStop()
+{
+   if (!gPool.mStarted) return;
+
+   pthread_mutex_lock(&gPool.mLock);
+   gPool.mStop = true;
+   pthread_cond_broadcast(&gPool.mWake);
+   pthread_mutex_unlock(&gPool.mLock);
+
+   for (uint32_t t = 0; t < gPool.mThreads; ++t) {
+      pthread_join(gPool.mpThreads[t], nul);
+   }
+   free(gPool.mpThreads);
+   gPool.mpThreads = nul;
+   gPool.mThreads = 0;
+   gPool.mStarted = false;
+}
+
+// Runs chunks [0, chunks) of a job across the pool and returns when all are
+// done. Single chunk jobs and nested calls run on the calling thread.
+void parRun(partask task, void* pJob, uint64_t chunks)
+{
+   if (chunks == 0) return;
+   if (chunks == 1 || tInJob) {
+      for (uint64_t c = 0; c < chunks; ++c) task(pJob, c);
+      return;
+   }
+
+   pthread_mutex_lock(&gPool.mRunLock);
+   parStart();
+
+   // Post the job.
+   pthread_mutex_lock(&gPool.mLock);
+   gPool.mTask = task;
+   gPool.mpJob = pJob;
+   gPool.mChunks = chunks;
+   gPool.mNextChunk = 0;
+   gPool.mActive = gPool.mThreads;
+   gPool.mGeneration++;
+   pthread_cond_broadcast(&gPool.mWake);
+   pthread_mutex_unlock(&gPool.mLock);
+
+   // Help out, then wait for the workers.
+   parWork(task, pJob, chunks);
+   pthread_mutex_lock(&gPool.mLock);
+   while (gPool.mActive > 0) {
+      pthread_cond_wait(&gPool.mDone, &gPool.mLock);
+   }
+   pthread_mutex_unlock(&gPool.mLock);
+
+   pthread_mutex_unlock(&gPool.mRunLock);
+}
+
+// Returns the items per chunk for items of itemSize bytes.
+uint64_t parChunkItems(uint32_t itemSize)
+{
+   uint32_t chunkSize = __atomic_load_n(&gPool.mChunkSize, __ATOMIC_RELAXED);
+   uint64_t items = chunkSize / itemSize;
+   return (items > 0 ? items : 1);
+}
+
+// Sets up a chunked job over count items of srcSize bytes and returns the
+// number of chunks.
+uint64_t parJobInit(parjob* pJob, void* pSrc, uint64_t count, uint32_t srcSize)
+{
+   memset(pJob, 0, sizeof(parjob));
+   pJob->mpSrc = pSrc;
+   pJob->mCount = count;
+   pJob->mSrcSize = srcSize;
+   pJob->mChunkItems = parChunkItems(srcSize);
+   return (count + pJob->mChunkItems - 1) / pJob->mChunkItems;
+}
+
+//
+// Private API - Tasks.
+//
+
+// For each chunk.
+void parForEachTask(void* pArg, uint64_t chunk)
+{
+   parjob* pJob = (parjob*)pArg;
+   cvparitem fn = (cvparitem)pJob->mpFn;
+
+   uint64_t first = chunk * pJob->mChunkItems;
+   uint64_t last = first + pJob->mChunkItems;
+   if (last > pJob->mCount) last = pJob->mCount;
+
+   void* pItem = paritem(pJob->mpSrc, first, pJob->mSrcSize);
+   for (uint64_t n = first; n < last; ++n) {
+      fn(pItem, n, pJob->mpCtx);
+      pItem += pJob->mSrcSize;
+   }
+}
+
+// Transform chunk.
+void parTransformTask(void* pArg, uint64_t chunk)
+{
+   parjob* pJob = (parjob*)pArg;
+   cvparmap fn = (cvparmap)pJob->mpFn;
+
+   uint64_t first = chunk * pJob->mChunkItems;
+   uint64_t last = first + pJob->mChunkItems;
+   if (last > pJob->mCount) last = pJob->mCount;
+
+   const void* pSrc = paritem(pJob->mpSrc, first, pJob->mSrcSize);
+   void* pDst = paritem(pJob->mpDst, first, pJob->mDstSize);
+   for (uint64_t n = first; n < last; ++n) {
+      fn(pDst, pSrc, pJob->mpCtx);
+      pSrc += pJob->mSrcSize;
+      pDst += pJob->mDstSize;
+   }
+}
+
+// Reduce chunk. mpDst holds one result per chunk, preset to the identity.
+void parReduceTask(void* pArg, uint64_t chunk)
+{
+   parjob* pJob = (parjob*)pArg;
+
+   uint64_t first = chunk * pJob->mChunkItems;
+   uint64_t last = first + pJob->mChunkItems;
+   if (last > pJob->mCount) last = pJob->mCount;
+
+   void* pAcc = paritem(pJob->mpDst, chunk, pJob->mDstSize);
+   const void* pItem = paritem(pJob->mpSrc, first, pJob->mSrcSize);
+   for (uint64_t n = first; n < last; ++n) {
+      pJob->mFold(pAcc, pItem, pJob->mpCtx);
+      pItem += pJob->mSrcSize;
+   }
+}
+
+// First item of sorted part number part.
+uint64_t parPartStart(const parsort* pSort, uint64_t part)
+{
+   return (uint64_t)(((unsigned __int128)pSort->mCount * part) / pSort->mParts);
+}
+
+// Sorts one part in place (mpDst is the scratch buffer).
+void parSortPartTask(void* pArg, uint64_t part)
+{
+   parsort* pSort = (parsort*)pArg;
+   uint64_t lo = parPartStart(pSort, part);
+   uint64_t hi = parPartStart(pSort, part + 1);
+
+   algoMergeSort(paritem(pSort->mpSrc, lo, pSort->mSize),
+      paritem(pSort->mpDst, lo, pSort->mSize), hi - lo, pSort->mSize,
+      pSort->mCmp
+   );
+}
+
+// Returns how many of the first d merged items of pA and pB come from pA
+// (merge path). Items from pA go first when equal, as in algoMerge().
+uint64_t parCoRank(uint64_t d, void* pA, uint64_t na, void* pB, uint64_t nb,
+   uint32_t size, comparator cmp)
+{
+   uint64_t lo = (d > nb ? d - nb : 0);
+   uint64_t hi = (d < na ? d : na);
+   while (lo < hi) {
+      uint64_t mid = lo + ((hi - lo) / 2);
+      if (cmp(paritem(pA, mid, size), paritem(pB, d - mid - 1, size)) <= 0) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return lo;
+}
+
+// Merges one segment of the output of one pair of sorted runs.
+void parMergeTask(void* pArg, uint64_t task)
+{
+   parsort* pSort = (parsort*)pArg;
+   uint32_t size = pSort->mSize;
+   uint64_t pair = task / pSort->mSegments;
+   uint64_t segment = task % pSort->mSegments;
+
+   // The pair of runs.
+   uint64_t lo = parPartStart(pSort, pair * pSort->mWidth * 2);
+   uint64_t mid = parPartStart(pSort, (pair * 2 + 1) * pSort->mWidth);
+   uint64_t hi = parPartStart(pSort, (pair + 1) * pSort->mWidth * 2);
+   void* pA = paritem(pSort->mpSrc, lo, size);
+   void* pB = paritem(pSort->mpSrc, mid, size);
+   uint64_t na = mid - lo;
+   uint64_t nb = hi - mid;
+
+   // This segment of the merged output.
+   uint64_t total = na + nb;
+   uint64_t d0 = (uint64_t)(((unsigned __int128)total * segment) /
+      pSort->mSegments);
+   uint64_t d1 = (uint64_t)(((unsigned __int128)total * (segment + 1)) /
+      pSort->mSegments);
+   uint64_t i0 = parCoRank(d0, pA, na, pB, nb, size, pSort->mCmp);
+   uint64_t i1 = parCoRank(d1, pA, na, pB, nb, size, pSort->mCmp);
+
+   algoMerge(paritem(pA, i0, size), i1 - i0,
+      paritem(pB, d0 - i0, size), (d1 - i1) - (d0 - i0),
+      paritem(pSort->mpDst, lo + d0, size), size, pSort->mCmp
+   );
+}
+
+// Copies one part of mpSrc to mpDst.
+void parCopyTask(void* pArg, uint64_t part)
+{
+   parsort* pSort = (parsort*)pArg;
+   uint64_t lo = parPartStart(pSort, part);
+   uint64_t hi = parPartStart(pSort, part + 1);
+
+   memcpy(paritem(pSort->mpDst, lo, pSort->mSize),
+      paritem(pSort->mpSrc, lo, pSort->mSize), (size_t)(hi - lo) * pSort->mSize
+   );
+}
+
+//
+// POOL CONFIGURATION
+//
+
+// Sets the number of threads used (0 for one per cpu).
+retcode cvParSetThreads(uint32_t threads)
+{
+   if (threads > VECTORPAR_MAX_THREADS) return fail;
+
+   pthread_mutex_lock(&gPool.mRunLock);
+   parStop();
+   gPool.mRequested = threads;
+   pthread_mutex_unlock(&gPool.mRunLock);
+   return success;
+}
+
+// Returns the number of threads used (including the caller).
+uint32_t cvParGetThreads()
+{
+   pthread_mutex_lock(&gPool.mRunLock);
+   uint32_t threads = parThreadCount();
+   pthread_mutex_unlock(&gPool.mRunLock);
+   return threads;
+}
+
+// Sets the chunk size in bytes (0 for the default).
+void cvParSetChunkSize(uint32_t bytes)
+{
+   if (bytes == 0) bytes = VECTORPAR_DEFAULT_CHUNKSIZE;
+   __atomic_store_n(&gPool.mChunkSize, bytes, __ATOMIC_RELAXED);
+}
+
+// Stops the worker threads.
+void cvParShutdown()
+{
+   pthread_mutex_lock(&gPool.mRunLock);
+   parStop();
+   pthread_mutex_unlock(&gPool.mRunLock);
+}
+
+//
+// PARALLEL ALGORITHMS
+//
+
+// Calls fn on every item.
+retcode cvParallelForEach(cvector v, cvparitem fn, void* pCtx)
+{
+   if (!v || !fn) return fail;
+
+   parjob job;
+   uint64_t chunks = parJobInit(&job, cvData(v), cvCount(v), cvStride(v));
+   job.mpFn = (void*)fn;
+   job.mpCtx = pCtx;
+
+   parRun(parForEachTask, &job, chunks);
+   return success;
+}
+
+// Sets dst to the items of src transformed by fn.
+retcode cvParallelTransform(ccvector src, cvector dst, cvparmap fn, void* pCtx)
+{
+   if (!src || !dst || !fn) return fail;
+
+   // Size dst to match.
+   uint64_t count = cvCount(src);
+   if (src != dst) {
+      if (cvCount(dst) > count) cvClear(dst);
+      if (cvCount(dst) < count) {
+         if (!cvEmplaceBackN(dst, count - cvCount(dst))) return fail;
+      }
+   }
+
+   parjob job;
+   uint64_t chunks = parJobInit(&job, cvData(src), count, cvStride(src));
+   job.mpDst = cvData(dst);
+   job.mDstSize = cvStride(dst);
+   job.mpFn = (void*)fn;
+   job.mpCtx = pCtx;
+
+   parRun(parTransformTask, &job, chunks);
+   return success;
+}
+
+// Folds all items into pResult.
+retcode cvParallelReduce(ccvector v, void* pResult, uint32_t resultSize,
+   cvparfold fold, cvparfold combine, void* pCtx)
+{
+   if (!v || !pResult || resultSize == 0 || !fold || !combine) return fail;
+
+   parjob job;
+   uint64_t chunks = parJobInit(&job, cvData(v), cvCount(v), cvStride(v));
+   if (chunks == 0) return success;
+
+   // One result per chunk, each starting from the identity.
+   void* pPartials = malloc((size_t)chunks * resultSize);
+   if (!pPartials) return fail;
+   for (uint64_t c = 0; c < chunks; ++c) {
+      memcpy(paritem(pPartials, c, resultSize), pResult, resultSize);
+   }
+
+   job.mpDst = pPartials;
+   job.mDstSize = resultSize;
+   job.mFold = fold;
+   job.mpCtx = pCtx;
+   parRun(parReduceTask, &job, chunks);
+
+   // Combine in item order.
+   for (uint64_t c = 0; c < chunks; ++c) {
+      combine(pResult, paritem(pPartials, c, resultSize), pCtx);
+   }
+
+   free(pPartials);
+   return success;
+}
+
+// Stable parallel merge sort.
+retcode cvParallelSort(cvector v, comparator cmp)
+{
+   if (!v || !cmp) return fail;
+
+   // One part per thread, as a power of two, unless parts get too small.
+   uint64_t count = cvCount(v);
+   uint64_t threads = tInJob ? 1 : cvParGetThreads();
+   uint64_t parts = 1;
+   while (parts < threads && count / (parts * 2) >= VECTORPAR_MIN_SORTITEMS) {
+      parts *= 2;
+   }
+   if (parts == 1) return cvStableSort(v, cmp);
+
+   void* pBuf = malloc((size_t)count * cvStride(v));
+   if (!pBuf) return fail;
+
+   parsort sort = {
+      .mpSrc = cvData(v),
+      .mpDst = pBuf,
+      .mCount = count,
+      .mParts = parts,
+      .mSize = cvStride(v),
+      .mCmp = cmp
+   };
+
+   // Sort each part in place.
+   parRun(parSortPartTask, &sort, parts);
+
+   // Merge pairs of runs each round, splitting each merge so that there are
+   // always as many merge tasks as parts.
+   for (sort.mWidth = 1; sort.mWidth < parts; sort.mWidth *= 2) {
+      uint64_t pairs = parts / (sort.mWidth * 2);
+      sort.mSegments = parts / pairs;
+      parRun(parMergeTask, &sort, parts);
+
+      void* pSwap = sort.mpSrc;
+      sort.mpSrc = sort.mpDst;
+      sort.mpDst = pSwap;
+   }
+
+   // Result must end up in the vector.
+   if (sort.mpSrc != cvData(v)) {
+      sort.mpDst = cvData(v);
+      parRun(parCopyTask, &sort, parts);
+   }
+
+   free(pBuf);
+   return success;
+}